@@ -89,6 +89,7 @@ COMMON_SRC = \
             flight/failsafe.c \
             flight/gps_rescue.c \
             flight/gyroanalyse.c \
+            flight/spectrum.c \
             flight/imu.c \
             flight/setpoint.c \
             flight/mixer.c \
@@ -170,6 +171,7 @@ COMMON_SRC = \
             sensors/barometer.c \
             sensors/rangefinder.c \
             telemetry/telemetry.c \
+            telemetry/sensors.c \
             telemetry/crsf.c \
             telemetry/srxl.c \
             telemetry/frsky_hub.c \
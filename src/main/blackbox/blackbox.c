@@ -1513,6 +1513,15 @@ static bool blackboxWriteSysinfo(void)
                                                                             rpmFilterConfig()->filter_bank_max_hz[13],
                                                                             rpmFilterConfig()->filter_bank_max_hz[14],
                                                                             rpmFilterConfig()->filter_bank_max_hz[15]);
+        BLACKBOX_PRINT_HEADER_LINE("gyro_rpm_filter_mode", "%d",           rpmFilterConfig()->filter_mode);
+        BLACKBOX_PRINT_HEADER_LINE("gyro_rpm_filter_auto", "%d,%d,%d,%d,%d", rpmFilterConfig()->filter_auto_notches,
+                                                                            rpmFilterConfig()->filter_auto_notch_q,
+                                                                            rpmFilterConfig()->filter_auto_min_hz,
+                                                                            rpmFilterConfig()->filter_auto_max_hz,
+                                                                            rpmFilterConfig()->filter_auto_pinion_teeth);
+        BLACKBOX_PRINT_HEADER_LINE("gyro_rpm_filter_adaptive", "%d,%d,%d", rpmFilterConfig()->filter_adaptive,
+                                                                            rpmFilterConfig()->filter_adaptive_min_amp,
+                                                                            rpmFilterConfig()->filter_adaptive_full_amp);
 #endif
 #if defined(USE_ACC)
         BLACKBOX_PRINT_HEADER_LINE("acc_lpf_hz", "%d",                 (int)(accelerometerConfig()->acc_lpf_hz * 100.0f));
@@ -1605,6 +1614,17 @@ void blackboxLogEvent(FlightLogEvent event, flightLogEventData_t *data)
     case FLIGHT_LOG_EVENT_GOVSTATE:
         blackboxWriteUnsignedVB(data->govState.govState);
         break;
+    case FLIGHT_LOG_EVENT_GOVTUNE:
+        blackboxWriteUnsignedVB(data->govTune.success);
+        blackboxWriteUnsignedVB(data->govTune.tau);
+        blackboxWriteUnsignedVB(data->govTune.gain);
+        blackboxWriteUnsignedVB(data->govTune.pGain);
+        blackboxWriteUnsignedVB(data->govTune.iGain);
+        break;
+    case FLIGHT_LOG_EVENT_GYRO_FAULT:
+        blackboxWriteUnsignedVB(data->gyroFault.sensor);
+        blackboxWriteUnsignedVB(data->gyroFault.fault);
+        break;
     default:
         break;
     }
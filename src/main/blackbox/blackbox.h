@@ -48,6 +48,8 @@ typedef enum FlightLogEvent {
     FLIGHT_LOG_EVENT_DISARM = 15,
     FLIGHT_LOG_EVENT_FLIGHTMODE = 30, // Add new event type for flight mode status.
     FLIGHT_LOG_EVENT_GOVSTATE = 50,   // Add new event type for main motor governor state.
+    FLIGHT_LOG_EVENT_GOVTUNE = 51,    // Governor autotune result
+    FLIGHT_LOG_EVENT_GYRO_FAULT = 52, // Dual gyro failover
     FLIGHT_LOG_EVENT_LOG_END = 255
 } FlightLogEvent;
 
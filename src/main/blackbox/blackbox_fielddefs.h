@@ -126,6 +126,19 @@ typedef struct flightLogEvent_govState_s { // New Event Data type for RTFL gover
     uint8_t govState;
 } flightLogEvent_govState_t;
 
+typedef struct flightLogEvent_govTune_s {
+    uint8_t  success;
+    uint16_t tau;           // Identified time constant [ms]
+    uint16_t gain;          // Identified normalized gain *1000
+    uint16_t pGain;         // Resulting gov_p_gain
+    uint16_t iGain;         // Resulting gov_i_gain
+} flightLogEvent_govTune_t;
+
+typedef struct flightLogEvent_gyroFault_s {
+    uint8_t sensor;         // Dropped gyro 1 or 2
+    uint8_t fault;          // gyroFault_e
+} flightLogEvent_gyroFault_t;
+
 typedef struct flightLogEvent_inflightAdjustment_s {
     int32_t newValue;
     float newFloatValue;
@@ -147,6 +160,8 @@ typedef union flightLogEventData_u {
     flightLogEvent_inflightAdjustment_t inflightAdjustment;
     flightLogEvent_loggingResume_t loggingResume;
     flightLogEvent_govState_t govState;
+    flightLogEvent_govTune_t govTune;
+    flightLogEvent_gyroFault_t gyroFault;
 } flightLogEventData_t;
 
 typedef struct flightLogEvent_s {
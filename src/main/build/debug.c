@@ -100,4 +100,10 @@ const char * const debugModeNames[DEBUG_COUNT] = {
     DEBUG_NAME(BLACKBOX_OUTPUT),
     DEBUG_NAME(GYRO_SAMPLE),
     DEBUG_NAME(RX_TIMING),
+    DEBUG_NAME(RPM_FUSION),
+    DEBUG_NAME(HEADSPEED),
+    DEBUG_NAME(GYRO_VOTE),
+    DEBUG_NAME(IMU_EKF),
+    DEBUG_NAME(RPM_ADAPTIVE),
+    DEBUG_NAME(CRSF_TELEMETRY),
 };
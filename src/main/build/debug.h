@@ -126,6 +126,12 @@ typedef enum {
     DEBUG_BLACKBOX_OUTPUT,
     DEBUG_GYRO_SAMPLE,
     DEBUG_RX_TIMING,
+    DEBUG_RPM_FUSION,
+    DEBUG_HEADSPEED,
+    DEBUG_GYRO_VOTE,
+    DEBUG_IMU_EKF,
+    DEBUG_RPM_ADAPTIVE,
+    DEBUG_CRSF_TELEMETRY,
     DEBUG_COUNT
 } debugType_e;
 
@@ -485,6 +485,42 @@ static void cliWrite(uint8_t ch)
     }
 }
 
+/*
+ * Unformatted output for the dump/diff hot path. These append to the
+ * writer in bulk and leave flushing to the caller.
+ */
+static void cliWriteString(const char *str)
+{
+    if (cliWriter) {
+        bufWriterAppendData(cliWriter, str, strlen(str));
+    }
+}
+
+static void cliWriteUnsigned(uint32_t value)
+{
+    char buf[10];
+    int pos = sizeof(buf);
+
+    do {
+        buf[--pos] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+
+    if (cliWriter) {
+        bufWriterAppendData(cliWriter, &buf[pos], sizeof(buf) - pos);
+    }
+}
+
+static void cliWriteInt(int32_t value)
+{
+    if (value < 0) {
+        cliWrite('-');
+        cliWriteUnsigned(-(uint32_t)value);
+    } else {
+        cliWriteUnsigned(value);
+    }
+}
+
 static bool cliDefaultPrintLinef(dumpFlags_t dumpMask, bool equalsDefault, const char *format, ...)
 {
     if ((dumpMask & SHOW_DEFAULTS) && !equalsDefault) {
@@ -561,23 +597,6 @@ static void cliPrintErrorLinef(const char *cmdName, const char *format, ...)
     cliPrintInternal(cliErrorWriter, "\r\n");
 }
 
-static void getMinMax(const clivalue_t *var, int *min, int *max)
-{
-    switch (var->type & VALUE_TYPE_MASK) {
-    case VAR_UINT8:
-    case VAR_UINT16:
-        *min = var->config.minmaxUnsigned.min;
-        *max = var->config.minmaxUnsigned.max;
-
-        break;
-    default:
-        *min = var->config.minmax.min;
-        *max = var->config.minmax.max;
-
-        break;
-    }
-}
-
 static void printValuePointer(const char *cmdName, const clivalue_t *var, const void *valuePointer, bool full)
 {
     if ((var->type & VALUE_MODE_MASK) == MODE_ARRAY) {
@@ -586,32 +605,32 @@ static void printValuePointer(const char *cmdName, const clivalue_t *var, const
             default:
             case VAR_UINT8:
                 // uint8_t array
-                cliPrintf("%d", ((uint8_t *)valuePointer)[i]);
+                cliWriteUnsigned(((uint8_t *)valuePointer)[i]);
                 break;
 
             case VAR_INT8:
                 // int8_t array
-                cliPrintf("%d", ((int8_t *)valuePointer)[i]);
+                cliWriteInt(((int8_t *)valuePointer)[i]);
                 break;
 
             case VAR_UINT16:
                 // uin16_t array
-                cliPrintf("%d", ((uint16_t *)valuePointer)[i]);
+                cliWriteUnsigned(((uint16_t *)valuePointer)[i]);
                 break;
 
             case VAR_INT16:
                 // int16_t array
-                cliPrintf("%d", ((int16_t *)valuePointer)[i]);
+                cliWriteInt(((int16_t *)valuePointer)[i]);
                 break;
 
             case VAR_UINT32:
                 // uin32_t array
-                cliPrintf("%u", ((uint32_t *)valuePointer)[i]);
+                cliWriteUnsigned(((uint32_t *)valuePointer)[i]);
                 break;
             }
 
             if (i < var->config.array.length - 1) {
-                cliPrint(",");
+                cliWrite(',');
             }
         }
     } else {
@@ -644,7 +663,7 @@ static void printValuePointer(const char *cmdName, const clivalue_t *var, const
         switch (var->type & VALUE_MODE_MASK) {
         case MODE_DIRECT:
             if ((var->type & VALUE_TYPE_MASK) == VAR_UINT32) {
-                cliPrintf("%u", (uint32_t)value);
+                cliWriteUnsigned(value);
                 if ((uint32_t)value > var->config.u32Max) {
                     valueIsCorrupted = true;
                 } else if (full) {
@@ -653,9 +672,9 @@ static void printValuePointer(const char *cmdName, const clivalue_t *var, const
             } else {
                 int min;
                 int max;
-                getMinMax(var, &min, &max);
+                getSettingMinMax(var, &min, &max);
 
-                cliPrintf("%d", value);
+                cliWriteInt(value);
                 if ((value < min) || (value > max)) {
                     valueIsCorrupted = true;
                 } else if (full) {
@@ -665,20 +684,20 @@ static void printValuePointer(const char *cmdName, const clivalue_t *var, const
             break;
         case MODE_LOOKUP:
             if (value < lookupTables[var->config.lookup.tableIndex].valueCount) {
-                cliPrint(lookupTables[var->config.lookup.tableIndex].values[value]);
+                cliWriteString(lookupTables[var->config.lookup.tableIndex].values[value]);
             } else {
                 valueIsCorrupted = true;
             }
             break;
         case MODE_BITSET:
             if (value & 1 << var->config.bitpos) {
-                cliPrintf("ON");
+                cliWriteString("ON");
             } else {
-                cliPrintf("OFF");
+                cliWriteString("OFF");
             }
             break;
         case MODE_STRING:
-            cliPrintf("%s", (strlen((char *)valuePointer) == 0) ? "-" : (char *)valuePointer);
+            cliWriteString((strlen((char *)valuePointer) == 0) ? "-" : (char *)valuePointer);
             break;
         }
 
@@ -847,46 +866,56 @@ STATIC_UNIT_TESTED void *cliGetValuePointer(const clivalue_t *value)
     }
 }
 
-static const char *dumpPgValue(const char *cmdName, const clivalue_t *value, dumpFlags_t dumpMask, const char *headingStr)
+static const char *dumpPgValue(const char *cmdName, const clivalue_t *value, const pgRegistry_t *pg, bool pgEqualsDefault, dumpFlags_t dumpMask, const char *headingStr)
 {
-    const pgRegistry_t *pg = pgFind(value->pgn);
-#ifdef DEBUG
-    if (!pg) {
-        cliPrintLinef("VALUE %s ERROR", value->name);
-        return headingStr; // if it's not found, the pgn shouldn't be in the value table!
-    }
-#endif
-
-    const char *format = "set %s = ";
-    const char *defaultFormat = "#set %s = ";
     const int valueOffset = getValueOffset(value);
-    const bool equalsDefault = valuePtrEqualsDefault(value, pg->copy + valueOffset, pg->address + valueOffset);
+    const bool equalsDefault = pgEqualsDefault || valuePtrEqualsDefault(value, pg->copy + valueOffset, pg->address + valueOffset);
 
     headingStr = cliPrintSectionHeading(dumpMask, !equalsDefault, headingStr);
     if (((dumpMask & DO_DIFF) == 0) || !equalsDefault) {
         if (dumpMask & SHOW_DEFAULTS && !equalsDefault) {
-            cliPrintf(defaultFormat, value->name);
+            cliWriteString("#set ");
+            cliWriteString(value->name);
+            cliWriteString(" = ");
             printValuePointer(cmdName, value, (uint8_t*)pg->address + valueOffset, false);
-            cliPrintLinefeed();
+            cliWriteString("\r\n");
         }
-        cliPrintf(format, value->name);
+        cliWriteString("set ");
+        cliWriteString(value->name);
+        cliWriteString(" = ");
         printValuePointer(cmdName, value, pg->copy + valueOffset, false);
-        cliPrintLinefeed();
+        cliWriteString("\r\n");
     }
     return headingStr;
 }
 
 static void dumpAllValues(const char *cmdName, uint16_t valueSection, dumpFlags_t dumpMask, const char *headingStr)
 {
+    const pgRegistry_t *pg = NULL;
+    bool pgEqualsDefault = false;
+
     headingStr = cliPrintSectionHeading(dumpMask, false, headingStr);
 
     for (uint32_t i = 0; i < valueTableEntryCount; i++) {
         const clivalue_t *value = &valueTable[i];
-        cliWriterFlush();
         if ((value->type & VALUE_SECTION_MASK) == valueSection || ((valueSection == MASTER_VALUE) && (value->type & VALUE_SECTION_MASK) == HARDWARE_VALUE)) {
-            headingStr = dumpPgValue(cmdName, value, dumpMask, headingStr);
+            // Values of a PG are mostly adjacent in the table. Look the PG
+            // up once and compare all of it to the defaults in one go.
+            if (!pg || pgN(pg) != value->pgn) {
+                pg = pgFind(value->pgn);
+#ifdef DEBUG
+                if (!pg) {
+                    cliPrintLinef("VALUE %s ERROR", value->name);
+                    continue; // if it's not found, the pgn shouldn't be in the value table!
+                }
+#endif
+                pgEqualsDefault = (memcmp(pg->copy, pg->address, pgSize(pg)) == 0);
+            }
+            headingStr = dumpPgValue(cmdName, value, pg, pgEqualsDefault, dumpMask, headingStr);
         }
     }
+
+    cliWriterFlush();
 }
 
 static void cliPrintVar(const char *cmdName, const clivalue_t *var, bool full)
@@ -894,6 +923,7 @@ static void cliPrintVar(const char *cmdName, const clivalue_t *var, bool full)
     const void *ptr = cliGetValuePointer(var);
 
     printValuePointer(cmdName, var, ptr, full);
+    cliWriterFlush();
 }
 
 static void cliPrintVarRange(const clivalue_t *var)
@@ -4798,15 +4828,7 @@ static uint8_t getWordLength(char *bufBegin, char *bufEnd)
 
 uint16_t cliGetSettingIndex(char *name, uint8_t length)
 {
-    for (uint32_t i = 0; i < valueTableEntryCount; i++) {
-        const char *settingName = valueTable[i].name;
-
-        // ensure exact match when setting to prevent setting variables with shorter names
-        if (strncasecmp(name, settingName, strlen(settingName)) == 0 && length == strlen(settingName)) {
-            return i;
-        }
-    }
-    return valueTableEntryCount;
+    return findSettingIndex(name, length);
 }
 
 STATIC_UNIT_TESTED void cliSet(const char *cmdName, char *cmdline)
@@ -4855,7 +4877,7 @@ STATIC_UNIT_TESTED void cliSet(const char *cmdName, char *cmdline)
 
                     int min;
                     int max;
-                    getMinMax(val, &min, &max);
+                    getSettingMinMax(val, &min, &max);
 
                     if (value >= min && value <= max) {
                         cliSetVar(val, value);
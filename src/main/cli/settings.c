@@ -20,6 +20,8 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
+#include <ctype.h>
 
 #include "platform.h"
 
@@ -60,6 +62,7 @@
 #include "flight/servos.h"
 #include "flight/motors.h"
 #include "flight/rpm_filter.h"
+#include "flight/spectrum.h"
 
 #include "io/beeper.h"
 #include "io/gps.h"
@@ -288,11 +291,21 @@ static const char * const lookupTableRcInterpolationChannels[] = {
 static const char * const lookupTableLowpassType[] = {
     "PT1",
     "BIQUAD",
+    "PT2",
+    "PT3",
+    "BUTTER4",
+    "BESSEL2",
+    "BESSEL4",
 };
 
 static const char * const lookupTableDtermLowpassType[] = {
     "PT1",
     "BIQUAD",
+    "PT2",
+    "PT3",
+    "BUTTER4",
+    "BESSEL2",
+    "BESSEL4",
 };
 
 static const char * const lookupTableFailsafe[] = {
@@ -488,6 +501,14 @@ static const char * const lookupTableRateNormalization[] = {
     "ABSOLUTE", "LINEAR", "NATURAL"
 };
 
+static const char * const lookupTableImuMode[] = {
+    "MAHONY", "EKF"
+};
+
+static const char * const lookupTableRpmFilterMode[] = {
+    "MANUAL", "AUTO"
+};
+
 #define LOOKUP_TABLE_ENTRY(name) { name, ARRAYLEN(name) }
 
 const lookupTableEntry_t lookupTables[] = {
@@ -602,6 +623,8 @@ const lookupTableEntry_t lookupTables[] = {
     LOOKUP_TABLE_ENTRY(lookupTableTailMode),
     LOOKUP_TABLE_ENTRY(lookupTableGovernorMode),
     LOOKUP_TABLE_ENTRY(lookupTableRateNormalization),
+    LOOKUP_TABLE_ENTRY(lookupTableImuMode),
+    LOOKUP_TABLE_ENTRY(lookupTableRpmFilterMode),
 };
 
 #undef LOOKUP_TABLE_ENTRY
@@ -609,6 +632,9 @@ const lookupTableEntry_t lookupTables[] = {
 const clivalue_t valueTable[] = {
 // PG_GYRO_CONFIG
     { "gyro_hardware_lpf",          VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_GYRO_HARDWARE_LPF }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_hardware_lpf) },
+#ifdef USE_GYRO_FIFO
+    { "gyro_fifo_mode",             VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_fifo_mode) },
+#endif
 #if defined(USE_GYRO_SPI_ICM20649)
     { "gyro_high_range",            VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_high_fsr) },
 #endif
@@ -633,6 +659,7 @@ const clivalue_t valueTable[] = {
 #endif
 #ifdef USE_MULTI_GYRO
     { "gyro_to_use",                VAR_UINT8  | HARDWARE_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_GYRO }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_to_use) },
+    { "gyro_vote_threshold",        VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 0, 2000 }, PG_GYRO_CONFIG, offsetof(gyroConfig_t, gyro_vote_threshold) },
 #endif
 
 #if defined(USE_GYRO_DATA_ANALYSE)
@@ -793,6 +820,7 @@ const clivalue_t valueTable[] = {
     { "motor_pwm_inversion",        VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_MOTOR_CONFIG, offsetof(motorConfig_t, dev.motorPwmInversion) },
     { "motor_poles",                VAR_UINT8  | MASTER_VALUE | MODE_ARRAY, .config.array.length = MAX_SUPPORTED_MOTORS, PG_MOTOR_CONFIG, offsetof(motorConfig_t, motorPoleCount) },
     { "motor_rpm_lpf",              VAR_UINT16  | MASTER_VALUE | MODE_ARRAY, .config.array.length = MAX_SUPPORTED_MOTORS, PG_MOTOR_CONFIG, offsetof(motorConfig_t, motorRpmLpf) },
+    { "motor_rpm_fusion",           VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_MOTOR_CONFIG, offsetof(motorConfig_t, motorRpmFusion) },
 
 // PG_FAILSAFE_CONFIG
     { "failsafe_delay",             VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 0, 200 }, PG_FAILSAFE_CONFIG, offsetof(failsafeConfig_t, failsafe_delay) },
@@ -878,6 +906,16 @@ const clivalue_t valueTable[] = {
     { "gov_lost_headspeed_timeout", VAR_UINT16 |  MASTER_VALUE,  .config.minmaxUnsigned = { 0, 100 }, PG_GOVERNOR_CONFIG, offsetof(governorConfig_t, gov_lost_headspeed_timeout) },
     { "gov_vbat_offset",            VAR_UINT16 |  MASTER_VALUE,  .config.minmaxUnsigned = { 0, 1000 }, PG_GOVERNOR_CONFIG, offsetof(governorConfig_t, gov_vbat_offset) },
     { "gov_ff_exponent",            VAR_UINT16 |  MASTER_VALUE,  .config.minmaxUnsigned = { 0, 1000 }, PG_GOVERNOR_CONFIG, offsetof(governorConfig_t, gov_ff_exponent) },
+    { "gov_autotune_step",          VAR_UINT8  |  MASTER_VALUE,  .config.minmaxUnsigned = { 1, 20 }, PG_GOVERNOR_CONFIG, offsetof(governorConfig_t, gov_autotune_step) },
+    { "gov_autotune_period",        VAR_UINT8  |  MASTER_VALUE,  .config.minmaxUnsigned = { 2, 50 }, PG_GOVERNOR_CONFIG, offsetof(governorConfig_t, gov_autotune_period) },
+    { "gov_autotune_bandwidth",     VAR_UINT8  |  MASTER_VALUE,  .config.minmaxUnsigned = { 50, 250 }, PG_GOVERNOR_CONFIG, offsetof(governorConfig_t, gov_autotune_bandwidth) },
+    { "gov_tail_ratio",             VAR_UINT16 |  MASTER_VALUE,  .config.minmaxUnsigned = { 0, 30000 }, PG_GOVERNOR_CONFIG, offsetof(governorConfig_t, gov_tail_ratio) },
+
+// PG_SPECTRUM_CONFIG
+#ifdef USE_SPECTRUM_ANALYSER
+    { "spectrum_max_hz",            VAR_UINT16 |  MASTER_VALUE,  .config.minmaxUnsigned = { 0, 2000 }, PG_SPECTRUM_CONFIG, offsetof(spectrumConfig_t, spectrum_max_hz) },
+    { "spectrum_bucket_rpm",        VAR_UINT16 |  MASTER_VALUE,  .config.minmaxUnsigned = { 10, 5000 }, PG_SPECTRUM_CONFIG, offsetof(spectrumConfig_t, spectrum_bucket_rpm) },
+#endif
 
 // PG_SERVO_CONFIG
 #ifdef USE_SERVOS
@@ -911,6 +949,11 @@ const clivalue_t valueTable[] = {
 // PG_IMU_CONFIG
     { "imu_dcm_kp",                 VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 0, 32000 }, PG_IMU_CONFIG, offsetof(imuConfig_t, dcm_kp) },
     { "imu_dcm_ki",                 VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 0, 32000 }, PG_IMU_CONFIG, offsetof(imuConfig_t, dcm_ki) },
+    { "imu_mode",                   VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_IMU_MODE }, PG_IMU_CONFIG, offsetof(imuConfig_t, imu_mode) },
+    { "imu_ekf_acc_noise",          VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 1, 1000 }, PG_IMU_CONFIG, offsetof(imuConfig_t, ekf_acc_noise) },
+#ifdef USE_GPS
+    { "imu_ekf_gps_comp",           VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_IMU_CONFIG, offsetof(imuConfig_t, ekf_gps_comp) },
+#endif
 
 // PG_ARMING_CONFIG
     { "auto_disarm_delay",          VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 0, 60 }, PG_ARMING_CONFIG, offsetof(armingConfig_t, auto_disarm_delay) },
@@ -967,6 +1010,10 @@ const clivalue_t valueTable[] = {
 
 // PG_PID_CONFIG
     { "pid_process_denom",          VAR_UINT8  | MASTER_VALUE,  .config.minmaxUnsigned = { 1, MAX_PID_PROCESS_DENOM }, PG_PID_CONFIG, offsetof(pidConfig_t, pid_process_denom) },
+    { "gov_update_rate",            VAR_UINT16 | MASTER_VALUE,  .config.minmaxUnsigned = { 0, MAX_SUBTASK_UPDATE_RATE }, PG_PID_CONFIG, offsetof(pidConfig_t, gov_update_rate) },
+    { "mixer_update_rate",          VAR_UINT16 | MASTER_VALUE,  .config.minmaxUnsigned = { 0, MAX_SUBTASK_UPDATE_RATE }, PG_PID_CONFIG, offsetof(pidConfig_t, mixer_update_rate) },
+    { "servo_update_rate",          VAR_UINT16 | MASTER_VALUE,  .config.minmaxUnsigned = { 0, MAX_SUBTASK_UPDATE_RATE }, PG_PID_CONFIG, offsetof(pidConfig_t, servo_update_rate) },
+    { "motor_update_rate",          VAR_UINT16 | MASTER_VALUE,  .config.minmaxUnsigned = { 0, MAX_SUBTASK_UPDATE_RATE }, PG_PID_CONFIG, offsetof(pidConfig_t, motor_update_rate) },
 
 // PG_PID_PROFILE
 #ifdef USE_PROFILE_NAMES
@@ -1061,6 +1108,9 @@ const clivalue_t valueTable[] = {
     // Set to $size_of_battery to get a percentage of battery used.
     { "mavlink_mah_as_heading_divisor", VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 0, 30000 }, PG_TELEMETRY_CONFIG, offsetof(telemetryConfig_t, mavlink_mah_as_heading_divisor) },
 #endif
+#if defined(USE_TELEMETRY_CRSF)
+    { "crsf_telemetry_ratio",       VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 0, 128 }, PG_TELEMETRY_CONFIG, offsetof(telemetryConfig_t, crsf_telemetry_ratio) },
+#endif
 #ifdef USE_TELEMETRY_SENSORS_DISABLED_DETAILS
     { "telemetry_disabled_voltage",         VAR_UINT32  | MASTER_VALUE | MODE_BITSET, .config.bitpos = LOG2(SENSOR_VOLTAGE),         PG_TELEMETRY_CONFIG, offsetof(telemetryConfig_t, disabledSensors)},
     { "telemetry_disabled_current",         VAR_UINT32  | MASTER_VALUE | MODE_BITSET, .config.bitpos = LOG2(SENSOR_CURRENT),         PG_TELEMETRY_CONFIG, offsetof(telemetryConfig_t, disabledSensors)},
@@ -1082,6 +1132,9 @@ const clivalue_t valueTable[] = {
     { "telemetry_disabled_esc_rpm",         VAR_UINT32  | MASTER_VALUE | MODE_BITSET, .config.bitpos = LOG2(ESC_SENSOR_RPM),         PG_TELEMETRY_CONFIG, offsetof(telemetryConfig_t, disabledSensors)},
     { "telemetry_disabled_esc_temperature", VAR_UINT32  | MASTER_VALUE | MODE_BITSET, .config.bitpos = LOG2(ESC_SENSOR_TEMPERATURE), PG_TELEMETRY_CONFIG, offsetof(telemetryConfig_t, disabledSensors)},
     { "telemetry_disabled_temperature",     VAR_UINT32  | MASTER_VALUE | MODE_BITSET, .config.bitpos = LOG2(SENSOR_TEMPERATURE),     PG_TELEMETRY_CONFIG, offsetof(telemetryConfig_t, disabledSensors)},
+    { "telemetry_disabled_headspeed",       VAR_UINT32  | MASTER_VALUE | MODE_BITSET, .config.bitpos = LOG2(SENSOR_HEADSPEED),       PG_TELEMETRY_CONFIG, offsetof(telemetryConfig_t, disabledSensors)},
+    { "telemetry_disabled_governor",        VAR_UINT32  | MASTER_VALUE | MODE_BITSET, .config.bitpos = LOG2(SENSOR_GOVERNOR),        PG_TELEMETRY_CONFIG, offsetof(telemetryConfig_t, disabledSensors)},
+    { "telemetry_disabled_bec_voltage",     VAR_UINT32  | MASTER_VALUE | MODE_BITSET, .config.bitpos = LOG2(SENSOR_BEC_VOLTAGE),     PG_TELEMETRY_CONFIG, offsetof(telemetryConfig_t, disabledSensors)},
 #else
     { "telemetry_disabled_sensors", VAR_UINT32 | MASTER_VALUE, .config.u32Max = SENSOR_ALL, PG_TELEMETRY_CONFIG, offsetof(telemetryConfig_t, disabledSensors)},
 #endif
@@ -1494,6 +1547,15 @@ const clivalue_t valueTable[] = {
     { "gyro_rpm_filter_bank_notch_q",     VAR_UINT16 | MASTER_VALUE | MODE_ARRAY, .config.array.length = RPM_FILTER_BANK_COUNT, PG_RPM_FILTER_CONFIG, offsetof(rpmFilterConfig_t, filter_bank_notch_q) },
     { "gyro_rpm_filter_bank_min_hz",      VAR_UINT16 | MASTER_VALUE | MODE_ARRAY, .config.array.length = RPM_FILTER_BANK_COUNT, PG_RPM_FILTER_CONFIG, offsetof(rpmFilterConfig_t, filter_bank_min_hz) },
     { "gyro_rpm_filter_bank_max_hz",      VAR_UINT16 | MASTER_VALUE | MODE_ARRAY, .config.array.length = RPM_FILTER_BANK_COUNT, PG_RPM_FILTER_CONFIG, offsetof(rpmFilterConfig_t, filter_bank_max_hz) },
+    { "gyro_rpm_filter_mode",             VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_RPM_FILTER_MODE }, PG_RPM_FILTER_CONFIG, offsetof(rpmFilterConfig_t, filter_mode) },
+    { "gyro_rpm_filter_auto_notches",     VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 1, RPM_FILTER_BANK_COUNT }, PG_RPM_FILTER_CONFIG, offsetof(rpmFilterConfig_t, filter_auto_notches) },
+    { "gyro_rpm_filter_auto_notch_q",     VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 10, 10000 }, PG_RPM_FILTER_CONFIG, offsetof(rpmFilterConfig_t, filter_auto_notch_q) },
+    { "gyro_rpm_filter_auto_min_hz",      VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 20, 1000 }, PG_RPM_FILTER_CONFIG, offsetof(rpmFilterConfig_t, filter_auto_min_hz) },
+    { "gyro_rpm_filter_auto_max_hz",      VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 100, 4000 }, PG_RPM_FILTER_CONFIG, offsetof(rpmFilterConfig_t, filter_auto_max_hz) },
+    { "gyro_rpm_filter_auto_pinion_teeth",VAR_UINT8  | MASTER_VALUE, .config.minmaxUnsigned = { 0, 50 }, PG_RPM_FILTER_CONFIG, offsetof(rpmFilterConfig_t, filter_auto_pinion_teeth) },
+    { "gyro_rpm_filter_adaptive",         VAR_UINT8  | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, PG_RPM_FILTER_CONFIG, offsetof(rpmFilterConfig_t, filter_adaptive) },
+    { "gyro_rpm_filter_adaptive_min_amp", VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 0, 10000 }, PG_RPM_FILTER_CONFIG, offsetof(rpmFilterConfig_t, filter_adaptive_min_amp) },
+    { "gyro_rpm_filter_adaptive_full_amp",VAR_UINT16 | MASTER_VALUE, .config.minmaxUnsigned = { 1, 10000 }, PG_RPM_FILTER_CONFIG, offsetof(rpmFilterConfig_t, filter_adaptive_full_amp) },
 #endif
 
 #ifdef USE_RX_FLYSKY
@@ -1527,6 +1589,80 @@ const clivalue_t valueTable[] = {
 
 const uint16_t valueTableEntryCount = ARRAYLEN(valueTable);
 
+// Hash index over the setting names, chained through settingHashNext.
+// Built on the first lookup, ARRAYLEN(valueTable) terminates the chains.
+#define SETTING_HASH_BUCKETS 256
+
+static uint16_t settingHashHead[SETTING_HASH_BUCKETS];
+static uint16_t settingHashNext[ARRAYLEN(valueTable)];
+static bool settingHashReady;
+
+// FNV-1a, case insensitive
+static uint8_t settingNameHash(const char *name, uint8_t length)
+{
+    uint32_t hash = 2166136261U;
+
+    for (int i = 0; i < length; i++) {
+        hash ^= (uint8_t)tolower((unsigned char)name[i]);
+        hash *= 16777619U;
+    }
+
+    return (hash ^ (hash >> 8) ^ (hash >> 16) ^ (hash >> 24)) & (SETTING_HASH_BUCKETS - 1);
+}
+
+static void settingHashInit(void)
+{
+    for (int i = 0; i < SETTING_HASH_BUCKETS; i++) {
+        settingHashHead[i] = ARRAYLEN(valueTable);
+    }
+
+    // insert backwards, so the chains keep the table order
+    for (int i = ARRAYLEN(valueTable) - 1; i >= 0; i--) {
+        const uint8_t hash = settingNameHash(valueTable[i].name, strlen(valueTable[i].name));
+        settingHashNext[i] = settingHashHead[hash];
+        settingHashHead[hash] = i;
+    }
+
+    settingHashReady = true;
+}
+
+// Find a setting by name, name need not be null terminated.
+// Returns valueTableEntryCount when not found.
+uint16_t findSettingIndex(const char *name, uint8_t length)
+{
+    if (!settingHashReady) {
+        settingHashInit();
+    }
+
+    for (uint16_t i = settingHashHead[settingNameHash(name, length)]; i < ARRAYLEN(valueTable); i = settingHashNext[i]) {
+        const char *settingName = valueTable[i].name;
+
+        // exact match only, so that shorter names are not matched
+        if (strncasecmp(name, settingName, length) == 0 && settingName[length] == '\0') {
+            return i;
+        }
+    }
+
+    return valueTableEntryCount;
+}
+
+void getSettingMinMax(const clivalue_t *var, int *min, int *max)
+{
+    switch (var->type & VALUE_TYPE_MASK) {
+    case VAR_UINT8:
+    case VAR_UINT16:
+        *min = var->config.minmaxUnsigned.min;
+        *max = var->config.minmaxUnsigned.max;
+
+        break;
+    default:
+        *min = var->config.minmax.min;
+        *max = var->config.minmax.max;
+
+        break;
+    }
+}
+
 void settingsBuildCheck() {
     STATIC_ASSERT(LOOKUP_TABLE_COUNT == ARRAYLEN(lookupTables), LOOKUP_TABLE_COUNT_incorrect);
 }
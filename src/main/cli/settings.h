@@ -133,6 +133,8 @@ typedef enum {
     TABLE_TAIL_MODE,
     TABLE_GOVERNOR_MODE,
     TABLE_RATE_NORMALIZATION,
+    TABLE_IMU_MODE,
+    TABLE_RPM_FILTER_MODE,
 
     LOOKUP_TABLE_COUNT
 } lookupTableIndex_e;
@@ -225,6 +227,9 @@ extern const lookupTableEntry_t lookupTables[];
 extern const uint16_t valueTableEntryCount;
 
 extern const clivalue_t valueTable[];
+
+uint16_t findSettingIndex(const char *name, uint8_t length);
+void getSettingMinMax(const clivalue_t *var, int *min, int *max);
 //extern const uint8_t lookupTablesEntryCount;
 
 extern const char * const lookupTableGyroHardware[];
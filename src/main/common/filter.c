@@ -193,6 +193,85 @@ FAST_CODE void biquadFilterUpdate(biquadFilter_t *filter, float filterFreq, uint
     filter->y2 = y2;
 }
 
+/*
+ * Notch coefficients without trigonometry, for filters retuned in flight.
+ *
+ * sin and cos of the normalised frequency come from a quarter wave table,
+ * corrected with the angle sum identities and a short series for the
+ * remainder. The accuracy is needed for notches far below Nyquist, where
+ * small errors in cos move the notch noticeably. This leaves a handful of
+ * multiply-adds and a single division per update. The filter state is not
+ * touched.
+ */
+
+#define NOTCH_SINE_TABLE_SIZE   64
+
+static const float notchSineTable[NOTCH_SINE_TABLE_SIZE + 1] = {
+    0.00000000f, 0.02454123f, 0.04906767f, 0.07356456f, 0.09801714f,
+    0.12241068f, 0.14673047f, 0.17096189f, 0.19509032f, 0.21910124f,
+    0.24298018f, 0.26671276f, 0.29028468f, 0.31368174f, 0.33688985f,
+    0.35989504f, 0.38268343f, 0.40524131f, 0.42755509f, 0.44961133f,
+    0.47139674f, 0.49289819f, 0.51410274f, 0.53499762f, 0.55557023f,
+    0.57580819f, 0.59569930f, 0.61523159f, 0.63439328f, 0.65317284f,
+    0.67155895f, 0.68954054f, 0.70710678f, 0.72424708f, 0.74095113f,
+    0.75720885f, 0.77301045f, 0.78834643f, 0.80320753f, 0.81758481f,
+    0.83146961f, 0.84485357f, 0.85772861f, 0.87008699f, 0.88192126f,
+    0.89322430f, 0.90398929f, 0.91420976f, 0.92387953f, 0.93299280f,
+    0.94154407f, 0.94952818f, 0.95694034f, 0.96377607f, 0.97003125f,
+    0.97570213f, 0.98078528f, 0.98527764f, 0.98917651f, 0.99247953f,
+    0.99518473f, 0.99729046f, 0.99879546f, 0.99969882f, 1.00000000f,
+};
+
+FAST_CODE void biquadFilterUpdateNotch(biquadFilter_t *filter, float filterFreq, uint32_t refreshRate, float Q)
+{
+    // Table position of omega = 2pi * f / fs, limited to [0,pi)
+    const float x = constrainf(filterFreq * refreshRate * 1e-6f, 0, 0.499f) * (4 * NOTCH_SINE_TABLE_SIZE);
+    const int k = x + 0.5f;
+
+    // Remainder angle, |d| <= pi/256
+    const float d = (x - k) * (M_PI_FLOAT / (2 * NOTCH_SINE_TABLE_SIZE));
+    const float d2 = d * d;
+    const float sd = d * (1 - d2 * (1.0f / 6));
+    const float cd = 1 - d2 * (0.5f - d2 * (1.0f / 24));
+
+    float sk, ck;
+
+    if (k <= NOTCH_SINE_TABLE_SIZE) {
+        sk = notchSineTable[k];
+        ck = notchSineTable[NOTCH_SINE_TABLE_SIZE - k];
+    } else {
+        sk = notchSineTable[2 * NOTCH_SINE_TABLE_SIZE - k];
+        ck = -notchSineTable[k - NOTCH_SINE_TABLE_SIZE];
+    }
+
+    const float sn = sk * cd + ck * sd;
+    const float cs = ck * cd - sk * sd;
+
+    // Same as biquadFilterInit() FILTER_NOTCH, scaled by 2Q
+    const float q2 = 2 * Q;
+    const float r = 1.0f / (q2 + sn);
+
+    filter->b0 = q2 * r;
+    filter->b1 = -2 * cs * filter->b0;
+    filter->b2 = filter->b0;
+    filter->a1 = filter->b1;
+    filter->a2 = (q2 - sn) * r;
+}
+
+/*
+ * Limits the depth of a notch set up by biquadFilterUpdateNotch(), by mixing
+ * the input back to the output. The centre gain becomes 1-depth, and both
+ * the attenuation and the phase delay around the notch scale down with it.
+ */
+FAST_CODE void biquadFilterSetNotchDepth(biquadFilter_t *filter, float depth)
+{
+    const float dry = 1.0f - depth;
+
+    // b = dry * a + depth * b, where a0 = 1 and b1 = a1 for a notch
+    filter->b0 = dry + depth * filter->b0;
+    filter->b2 = dry * filter->a2 + depth * filter->b2;
+}
+
 FAST_CODE void biquadFilterUpdateLPF(biquadFilter_t *filter, float filterFreq, uint32_t refreshRate)
 {
     biquadFilterUpdate(filter, filterFreq, refreshRate, BIQUAD_Q, FILTER_LPF);
@@ -229,6 +308,219 @@ FAST_CODE float biquadFilterApply(biquadFilter_t *filter, float input)
     return result;
 }
 
+/* PT1 filter as a first order biquad section, y = k * x + (1 - k) * y1 */
+void biquadFilterInitPT1(biquadFilter_t *filter, float k)
+{
+    biquadFilterUpdatePT1(filter, k);
+
+    filter->x1 = filter->x2 = 0;
+    filter->y1 = filter->y2 = 0;
+}
+
+FAST_CODE void biquadFilterUpdatePT1(biquadFilter_t *filter, float k)
+{
+    filter->b0 = k;
+    filter->b1 = 0;
+    filter->b2 = 0;
+    filter->a1 = k - 1;
+    filter->a2 = 0;
+}
+
+void filterChainReset(filterChain_t *chain)
+{
+    chain->count = 0;
+}
+
+/* Returns the next free stage, or NULL if the chain is full */
+biquadFilter_t *filterChainAddStage(filterChain_t *chain)
+{
+    if (chain->count < FILTER_CHAIN_MAX_STAGES) {
+        return &chain->stage[chain->count++];
+    }
+    return NULL;
+}
+
+/* Runs a sample through all stages of the chain without any indirect calls */
+FAST_CODE float filterChainApply(filterChain_t *chain, float input)
+{
+    biquadFilter_t *filter = chain->stage;
+
+    for (int i = 0; i < chain->count; i++, filter++) {
+        const float result = filter->b0 * input + filter->b1 * filter->x1 + filter->b2 * filter->x2 - filter->a1 * filter->y1 - filter->a2 * filter->y2;
+
+        filter->x2 = filter->x1;
+        filter->x1 = input;
+
+        filter->y2 = filter->y1;
+        filter->y1 = result;
+
+        input = result;
+    }
+
+    return input;
+}
+
+/*
+ * Higher order lowpass filters as cascades of biquad sections.
+ *
+ * PTn filters are n equal PT1 sections, with the cutoff corrected so that
+ * the cascade is -3dB at the requested frequency. Butterworth and Bessel
+ * sections are 2nd order lowpass sections with tabulated Q and frequency
+ * factors (Bessel normalised to -3dB at the cutoff).
+ */
+
+#define PT2_CUTOFF_CORRECTION   1.553773974f    // 1 / sqrt(2^(1/2) - 1)
+#define PT3_CUTOFF_CORRECTION   1.961459177f    // 1 / sqrt(2^(1/3) - 1)
+
+typedef struct {
+    float freq;
+    float Q;
+} lowpassSection_t;
+
+static const lowpassSection_t butterworth4Sections[] = {
+    { 1.0f,         0.54119610f },
+    { 1.0f,         1.30656296f },
+};
+
+static const lowpassSection_t bessel2Sections[] = {
+    { 1.27201965f,  0.57735027f },
+};
+
+static const lowpassSection_t bessel4Sections[] = {
+    { 1.43017156f,  0.52193458f },
+    { 1.60335752f,  0.80553828f },
+};
+
+int lowpassFilterSections(lowpassFilterType_e type)
+{
+    switch (type) {
+    case FILTER_PT1:
+    case FILTER_BIQUAD:
+    case FILTER_BESSEL2:
+        return 1;
+    case FILTER_PT2:
+    case FILTER_BUTTERWORTH4:
+    case FILTER_BESSEL4:
+        return 2;
+    case FILTER_PT3:
+        return 3;
+    default:
+        return 0;
+    }
+}
+
+static void lowpassFilterUpdateSections(biquadFilter_t *sections, const lowpassSection_t *table, int count, float cutoffHz, uint32_t refreshRate)
+{
+    // Keep the sections well below Nyquist to stay stable
+    const float maxHz = 0.45e6f / refreshRate;
+
+    for (int i = 0; i < count; i++) {
+        biquadFilterUpdate(&sections[i], MIN(cutoffHz * table[i].freq, maxHz), refreshRate, table[i].Q, FILTER_LPF);
+    }
+}
+
+/* Updates the coefficients of consecutive sections, keeping the state */
+FAST_CODE_NOINLINE void lowpassFilterUpdate(biquadFilter_t *sections, lowpassFilterType_e type, float cutoffHz, uint32_t refreshRate)
+{
+    const float dT = refreshRate * 1e-6f;
+
+    switch (type) {
+    case FILTER_PT1:
+        biquadFilterUpdatePT1(&sections[0], pt1FilterGain(cutoffHz, dT));
+        break;
+    case FILTER_PT2:
+        {
+            const float k = pt1FilterGain(cutoffHz * PT2_CUTOFF_CORRECTION, dT);
+            biquadFilterUpdatePT1(&sections[0], k);
+            biquadFilterUpdatePT1(&sections[1], k);
+        }
+        break;
+    case FILTER_PT3:
+        {
+            const float k = pt1FilterGain(cutoffHz * PT3_CUTOFF_CORRECTION, dT);
+            biquadFilterUpdatePT1(&sections[0], k);
+            biquadFilterUpdatePT1(&sections[1], k);
+            biquadFilterUpdatePT1(&sections[2], k);
+        }
+        break;
+    case FILTER_BIQUAD:
+        biquadFilterUpdateLPF(&sections[0], cutoffHz, refreshRate);
+        break;
+    case FILTER_BUTTERWORTH4:
+        lowpassFilterUpdateSections(sections, butterworth4Sections, ARRAYLEN(butterworth4Sections), cutoffHz, refreshRate);
+        break;
+    case FILTER_BESSEL2:
+        lowpassFilterUpdateSections(sections, bessel2Sections, ARRAYLEN(bessel2Sections), cutoffHz, refreshRate);
+        break;
+    case FILTER_BESSEL4:
+        lowpassFilterUpdateSections(sections, bessel4Sections, ARRAYLEN(bessel4Sections), cutoffHz, refreshRate);
+        break;
+    default:
+        break;
+    }
+}
+
+void lowpassFilterInit(biquadFilter_t *sections, lowpassFilterType_e type, float cutoffHz, uint32_t refreshRate)
+{
+    const int count = lowpassFilterSections(type);
+
+    for (int i = 0; i < count; i++) {
+        memset(&sections[i], 0, sizeof(biquadFilter_t));
+    }
+
+    lowpassFilterUpdate(sections, type, cutoffHz, refreshRate);
+}
+
+/* Adds all sections of a lowpass filter to the chain. Returns the first section, or NULL if they don't fit */
+biquadFilter_t *filterChainAddLowpass(filterChain_t *chain, lowpassFilterType_e type, float cutoffHz, uint32_t refreshRate)
+{
+    const int count = lowpassFilterSections(type);
+
+    if (count == 0 || chain->count + count > FILTER_CHAIN_MAX_STAGES) {
+        return NULL;
+    }
+
+    biquadFilter_t *sections = &chain->stage[chain->count];
+    chain->count += count;
+
+    lowpassFilterInit(sections, type, cutoffHz, refreshRate);
+
+    return sections;
+}
+
+
+/*
+ * State variable notch filter. The centre frequency enters the
+ * coefficients linearly (with a small cubic correction), so it can
+ * follow a changing frequency on every sample without trigonometry.
+ */
+
+void svfFilterInit(svfFilter_t *filter, float centerFreq, float Q, uint32_t refreshRate)
+{
+    filter->low = 0;
+    filter->band = 0;
+    filter->q = 1.0f / Q;
+    filter->freqScale = 2 * M_PI_FLOAT * refreshRate * 1e-6f;
+
+    svfFilterSetFrequency(filter, centerFreq);
+}
+
+FAST_CODE void svfFilterSetFrequency(svfFilter_t *filter, float centerFreq)
+{
+    // f = 2 * sin(pi * fc / fs), limited to fs/6 where the topology stays accurate and stable
+    const float x = centerFreq * filter->freqScale;
+    filter->f = constrainf(x - x * x * x / 24, 0, 1.0f);
+}
+
+FAST_CODE float svfFilterApplyNotch(svfFilter_t *filter, float input)
+{
+    filter->low += filter->f * filter->band;
+    const float high = input - filter->low - filter->q * filter->band;
+    filter->band += filter->f * high;
+
+    return filter->low + high;
+}
+
 void laggedMovingAverageInit(laggedMovingAverage_t *filter, uint16_t windowSize, float *buf)
 {
     filter->movingWindowIndex = 0;
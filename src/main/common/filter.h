@@ -41,6 +41,21 @@ typedef struct biquadFilter_s {
     float x1, x2, y1, y2;
 } biquadFilter_t;
 
+/* state variable filter, Chamberlin topology */
+typedef struct svfFilter_s {
+    float low, band;
+    float f, q;
+    float freqScale;
+} svfFilter_t;
+
+#define FILTER_CHAIN_MAX_STAGES 8
+
+/* cascade of filter stages, all stored as DF1 biquad sections */
+typedef struct filterChain_s {
+    uint8_t count;
+    biquadFilter_t stage[FILTER_CHAIN_MAX_STAGES];
+} filterChain_t;
+
 typedef struct laggedMovingAverage_s {
     uint16_t movingWindowIndex;
     uint16_t windowSize;
@@ -52,6 +67,12 @@ typedef struct laggedMovingAverage_s {
 typedef enum {
     FILTER_PT1 = 0,
     FILTER_BIQUAD,
+    FILTER_PT2,
+    FILTER_PT3,
+    FILTER_BUTTERWORTH4,
+    FILTER_BESSEL2,
+    FILTER_BESSEL4,
+    FILTER_LOWPASS_TYPE_COUNT
 } lowpassFilterType_e;
 
 typedef enum {
@@ -70,11 +91,30 @@ void biquadFilterInitLPF(biquadFilter_t *filter, float filterFreq, uint32_t refr
 void biquadFilterInitBessel(biquadFilter_t *filter, float filterFreq, uint32_t refreshRate);
 void biquadFilterInit(biquadFilter_t *filter, float filterFreq, uint32_t refreshRate, float Q, biquadFilterType_e filterType);
 void biquadFilterUpdate(biquadFilter_t *filter, float filterFreq, uint32_t refreshRate, float Q, biquadFilterType_e filterType);
+void biquadFilterUpdateNotch(biquadFilter_t *filter, float filterFreq, uint32_t refreshRate, float Q);
+void biquadFilterSetNotchDepth(biquadFilter_t *filter, float depth);
 void biquadFilterUpdateLPF(biquadFilter_t *filter, float filterFreq, uint32_t refreshRate);
 void biquadFilterUpdateBessel(biquadFilter_t *filter, float filterFreq, uint32_t refreshRate);
 
 float biquadFilterApplyDF1(biquadFilter_t *filter, float input);
 float biquadFilterApply(biquadFilter_t *filter, float input);
+
+void biquadFilterInitPT1(biquadFilter_t *filter, float k);
+void biquadFilterUpdatePT1(biquadFilter_t *filter, float k);
+
+void filterChainReset(filterChain_t *chain);
+biquadFilter_t *filterChainAddStage(filterChain_t *chain);
+float filterChainApply(filterChain_t *chain, float input);
+
+int lowpassFilterSections(lowpassFilterType_e type);
+void lowpassFilterInit(biquadFilter_t *sections, lowpassFilterType_e type, float cutoffHz, uint32_t refreshRate);
+void lowpassFilterUpdate(biquadFilter_t *sections, lowpassFilterType_e type, float cutoffHz, uint32_t refreshRate);
+biquadFilter_t *filterChainAddLowpass(filterChain_t *chain, lowpassFilterType_e type, float cutoffHz, uint32_t refreshRate);
+
+void svfFilterInit(svfFilter_t *filter, float centerFreq, float Q, uint32_t refreshRate);
+void svfFilterSetFrequency(svfFilter_t *filter, float centerFreq);
+float svfFilterApplyNotch(svfFilter_t *filter, float input);
+
 float filterGetNotchQ(float centerFreq, float cutoffFreq);
 
 void laggedMovingAverageInit(laggedMovingAverage_t *filter, uint16_t windowSize, float *buf);
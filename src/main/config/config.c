@@ -92,6 +92,11 @@
 
 static bool configIsDirty; /* someone indicated that the config is modified and it is not yet saved */
 
+static bool configSavePending;  /* background save requested */
+static bool configSaveActive;   /* journal write in progress */
+static bool configSaveRewrite;  /* journal not usable, waiting for a full rewrite */
+static bool configSaveRerun;    /* saved again during a journal write, needs another pass */
+
 static bool rebootRequired = false;  // set if a config change requires a reboot to take effect
 
 pidProfile_t *currentPidProfile;
@@ -688,6 +693,11 @@ void writeUnmodifiedConfigToEEPROM(void)
 
     resumeRxPwmPpmSignal();
     configIsDirty = false;
+
+    configSavePending = false;
+    configSaveActive = false;
+    configSaveRewrite = false;
+    configSaveRerun = false;
 }
 
 void writeEEPROM(void)
@@ -697,6 +707,62 @@ void writeEEPROM(void)
     writeUnmodifiedConfigToEEPROM();
 }
 
+// Save the config in the background, without stalling the control loop
+void writeEEPROMAsync(void)
+{
+    systemConfigMutable()->configurationState = CONFIGURATION_STATE_CONFIGURED;
+
+    // The running pass may already be past the PGs that changed
+    if (configSaveActive) {
+        configSaveRerun = true;
+    }
+
+    configSavePending = true;
+}
+
+void configSaveUpdate(timeUs_t currentTimeUs)
+{
+    UNUSED(currentTimeUs);
+
+    if (!configSavePending) {
+        return;
+    }
+
+    if (!configSaveActive && !configSaveRewrite) {
+        configSaveActive = startConfigJournalWrite();
+        configSaveRewrite = !configSaveActive;
+    }
+
+    if (configSaveActive) {
+        // Flash erase stalls the CPU, records entering a new page wait until disarmed
+        switch (continueConfigJournalWrite(!ARMING_FLAG(ARMED))) {
+        case CONFIG_WRITE_BUSY:
+        case CONFIG_WRITE_DEFERRED:
+            return;
+        case CONFIG_WRITE_DONE:
+            configSaveActive = false;
+            if (configSaveRerun) {
+                // Start another pass on the next run
+                configSaveRerun = false;
+                return;
+            }
+            configSavePending = false;
+            configIsDirty = false;
+            return;
+        default:
+            configSaveActive = false;
+            configSaveRerun = false;
+            configSaveRewrite = true;
+            break;
+        }
+    }
+
+    // No journal or no room left. The snapshot rewrite blocks, so wait until disarmed.
+    if (!ARMING_FLAG(ARMED)) {
+        writeUnmodifiedConfigToEEPROM();
+    }
+}
+
 bool resetEEPROM(bool useCustomDefaults)
 {
 #if !defined(USE_CUSTOM_DEFAULTS)
@@ -23,6 +23,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "common/time.h"
+
 #include "pg/pg.h"
 
 #define MAX_NAME_LENGTH 16u
@@ -70,6 +72,8 @@ void initEEPROM(void);
 bool resetEEPROM(bool useCustomDefaults);
 bool readEEPROM(void);
 void writeEEPROM(void);
+void writeEEPROMAsync(void);
+void configSaveUpdate(timeUs_t currentTimeUs);
 void writeUnmodifiedConfigToEEPROM(void);
 void ensureEEPROMStructureIsValid(void);
 
@@ -26,7 +26,9 @@
 
 #include "build/build_config.h"
 
+#include "common/bitarray.h"
 #include "common/crc.h"
+#include "common/maths.h"
 #include "common/utils.h"
 
 #include "config/config_eeprom.h"
@@ -77,6 +79,44 @@ typedef struct {
 } PG_PACKED configFooter_t;
 // checksum is appended just after footer. It is not included in footer to make checksum calculation consistent
 
+#ifdef USE_CONFIG_JOURNAL
+// Header for each journal record. Journal records are appended after the
+// snapshot, followed by the CRC of the record and padded to the flash
+// write size. A later record for the same PG replaces the earlier ones.
+typedef struct {
+    uint16_t size;          // header and PG data, without the CRC
+    uint16_t baseCrc;       // stored CRC of the snapshot the record belongs to
+    pgn_t pgn;
+    uint8_t version;
+    uint8_t flags;
+    uint8_t pg[];
+} PG_PACKED configJournalRecord_t;
+
+// Stored copies compared per call, each comparison scans the journal and the snapshot
+#define JOURNAL_CHECKS_PER_CALL     4
+
+#define JOURNAL_ALIGN(size)         (((size) + CONFIG_STREAMER_BUFFER_SIZE - 1) & ~(CONFIG_STREAMER_BUFFER_SIZE - 1))
+#define JOURNAL_RECORD_SPACE(size)  JOURNAL_ALIGN((size) + sizeof(uint16_t))
+
+typedef enum {
+    JOURNAL_WRITE_IDLE = 0,
+    JOURNAL_WRITE_NEXT,
+    JOURNAL_WRITE_RECORD,
+} journalWriteState_e;
+
+static bool journalValid;               // set by the last isEEPROMStructureValid() scan
+static uint16_t journalBaseCrc;
+static const uint8_t *journalStart;
+static const uint8_t *journalEnd;
+
+static journalWriteState_e journalWriteState;
+static config_streamer_t journalStreamer;
+static const pgRegistry_t *journalReg;
+static configJournalRecord_t journalRecord;
+static uint16_t journalOffset;          // bytes of the record written, header, PG data and CRC
+static uint16_t journalCrc;
+#endif
+
 // Used to check the compiler packing at build time.
 typedef struct {
     uint8_t byte;
@@ -281,12 +321,60 @@ bool isEEPROMVersionValid(void)
     return true;
 }
 
+#ifdef USE_CONFIG_JOURNAL
+static bool isJournalRecordValid(const uint8_t *p)
+{
+    const configJournalRecord_t *record = (const configJournalRecord_t *)p;
+
+    if (p + sizeof(*record) > &__config_end
+        || record->size < sizeof(*record)
+        || p + JOURNAL_RECORD_SPACE(record->size) > &__config_end
+        || record->baseCrc != journalBaseCrc) {
+        // Free space, left over from an older snapshot or corrupted
+        return false;
+    }
+
+    uint16_t storedCrc;
+    memcpy(&storedCrc, p + record->size, sizeof(storedCrc));
+
+    return crc16_ccitt_update(CRC_START_VALUE, p, record->size) == storedCrc;
+}
+
+// Find the end of the valid journal records
+static void scanJournal(void)
+{
+    while (isJournalRecordValid(journalEnd)) {
+        journalEnd += JOURNAL_RECORD_SPACE(((const configJournalRecord_t *)journalEnd)->size);
+    }
+}
+
+// Find the latest journal record for reg. Returns NULL when not found.
+static const configJournalRecord_t *findJournal(const pgRegistry_t *reg, configRecordFlags_e classification)
+{
+    const configJournalRecord_t *found = NULL;
+
+    for (const uint8_t *p = journalStart; p < journalEnd; ) {
+        const configJournalRecord_t *record = (const configJournalRecord_t *)p;
+        if (pgN(reg) == record->pgn
+            && (record->flags & CR_CLASSIFICATION_MASK) == classification)
+            found = record;
+        p += JOURNAL_RECORD_SPACE(record->size);
+    }
+
+    return found;
+}
+#endif
+
 // Scan the EEPROM config. Returns true if the config is valid.
 bool isEEPROMStructureValid(void)
 {
     const uint8_t *p = &__config_start;
     const configHeader_t *header = (const configHeader_t *)p;
 
+#ifdef USE_CONFIG_JOURNAL
+    journalValid = false;
+#endif
+
     if (header->magic_be != 0xBE) {
         return false;
     }
@@ -320,12 +408,25 @@ bool isEEPROMStructureValid(void)
     // include stored CRC in the CRC calculation
     const uint16_t *storedCrc = (const uint16_t *)p;
     crc = crc16_ccitt_update(crc, storedCrc, sizeof(*storedCrc));
-    p += sizeof(storedCrc);
+    p += sizeof(*storedCrc);
 
     eepromConfigSize = p - &__config_start;
 
     // CRC has the property that if the CRC itself is included in the calculation the resulting CRC will have constant value
-    return crc == CRC_CHECK_VALUE;
+    if (crc != CRC_CHECK_VALUE) {
+        return false;
+    }
+
+#ifdef USE_CONFIG_JOURNAL
+    // The journal starts after the padding of the snapshot
+    journalBaseCrc = *storedCrc;
+    journalStart = &__config_start + JOURNAL_ALIGN(eepromConfigSize);
+    journalEnd = journalStart;
+    scanJournal();
+    journalValid = true;
+#endif
+
+    return true;
 }
 
 uint16_t getEEPROMConfigSize(void)
@@ -369,23 +470,86 @@ static const configRecord_t *findEEPROM(const pgRegistry_t *reg, configRecordFla
     return NULL;
 }
 
+// Load one stored PG copy and note the result in the found/loaded bitmaps
+static void loadEEPROMRecord(pgn_t pgn, uint8_t flags, const void *data, int size, uint8_t version, uint32_t *found, uint32_t *loaded)
+{
+    if ((flags & CR_CLASSIFICATION_MASK) != CR_CLASSICATION_SYSTEM) {
+        return;
+    }
+
+    const pgRegistry_t *reg = pgFind(pgn);
+    if (reg) {
+        const unsigned index = reg - __pg_registry_start;
+
+        bitArraySet(found, index);
+
+        // pgLoad will handle version mismatch
+        if (pgLoad(reg, data, size, version)) {
+            bitArraySet(loaded, index);
+        } else {
+            bitArrayClr(loaded, index);
+        }
+    }
+}
+
 // Initialize all PG records from EEPROM.
-// This functions processes all PGs sequentially, scanning EEPROM for each one. This is suboptimal,
-//   but each PG is loaded/initialized exactly once and in defined order.
+// The snapshot and the journal are scanned once, in storage order, and each record is
+//   matched to its PG with pgFind(). A PG stored more than once is loaded again, so the
+//   latest journal record wins. PGs without a stored copy are reset to defaults.
 bool loadEEPROM(void)
 {
     bool success = true;
 
-    PG_FOREACH(reg) {
-        const configRecord_t *rec = findEEPROM(reg, CR_CLASSICATION_SYSTEM);
-        if (rec) {
-            // config from EEPROM is available, use it to initialize PG. pgLoad will handle version mismatch
-            if (!pgLoad(reg, rec->pg, rec->size - offsetof(configRecord_t, pg), rec->version)) {
+    if (PG_REGISTRY_SIZE > PG_REGISTRY_MAX) {
+        // Registry too large for the bitmaps, look up each PG separately
+        PG_FOREACH(reg) {
+#ifdef USE_CONFIG_JOURNAL
+            const configJournalRecord_t *jrec = findJournal(reg, CR_CLASSICATION_SYSTEM);
+            if (jrec) {
+                success &= pgLoad(reg, jrec->pg, jrec->size - offsetof(configJournalRecord_t, pg), jrec->version);
+                continue;
+            }
+#endif
+            const configRecord_t *rec = findEEPROM(reg, CR_CLASSICATION_SYSTEM);
+            if (rec) {
+                success &= pgLoad(reg, rec->pg, rec->size - offsetof(configRecord_t, pg), rec->version);
+            } else {
+                pgReset(reg);
                 success = false;
             }
-        } else {
-            pgReset(reg);
+        }
+        return success;
+    }
+
+    uint32_t found[PG_REGISTRY_MAX / 32] = { 0 };
+    uint32_t loaded[PG_REGISTRY_MAX / 32] = { 0 };
 
+    const uint8_t *p = &__config_start + sizeof(configHeader_t);
+    while (true) {
+        const configRecord_t *record = (const configRecord_t *)p;
+        if (record->size == 0
+            || p + record->size >= &__config_end
+            || record->size < sizeof(*record))
+            break;
+        loadEEPROMRecord(record->pgn, record->flags, record->pg, record->size - offsetof(configRecord_t, pg), record->version, found, loaded);
+        p += record->size;
+    }
+
+#ifdef USE_CONFIG_JOURNAL
+    for (p = journalStart; p < journalEnd; ) {
+        const configJournalRecord_t *record = (const configJournalRecord_t *)p;
+        loadEEPROMRecord(record->pgn, record->flags, record->pg, record->size - offsetof(configJournalRecord_t, pg), record->version, found, loaded);
+        p += JOURNAL_RECORD_SPACE(record->size);
+    }
+#endif
+
+    PG_FOREACH(reg) {
+        const unsigned index = reg - __pg_registry_start;
+
+        if (!bitArrayGet(found, index)) {
+            pgReset(reg);
+            success = false;
+        } else if (!bitArrayGet(loaded, index)) {
             success = false;
         }
     }
@@ -442,10 +606,213 @@ static bool writeSettingsToEEPROM(void)
     return success;
 }
 
+#ifdef USE_CONFIG_JOURNAL
+// Check if the stored copy of reg, in the journal or in the snapshot, matches the current one
+static bool isStoredCopyCurrent(const pgRegistry_t *reg)
+{
+    const uint8_t *data;
+    uint16_t size;
+    uint8_t version;
+
+    const configJournalRecord_t *jrec = findJournal(reg, CR_CLASSICATION_SYSTEM);
+    if (jrec) {
+        data = jrec->pg;
+        size = jrec->size - offsetof(configJournalRecord_t, pg);
+        version = jrec->version;
+    } else {
+        const configRecord_t *rec = findEEPROM(reg, CR_CLASSICATION_SYSTEM);
+        if (!rec) {
+            return false;
+        }
+        data = rec->pg;
+        size = rec->size - offsetof(configRecord_t, pg);
+        version = rec->version;
+    }
+
+    return size == pgSize(reg) && version == pgVersion(reg) && memcmp(data, reg->address, size) == 0;
+}
+
+static void finishConfigJournalWrite(void)
+{
+    config_streamer_finish(&journalStreamer);
+    journalWriteState = JOURNAL_WRITE_IDLE;
+}
+
+// Write the next flash word of the record. Returns true when the record is complete.
+static bool continueJournalRecord(void)
+{
+    const uint16_t dataSize = journalRecord.size;
+    const uint16_t recordSize = dataSize + sizeof(journalCrc);
+
+    // A record starts on a word boundary, so the streamer is empty between calls
+    do {
+        uint8_t byte;
+
+        if (journalOffset < sizeof(journalRecord)) {
+            byte = ((const uint8_t *)&journalRecord)[journalOffset];
+        } else if (journalOffset < dataSize) {
+            byte = journalReg->address[journalOffset - sizeof(journalRecord)];
+        } else {
+            byte = ((const uint8_t *)&journalCrc)[journalOffset - dataSize];
+        }
+
+        if (journalOffset < dataSize) {
+            journalCrc = crc16_ccitt(journalCrc, byte);
+        }
+
+        config_streamer_write(&journalStreamer, &byte, 1);
+        journalOffset++;
+    } while (journalOffset < recordSize && journalStreamer.at != 0);
+
+    if (journalOffset < recordSize) {
+        return false;
+    }
+
+    config_streamer_flush(&journalStreamer);
+
+    return true;
+}
+
+// Start appending the changed PGs to the journal. Needs a valid snapshot,
+// checked by the isEEPROMStructureValid() scan at boot and after each save.
+bool startConfigJournalWrite(void)
+{
+    if (journalWriteState != JOURNAL_WRITE_IDLE) {
+        return true;
+    }
+
+    if (!journalValid || !isEEPROMVersionValid()) {
+        return false;
+    }
+
+    config_streamer_init(&journalStreamer);
+
+    journalReg = __pg_registry_start;
+    journalWriteState = JOURNAL_WRITE_NEXT;
+
+    return true;
+}
+
+// Write one flash word of the journal per call, comparing at most
+// JOURNAL_CHECKS_PER_CALL stored copies. A record that would erase a flash
+// page is only started when allowErase is set, erasing stalls the CPU.
+configWriteStatus_e continueConfigJournalWrite(bool allowErase)
+{
+    switch (journalWriteState) {
+    case JOURNAL_WRITE_NEXT:
+    {
+        unsigned checks = 0;
+
+        // Skip over the PGs already stored. A PG changed during
+        // its own write is checked again and written once more.
+        while (journalReg < __pg_registry_end) {
+            if (checks++ >= JOURNAL_CHECKS_PER_CALL) {
+                return CONFIG_WRITE_BUSY;
+            }
+            if (!isStoredCopyCurrent(journalReg)) {
+                break;
+            }
+            journalReg++;
+        }
+
+        if (journalReg >= __pg_registry_end) {
+            finishConfigJournalWrite();
+            return journalStreamer.err ? CONFIG_WRITE_FAILED : CONFIG_WRITE_DONE;
+        }
+
+        journalRecord = (configJournalRecord_t) {
+            .size = sizeof(configJournalRecord_t) + pgSize(journalReg),
+            .baseCrc = journalBaseCrc,
+            .pgn = pgN(journalReg),
+            .version = pgVersion(journalReg),
+            .flags = CR_CLASSICATION_SYSTEM,
+        };
+
+        const uint16_t space = JOURNAL_RECORD_SPACE(journalRecord.size);
+
+        if (journalEnd + space > &__config_end) {
+            finishConfigJournalWrite();
+            return CONFIG_WRITE_FULL;
+        }
+
+        if (!allowErase && config_streamer_erases((uintptr_t)journalEnd, space)) {
+            return CONFIG_WRITE_DEFERRED;
+        }
+
+        config_streamer_start(&journalStreamer, (uintptr_t)journalEnd, space);
+
+        journalCrc = CRC_START_VALUE;
+        journalOffset = 0;
+        journalWriteState = JOURNAL_WRITE_RECORD;
+
+        return CONFIG_WRITE_BUSY;
+    }
+    case JOURNAL_WRITE_RECORD:
+    {
+        const bool complete = continueJournalRecord();
+
+        if (journalStreamer.err || (complete && !isJournalRecordValid(journalEnd))) {
+            finishConfigJournalWrite();
+            journalValid = false;
+            return CONFIG_WRITE_FAILED;
+        }
+
+        if (complete) {
+            journalEnd += JOURNAL_RECORD_SPACE(journalRecord.size);
+            journalWriteState = JOURNAL_WRITE_NEXT;
+        }
+
+        return CONFIG_WRITE_BUSY;
+    }
+    default:
+        return CONFIG_WRITE_DONE;
+    }
+}
+
+void abortConfigJournalWrite(void)
+{
+    if (journalWriteState != JOURNAL_WRITE_IDLE) {
+        finishConfigJournalWrite();
+    }
+}
+#else
+bool startConfigJournalWrite(void)
+{
+    return false;
+}
+
+configWriteStatus_e continueConfigJournalWrite(bool allowErase)
+{
+    UNUSED(allowErase);
+    return CONFIG_WRITE_FAILED;
+}
+
+void abortConfigJournalWrite(void)
+{
+}
+#endif
+
 void writeConfigToEEPROM(void)
 {
     bool success = false;
-    // write it
+
+    abortConfigJournalWrite();
+
+#ifdef USE_CONFIG_JOURNAL
+    // Append the changed PGs to the journal
+    if (isEEPROMStructureValid() && startConfigJournalWrite()) {
+        configWriteStatus_e status;
+        do {
+            status = continueConfigJournalWrite(true);
+        } while (status == CONFIG_WRITE_BUSY);
+
+        if (status == CONFIG_WRITE_DONE && isEEPROMStructureValid()) {
+            return;
+        }
+    }
+#endif
+
+    // Rewrite the snapshot, which also compacts the journal
     for (int attempt = 0; attempt < 3 && !success; attempt++) {
         if (writeSettingsToEEPROM()) {
             success = true;
@@ -25,10 +25,22 @@
 
 #define EEPROM_CONF_VERSION 173
 
+typedef enum {
+    CONFIG_WRITE_DONE = 0,
+    CONFIG_WRITE_BUSY,
+    CONFIG_WRITE_FULL,      // no room in the journal, the snapshot needs a rewrite
+    CONFIG_WRITE_FAILED,
+    CONFIG_WRITE_DEFERRED,  // the next record erases flash, retry when erasing is allowed
+} configWriteStatus_e;
+
 bool isEEPROMVersionValid(void);
 bool isEEPROMStructureValid(void);
 bool loadEEPROM(void);
 void writeConfigToEEPROM(void);
 
+bool startConfigJournalWrite(void);
+configWriteStatus_e continueConfigJournalWrite(bool allowErase);
+void abortConfigJournalWrite(void);
+
 uint16_t getEEPROMConfigSize(void);
 size_t getEEPROMStorageSize(void);
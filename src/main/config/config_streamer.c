@@ -22,6 +22,8 @@
 
 #include "platform.h"
 
+#include "common/utils.h"
+
 #include "drivers/system.h"
 #include "drivers/flash.h"
 
@@ -88,6 +90,18 @@ void config_streamer_init(config_streamer_t *c)
     memset(c, 0, sizeof(*c));
 }
 
+// Check if writing size bytes at base starts a new flash page, which erases it
+bool config_streamer_erases(uintptr_t base, int size)
+{
+#if defined(CONFIG_IN_FLASH) || defined(CONFIG_IN_FILE)
+    return (base % FLASH_PAGE_SIZE == 0) || (base / FLASH_PAGE_SIZE != (base + size - 1) / FLASH_PAGE_SIZE);
+#else
+    UNUSED(base);
+    UNUSED(size);
+    return false;
+#endif
+}
+
 void config_streamer_start(config_streamer_t *c, uintptr_t base, int size)
 {
     // base must start at FLASH_PAGE_SIZE boundary when using embedded flash.
@@ -37,6 +37,10 @@
 #pragma GCC diagnostic warning "-Wpadded"
 #endif
 
+#define GYRO_DMA_BUFFER_SIZE 8
+
+#define GYRO_FIFO_MAX_SAMPLES 8
+
 typedef enum {
     GYRO_NONE = 0,
     GYRO_DEFAULT,
@@ -104,6 +108,20 @@ typedef struct gyroDev_s {
     fp_rotationMatrix_t rotationMatrix;
     uint16_t gyroSampleRateHz;
     uint16_t accSampleRateHz;
+#ifdef USE_GYRO_FIFO
+    bool fifoEnabled;                                        // samples are read in batches from the sensor FIFO
+    uint8_t fifoCount;                                       // samples in fifoData from the last read
+    uint16_t fifoSampleRateHz;                               // native sensor sample rate in FIFO mode
+    int16_t fifoData[GYRO_FIFO_MAX_SAMPLES][XYZ_AXIS_COUNT];
+#endif
+#ifdef USE_GYRO_DMA
+    bool dmaEnabled;                                         // gyro data is read by EXTI triggered DMA
+    volatile uint8_t dmaReadIndex;                           // last completed DMA buffer
+    uint8_t dmaWriteIndex;                                   // DMA buffer being filled
+    uint8_t dmaLength;
+    uint8_t dmaTxBuf[GYRO_DMA_BUFFER_SIZE];
+    uint8_t dmaRxBuf[2][GYRO_DMA_BUFFER_SIZE];
+#endif
 } gyroDev_t;
 
 typedef struct accDev_s {
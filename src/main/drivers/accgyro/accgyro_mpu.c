@@ -115,7 +115,15 @@ static void mpuIntExtiHandler(extiCallbackRec_t *cb)
     lastCalledAtUs = nowUs;
 #endif
     gyroDev_t *gyro = container_of(cb, gyroDev_t, exti);
-    gyro->dataReady = true;
+#ifdef USE_GYRO_DMA
+    // Data is ready once the DMA read completes
+    if (gyro->dmaEnabled) {
+        spiBusTransferStart(&gyro->bus, gyro->dmaTxBuf, gyro->dmaRxBuf[gyro->dmaWriteIndex], gyro->dmaLength);
+    } else
+#endif
+    {
+        gyro->dataReady = true;
+    }
 #ifdef DEBUG_MPU_DATA_READY_INTERRUPT
     const uint32_t now2Us = micros();
     debug[1] = (uint16_t)(now2Us - nowUs);
@@ -176,9 +184,59 @@ bool mpuGyroRead(gyroDev_t *gyro)
     return true;
 }
 
+#ifdef USE_GYRO_DMA
+static void mpuGyroDmaComplete(void *arg)
+{
+    gyroDev_t *gyro = arg;
+
+    gyro->dmaReadIndex = gyro->dmaWriteIndex;
+    gyro->dmaWriteIndex ^= 1;
+    gyro->dataReady = true;
+}
+
+/*
+ * Switch gyro reads to DMA started from the data ready interrupt.
+ * Call at the end of the gyro init, after the last blocking register access
+ * that changes the bus clock.
+ */
+void mpuGyroDmaInit(gyroDev_t *gyro, uint8_t reg)
+{
+    if (gyro->bus.bustype != BUSTYPE_SPI || !gyro->exti.fn) {
+        return;
+    }
+
+    memset(gyro->dmaTxBuf, 0xFF, sizeof(gyro->dmaTxBuf));
+    memset(gyro->dmaRxBuf, 0, sizeof(gyro->dmaRxBuf));
+
+    gyro->dmaTxBuf[0] = reg | 0x80;
+    gyro->dmaLength = 7;
+    gyro->dmaReadIndex = 0;
+    gyro->dmaWriteIndex = 1;
+
+    gyro->dmaEnabled = spiBusDmaInit(&gyro->bus, mpuGyroDmaComplete, gyro);
+}
+
+bool mpuGyroReadDMA(gyroDev_t *gyro)
+{
+    const uint8_t *data = gyro->dmaRxBuf[gyro->dmaReadIndex];
+
+    gyro->gyroADCRaw[X] = (int16_t)((data[1] << 8) | data[2]);
+    gyro->gyroADCRaw[Y] = (int16_t)((data[3] << 8) | data[4]);
+    gyro->gyroADCRaw[Z] = (int16_t)((data[5] << 8) | data[6]);
+
+    return true;
+}
+#endif
+
 #ifdef USE_SPI_GYRO
 bool mpuGyroReadSPI(gyroDev_t *gyro)
 {
+#ifdef USE_GYRO_DMA
+    if (gyro->dmaEnabled) {
+        return mpuGyroReadDMA(gyro);
+    }
+#endif
+
     static const uint8_t dataToSend[7] = {MPU_RA_GYRO_XOUT_H | 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
     uint8_t data[7];
 
@@ -220,6 +220,10 @@ struct gyroDeviceConfig_s;
 void mpuGyroInit(struct gyroDev_s *gyro);
 bool mpuGyroRead(struct gyroDev_s *gyro);
 bool mpuGyroReadSPI(struct gyroDev_s *gyro);
+#ifdef USE_GYRO_DMA
+void mpuGyroDmaInit(struct gyroDev_s *gyro, uint8_t reg);
+bool mpuGyroReadDMA(struct gyroDev_s *gyro);
+#endif
 void mpuPreInit(const struct gyroDeviceConfig_s *config);
 bool mpuDetect(struct gyroDev_s *gyro, const struct gyroDeviceConfig_s *config);
 uint8_t mpuGyroDLPF(struct gyroDev_s *gyro);
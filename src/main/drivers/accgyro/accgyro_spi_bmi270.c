@@ -25,6 +25,8 @@
 
 #ifdef USE_ACCGYRO_BMI270
 
+#include "common/maths.h"
+
 #include "drivers/accgyro/accgyro.h"
 #include "drivers/accgyro/accgyro_spi_bmi270.h"
 #include "drivers/bus_spi.h"
@@ -37,6 +39,7 @@
 
 #define BMI270_SPI_DIVISOR 16
 #define BMI270_FIFO_FRAME_SIZE 6
+#define BMI270_FIFO_OVERFLOW_SIZE 512  // the FIFO has wrapped or the gyro task stalled
 
 #define BMI270_CONFIG_SIZE 8192
 
@@ -186,9 +189,18 @@ static void bmi270Config(const gyroDev_t *gyro)
     // If running in hardware_lpf experimental mode then switch to FIFO-based,
     // 6.4KHz sampling, unfiltered data vs. the default 3.2KHz with hardware filtering
 #ifdef USE_GYRO_DLPF_EXPERIMENTAL
-    const bool fifoMode = (gyro->hardware_lpf == GYRO_HARDWARE_LPF_EXPERIMENTAL);
+    bool fifoMode = (gyro->hardware_lpf == GYRO_HARDWARE_LPF_EXPERIMENTAL);
 #else
-    const bool fifoMode = false;
+    bool fifoMode = false;
+#endif
+
+    // The FIFO watermark is one sample, or a full batch in gyro FIFO mode
+    uint8_t fifoWatermark = BMI270_VAL_FIFO_WTM_0;
+#ifdef USE_GYRO_FIFO
+    if (gyro->fifoEnabled) {
+        fifoMode = true;
+        fifoWatermark = BMI270_FIFO_FRAME_SIZE * (gyro->fifoSampleRateHz / gyro->gyroSampleRateHz);
+    }
 #endif
 
     // Perform a soft reset to set all configuration to default
@@ -205,7 +217,7 @@ static void bmi270Config(const gyroDev_t *gyro)
         bmi270RegisterWrite(bus, BMI270_REG_FIFO_CONFIG_0, BMI270_VAL_FIFO_CONFIG_0, 1);
         bmi270RegisterWrite(bus, BMI270_REG_FIFO_CONFIG_1, BMI270_VAL_FIFO_CONFIG_1, 1);
         bmi270RegisterWrite(bus, BMI270_REG_FIFO_DOWNS, BMI270_VAL_FIFO_DOWNS, 1);
-        bmi270RegisterWrite(bus, BMI270_REG_FIFO_WTM_0, BMI270_VAL_FIFO_WTM_0, 1);
+        bmi270RegisterWrite(bus, BMI270_REG_FIFO_WTM_0, fifoWatermark, 1);
         bmi270RegisterWrite(bus, BMI270_REG_FIFO_WTM_1, BMI270_VAL_FIFO_WTM_1, 1);
     }
 
@@ -390,8 +402,76 @@ static bool bmi270GyroReadFifo(gyroDev_t *gyro)
 }
 #endif
 
+#ifdef USE_GYRO_FIFO
+static bool bmi270GyroReadFifoBatch(gyroDev_t *gyro)
+{
+    // Register reads start with a dummy byte
+    uint8_t data[1 + GYRO_FIFO_MAX_SAMPLES * BMI270_FIFO_FRAME_SIZE];
+
+    gyro->fifoCount = 0;
+
+    if (!spiBusReadRegisterBuffer(&gyro->bus, BMI270_REG_FIFO_LENGTH_LSB, data, 3)) {
+        return false;
+    }
+
+    const int fifoLength = ((data[2] & 0x3F) << 8) | data[1];
+
+    // Frames may be lost or misaligned after an overflow - start over
+    if (fifoLength >= BMI270_FIFO_OVERFLOW_SIZE) {
+        bmi270RegisterWrite(&gyro->bus, BMI270_REG_CMD, BMI270_VAL_CMD_FIFOFLUSH, 0);
+        return false;
+    }
+
+    // Only whole frames are read so a partial frame is never left in the queue.
+    // Any frames beyond the batch size are picked up on the next read.
+    const int frames = MIN(fifoLength / BMI270_FIFO_FRAME_SIZE, GYRO_FIFO_MAX_SAMPLES);
+    if (frames == 0) {
+        return false;
+    }
+
+    if (!spiBusReadRegisterBuffer(&gyro->bus, BMI270_REG_FIFO_DATA, data, 1 + frames * BMI270_FIFO_FRAME_SIZE)) {
+        return false;
+    }
+
+    int count = 0;
+    for (int i = 0; i < frames; i++) {
+        const uint8_t *frame = &data[1 + i * BMI270_FIFO_FRAME_SIZE];
+        const int16_t gyroX = (int16_t)((frame[1] << 8) | frame[0]);
+        const int16_t gyroY = (int16_t)((frame[3] << 8) | frame[2]);
+        const int16_t gyroZ = (int16_t)((frame[5] << 8) | frame[4]);
+
+        // Skip invalid frames (0x8000)
+        if ((gyroX == INT16_MIN) && (gyroY == INT16_MIN) && (gyroZ == INT16_MIN)) {
+            continue;
+        }
+
+        gyro->fifoData[count][X] = gyroX;
+        gyro->fifoData[count][Y] = gyroY;
+        gyro->fifoData[count][Z] = gyroZ;
+        count++;
+    }
+
+    if (count == 0) {
+        return false;
+    }
+
+    gyro->gyroADCRaw[X] = gyro->fifoData[count - 1][X];
+    gyro->gyroADCRaw[Y] = gyro->fifoData[count - 1][Y];
+    gyro->gyroADCRaw[Z] = gyro->fifoData[count - 1][Z];
+    gyro->fifoCount = count;
+
+    return true;
+}
+#endif
+
 static bool bmi270GyroRead(gyroDev_t *gyro)
 {
+#ifdef USE_GYRO_FIFO
+    if (gyro->fifoEnabled) {
+        // running in 6.4KHz FIFO mode, reading a batch per interrupt
+        return bmi270GyroReadFifoBatch(gyro);
+    }
+#endif
 #ifdef USE_GYRO_DLPF_EXPERIMENTAL
     if (gyro->hardware_lpf == GYRO_HARDWARE_LPF_EXPERIMENTAL) {
         // running in 6.4KHz FIFO mode
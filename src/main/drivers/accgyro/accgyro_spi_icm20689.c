@@ -36,6 +36,9 @@
 #include "drivers/sensor.h"
 #include "drivers/time.h"
 
+#define ICM20689_FIFO_FRAME_SIZE            6       // gyro XYZ only
+#define ICM20689_FIFO_OVERFLOW_SIZE         512     // the FIFO has wrapped or the gyro task stalled
+
 
 static void icm20689SpiInit(const busDevice_t *bus)
 {
@@ -129,7 +132,15 @@ void icm20689GyroInit(gyroDev_t *gyro)
 //    delay(100);
     spiBusWriteRegister(&gyro->bus, MPU_RA_PWR_MGMT_1, INV_CLK_PLL);
     delay(15);
-    spiBusWriteRegister(&gyro->bus, MPU_RA_GYRO_CONFIG, INV_FSR_2000DPS << 3);
+#ifdef USE_GYRO_FIFO
+    if (gyro->fifoEnabled) {
+        // Bypass the DLPF for 32KHz sampling
+        spiBusWriteRegister(&gyro->bus, MPU_RA_GYRO_CONFIG, INV_FSR_2000DPS << 3 | ICM20689_GYRO_FCHOICE_B_32KHZ);
+    } else
+#endif
+    {
+        spiBusWriteRegister(&gyro->bus, MPU_RA_GYRO_CONFIG, INV_FSR_2000DPS << 3);
+    }
     delay(15);
     spiBusWriteRegister(&gyro->bus, MPU_RA_ACCEL_CONFIG, INV_FSR_16G << 3);
     delay(15);
@@ -144,13 +155,83 @@ void icm20689GyroInit(gyroDev_t *gyro)
 
     delay(15);
 
+#ifdef USE_GYRO_FIFO
+    if (gyro->fifoEnabled) {
+        // Queue gyro samples only, the data ready interrupt would fire at 32KHz
+        spiBusWriteRegister(&gyro->bus, MPU_RA_FIFO_EN, ICM20689_FIFO_EN_GYRO_XYZ);
+        spiBusWriteRegister(&gyro->bus, MPU_RA_USER_CTRL, ICM20689_BIT_I2C_IF_DIS | ICM20689_BIT_FIFO_RST);
+        delay(15);
+        spiBusWriteRegister(&gyro->bus, MPU_RA_USER_CTRL, ICM20689_BIT_I2C_IF_DIS | ICM20689_BIT_FIFO_EN);
+        spiSetDivisor(gyro->bus.busdev_u.spi.instance, SPI_CLOCK_STANDARD);
+        return;
+    }
+#endif
+
 #ifdef USE_MPU_DATA_READY_SIGNAL
     spiBusWriteRegister(&gyro->bus, MPU_RA_INT_ENABLE, 0x01); // RAW_RDY_EN interrupt enable
 #endif
 
     spiSetDivisor(gyro->bus.busdev_u.spi.instance, SPI_CLOCK_STANDARD);
+
+#ifdef USE_GYRO_DMA
+    mpuGyroDmaInit(gyro, MPU_RA_GYRO_XOUT_H);
+#endif
+}
+
+#ifdef USE_GYRO_FIFO
+static bool icm20689GyroReadFifo(gyroDev_t *gyro)
+{
+    uint8_t data[GYRO_FIFO_MAX_SAMPLES * ICM20689_FIFO_FRAME_SIZE];
+
+    gyro->fifoCount = 0;
+
+    if (!spiBusReadRegisterBuffer(&gyro->bus, MPU_RA_FIFO_COUNTH, data, 2)) {
+        return false;
+    }
+
+    const int fifoLength = ((data[0] & 0x1F) << 8) | data[1];
+
+    // Samples may be lost or misaligned after an overflow - start over
+    if (fifoLength >= ICM20689_FIFO_OVERFLOW_SIZE) {
+        spiBusWriteRegister(&gyro->bus, MPU_RA_USER_CTRL, ICM20689_BIT_I2C_IF_DIS | ICM20689_BIT_FIFO_EN | ICM20689_BIT_FIFO_RST);
+        return false;
+    }
+
+    // Any frames beyond the batch size are picked up on the next read
+    const int count = MIN(fifoLength / ICM20689_FIFO_FRAME_SIZE, GYRO_FIFO_MAX_SAMPLES);
+    if (count == 0) {
+        return false;
+    }
+
+    if (!spiBusReadRegisterBuffer(&gyro->bus, MPU_RA_FIFO_R_W, data, count * ICM20689_FIFO_FRAME_SIZE)) {
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const uint8_t *frame = &data[i * ICM20689_FIFO_FRAME_SIZE];
+        gyro->fifoData[i][X] = (int16_t)((frame[0] << 8) | frame[1]);
+        gyro->fifoData[i][Y] = (int16_t)((frame[2] << 8) | frame[3]);
+        gyro->fifoData[i][Z] = (int16_t)((frame[4] << 8) | frame[5]);
+    }
+
+    gyro->gyroADCRaw[X] = gyro->fifoData[count - 1][X];
+    gyro->gyroADCRaw[Y] = gyro->fifoData[count - 1][Y];
+    gyro->gyroADCRaw[Z] = gyro->fifoData[count - 1][Z];
+    gyro->fifoCount = count;
+
+    return true;
 }
 
+static bool icm20689GyroRead(gyroDev_t *gyro)
+{
+    if (gyro->fifoEnabled) {
+        return icm20689GyroReadFifo(gyro);
+    }
+
+    return mpuGyroReadSPI(gyro);
+}
+#endif
+
 bool icm20689SpiGyroDetect(gyroDev_t *gyro)
 {
     switch (gyro->mpuDetectionResult.sensor) {
@@ -164,7 +245,11 @@ bool icm20689SpiGyroDetect(gyroDev_t *gyro)
     }
 
     gyro->initFn = icm20689GyroInit;
+#ifdef USE_GYRO_FIFO
+    gyro->readFn = icm20689GyroRead;
+#else
     gyro->readFn = mpuGyroReadSPI;
+#endif
 
     // 16.4 dps/lsb scalefactor
     gyro->scale = 1.0f / 16.4f;
@@ -24,6 +24,12 @@
 
 #define ICM20689_BIT_RESET                  (0x80)
 
+#define ICM20689_BIT_FIFO_EN                (1 << 6)
+#define ICM20689_BIT_FIFO_RST               (1 << 2)
+#define ICM20689_BIT_I2C_IF_DIS             (1 << 4)
+#define ICM20689_FIFO_EN_GYRO_XYZ           (0x70)
+#define ICM20689_GYRO_FCHOICE_B_32KHZ       (0x02)  // 32KHz sampling, 3281Hz bandwidth
+
 bool icm20689AccDetect(accDev_t *acc);
 bool icm20689GyroDetect(gyroDev_t *gyro);
 
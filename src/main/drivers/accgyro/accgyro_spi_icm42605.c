@@ -89,6 +89,25 @@
 #define ICM42605_UI_DRDY_INT1_EN_DISABLED           (0 << 3)
 #define ICM42605_UI_DRDY_INT1_EN_ENABLED            (1 << 3)
 
+#define ICM42605_RA_FIFO_CONFIG                     0x16
+#define ICM42605_FIFO_MODE_STREAM                   (1 << 6)
+
+#define ICM42605_RA_FIFO_CONFIG1                    0x5F
+#define ICM42605_FIFO_GYRO_EN                       (1 << 1)
+#define ICM42605_FIFO_TEMP_EN                       (1 << 2)
+
+#define ICM42605_RA_SIGNAL_PATH_RESET               0x4B
+#define ICM42605_FIFO_FLUSH                         (1 << 1)
+
+#define ICM42605_RA_FIFO_COUNTH                     0x2E
+#define ICM42605_RA_FIFO_DATA                       0x30
+
+#define ICM42605_FIFO_PACKET_SIZE                   8       // header, gyro XYZ, temperature
+#define ICM42605_FIFO_HEADER_EMPTY                  (1 << 7)
+#define ICM42605_FIFO_OVERFLOW_SIZE                 512     // the FIFO has wrapped or the gyro task stalled
+
+#define ICM42605_GYRO_ODR_32KHZ                     1
+
 static void icm42605SpiInit(const busDevice_t *bus)
 {
     static bool hardwareInitialised = false;
@@ -213,8 +232,15 @@ void icm42605GyroInit(gyroDev_t *gyro)
         gyro->gyroRateKHz = GYRO_RATE_1_kHz;
     }
 
+    uint8_t gyroOutputDataRate = outputDataRate;
+#ifdef USE_GYRO_FIFO
+    if (gyro->fifoEnabled) {
+        gyroOutputDataRate = ICM42605_GYRO_ODR_32KHZ;
+    }
+#endif
+
     STATIC_ASSERT(INV_FSR_2000DPS == 3, "INV_FSR_2000DPS must be 3 to generate correct value");
-    spiBusWriteRegister(&gyro->bus, ICM42605_RA_GYRO_CONFIG0, (3 - INV_FSR_2000DPS) << 5 | (outputDataRate & 0x0F));
+    spiBusWriteRegister(&gyro->bus, ICM42605_RA_GYRO_CONFIG0, (3 - INV_FSR_2000DPS) << 5 | (gyroOutputDataRate & 0x0F));
     delay(15);
 
     STATIC_ASSERT(INV_FSR_16G == 3, "INV_FSR_16G must be 3 to generate correct value");
@@ -226,6 +252,18 @@ void icm42605GyroInit(gyroDev_t *gyro)
     spiBusWriteRegister(&gyro->bus, ICM42605_RA_INT_CONFIG, ICM42605_INT1_MODE_PULSED | ICM42605_INT1_DRIVE_CIRCUIT_PP | ICM42605_INT1_POLARITY_ACTIVE_HIGH);
     spiBusWriteRegister(&gyro->bus, ICM42605_RA_INT_CONFIG0, ICM42605_UI_DRDY_INT_CLEAR_ON_SBR);
 
+#ifdef USE_GYRO_FIFO
+    if (gyro->fifoEnabled) {
+        // Queue gyro samples only, the data ready interrupt would fire at 32KHz
+        spiBusWriteRegister(&gyro->bus, ICM42605_RA_FIFO_CONFIG1, ICM42605_FIFO_GYRO_EN | ICM42605_FIFO_TEMP_EN);
+        spiBusWriteRegister(&gyro->bus, ICM42605_RA_FIFO_CONFIG, ICM42605_FIFO_MODE_STREAM);
+        spiBusWriteRegister(&gyro->bus, ICM42605_RA_SIGNAL_PATH_RESET, ICM42605_FIFO_FLUSH);
+        delay(15);
+        spiSetDivisor(gyro->bus.busdev_u.spi.instance, SPI_CLOCK_STANDARD);
+        return;
+    }
+#endif
+
 #ifdef USE_MPU_DATA_READY_SIGNAL
     spiBusWriteRegister(&gyro->bus, ICM42605_RA_INT_SOURCE0, ICM42605_UI_DRDY_INT1_EN_ENABLED);
 
@@ -239,10 +277,86 @@ void icm42605GyroInit(gyroDev_t *gyro)
     //
 
     spiSetDivisor(gyro->bus.busdev_u.spi.instance, SPI_CLOCK_STANDARD);
+
+#ifdef USE_GYRO_DMA
+    mpuGyroDmaInit(gyro, ICM42605_RA_GYRO_DATA_X1);
+#endif
+}
+
+#ifdef USE_GYRO_FIFO
+static bool icm42605GyroReadFifo(gyroDev_t *gyro)
+{
+    uint8_t data[GYRO_FIFO_MAX_SAMPLES * ICM42605_FIFO_PACKET_SIZE];
+
+    gyro->fifoCount = 0;
+
+    if (!spiBusReadRegisterBuffer(&gyro->bus, ICM42605_RA_FIFO_COUNTH, data, 2)) {
+        return false;
+    }
+
+    const int fifoLength = (data[0] << 8) | data[1];
+
+    // Packets may be lost or misaligned after an overflow - start over
+    if (fifoLength >= ICM42605_FIFO_OVERFLOW_SIZE) {
+        spiBusWriteRegister(&gyro->bus, ICM42605_RA_SIGNAL_PATH_RESET, ICM42605_FIFO_FLUSH);
+        return false;
+    }
+
+    // Any packets beyond the batch size are picked up on the next read
+    const int packets = MIN(fifoLength / ICM42605_FIFO_PACKET_SIZE, GYRO_FIFO_MAX_SAMPLES);
+    if (packets == 0) {
+        return false;
+    }
+
+    if (!spiBusReadRegisterBuffer(&gyro->bus, ICM42605_RA_FIFO_DATA, data, packets * ICM42605_FIFO_PACKET_SIZE)) {
+        return false;
+    }
+
+    int count = 0;
+    for (int i = 0; i < packets; i++) {
+        const uint8_t *packet = &data[i * ICM42605_FIFO_PACKET_SIZE];
+        const int16_t gyroX = (int16_t)((packet[1] << 8) | packet[2]);
+        const int16_t gyroY = (int16_t)((packet[3] << 8) | packet[4]);
+        const int16_t gyroZ = (int16_t)((packet[5] << 8) | packet[6]);
+
+        // Skip empty packets and invalid samples (0x8000)
+        if ((packet[0] & ICM42605_FIFO_HEADER_EMPTY) || (gyroX == INT16_MIN && gyroY == INT16_MIN && gyroZ == INT16_MIN)) {
+            continue;
+        }
+
+        gyro->fifoData[count][X] = gyroX;
+        gyro->fifoData[count][Y] = gyroY;
+        gyro->fifoData[count][Z] = gyroZ;
+        count++;
+    }
+
+    if (count == 0) {
+        return false;
+    }
+
+    gyro->gyroADCRaw[X] = gyro->fifoData[count - 1][X];
+    gyro->gyroADCRaw[Y] = gyro->fifoData[count - 1][Y];
+    gyro->gyroADCRaw[Z] = gyro->fifoData[count - 1][Z];
+    gyro->fifoCount = count;
+
+    return true;
 }
+#endif
 
 bool icm42605GyroReadSPI(gyroDev_t *gyro)
 {
+#ifdef USE_GYRO_FIFO
+    if (gyro->fifoEnabled) {
+        return icm42605GyroReadFifo(gyro);
+    }
+#endif
+
+#ifdef USE_GYRO_DMA
+    if (gyro->dmaEnabled) {
+        return mpuGyroReadDMA(gyro);
+    }
+#endif
+
     static const uint8_t dataToSend[7] = {ICM42605_RA_GYRO_DATA_X1 | 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
     uint8_t data[7];
 
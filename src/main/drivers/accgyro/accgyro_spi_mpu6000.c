@@ -117,6 +117,10 @@ void mpu6000SpiGyroInit(gyroDev_t *gyro)
     if (((int8_t)gyro->gyroADCRaw[1]) == -1 && ((int8_t)gyro->gyroADCRaw[0]) == -1) {
         failureMode(FAILURE_GYRO_INIT_FAILED);
     }
+
+#ifdef USE_GYRO_DMA
+    mpuGyroDmaInit(gyro, MPU_RA_GYRO_XOUT_H);
+#endif
 }
 
 void mpu6000SpiAccInit(accDev_t *acc)
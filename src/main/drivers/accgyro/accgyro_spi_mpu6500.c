@@ -96,6 +96,10 @@ void mpu6500SpiGyroInit(gyroDev_t *gyro)
 
     spiSetDivisor(gyro->bus.busdev_u.spi.instance, SPI_CLOCK_FAST);
     delayMicroseconds(1);
+
+#ifdef USE_GYRO_DMA
+    mpuGyroDmaInit(gyro, MPU_RA_GYRO_XOUT_H);
+#endif
 }
 
 bool mpu6500SpiAccDetect(accDev_t *acc)
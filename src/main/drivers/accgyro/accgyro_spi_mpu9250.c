@@ -90,6 +90,10 @@ void mpu9250SpiGyroInit(gyroDev_t *gyro)
         spiResetErrorCounter(gyro->bus.busdev_u.spi.instance);
         failureMode(FAILURE_GYRO_INIT_FAILED);
     }
+
+#ifdef USE_GYRO_DMA
+    mpuGyroDmaInit(gyro, MPU_RA_GYRO_XOUT_H);
+#endif
 }
 
 void mpu9250SpiAccInit(accDev_t *acc)
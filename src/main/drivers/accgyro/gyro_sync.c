@@ -51,6 +51,9 @@ uint16_t gyroSetSampleRate(gyroDev_t *gyro)
 {
     uint16_t gyroSampleRateHz;
     uint16_t accSampleRateHz;
+#ifdef USE_GYRO_FIFO
+    uint16_t fifoSampleRateHz = 0;
+#endif
 
     switch (gyro->mpuDetectionResult.sensor) {
         case BMI_160_SPI:
@@ -71,6 +74,10 @@ uint16_t gyroSetSampleRate(gyroDev_t *gyro)
                 gyroSampleRateHz = 3200;
             }
             accSampleRateHz = 800;
+#ifdef USE_GYRO_FIFO
+            // unfiltered 6.4KHz samples from the FIFO
+            fifoSampleRateHz = 6400;
+#endif
             break;
         case ICM_20649_SPI:
             gyro->gyroRateKHz = GYRO_RATE_9_kHz;
@@ -84,6 +91,26 @@ uint16_t gyroSetSampleRate(gyroDev_t *gyro)
             break;
     }
 
+#ifdef USE_GYRO_FIFO
+    switch (gyro->mpuDetectionResult.sensor) {
+        case ICM_20601_SPI:
+        case ICM_20602_SPI:
+        case ICM_20608_SPI:
+        case ICM_20689_SPI:
+        case ICM_42605_SPI:
+            // 32KHz samples from the FIFO
+            fifoSampleRateHz = 32000;
+            break;
+        default:
+            break;
+    }
+
+    // In FIFO mode the gyro task keeps running at the register sample rate
+    // and reads all samples queued at the native rate in one burst.
+    gyro->fifoEnabled = gyro->fifoEnabled && (fifoSampleRateHz > gyroSampleRateHz);
+    gyro->fifoSampleRateHz = gyro->fifoEnabled ? fifoSampleRateHz : 0;
+#endif
+
     gyro->mpuDividerDrops  = 0; // we no longer use the gyro's sample divider
     gyro->accSampleRateHz = accSampleRateHz;
     return gyroSampleRateHz;
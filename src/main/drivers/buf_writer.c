@@ -19,9 +19,12 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
 #include "platform.h"
 
+#include "common/maths.h"
+
 #include "buf_writer.h"
 
 bufWriter_t *bufWriterInit(uint8_t *b, int total_size, bufWrite_t writer, void *arg)
@@ -43,6 +46,22 @@ void bufWriterAppend(bufWriter_t *b, uint8_t ch)
     }
 }
 
+void bufWriterAppendData(bufWriter_t *b, const void *data, int count)
+{
+    const uint8_t *p = data;
+
+    while (count > 0) {
+        const int chunk = MIN(count, b->capacity - b->at);
+        memcpy(&b->data[b->at], p, chunk);
+        b->at += chunk;
+        p += chunk;
+        count -= chunk;
+        if (b->at >= b->capacity) {
+            bufWriterFlush(b);
+        }
+    }
+}
+
 void bufWriterFlush(bufWriter_t *b)
 {
     if (b->at != 0) {
@@ -32,6 +32,7 @@
 #include "drivers/exti.h"
 #include "drivers/io.h"
 #include "drivers/rcc.h"
+#include "drivers/time.h"
 
 spiDevice_t spiDevice[SPIDEV_COUNT];
 
@@ -126,6 +127,68 @@ bool spiInit(SPIDevice device, bool leadingEdge)
     return false;
 }
 
+#ifdef USE_SPI_DMA
+// Keep DMA transfers off the bus during a blocking transfer
+static void spiBusLock(const busDevice_t *bus)
+{
+    const SPIDevice device = spiDeviceByInstance(bus->busdev_u.spi.instance);
+
+    if (device != SPIINVALID) {
+        spiDevice_t *spi = &spiDevice[device];
+        const timeUs_t timeoutStartUs = microsISR();
+
+        spi->locked++;
+
+        while (spi->dmaBusy) {
+            if (cmpTimeUs(microsISR(), timeoutStartUs) >= SPI_TIMEOUT_US) {
+                spiTimeoutUserCallback(bus->busdev_u.spi.instance);
+                break;
+            }
+        }
+    }
+}
+
+static void spiBusUnlock(const busDevice_t *bus)
+{
+    const SPIDevice device = spiDeviceByInstance(bus->busdev_u.spi.instance);
+
+    if (device != SPIINVALID && spiDevice[device].locked) {
+        spiDevice[device].locked--;
+    }
+}
+
+/*
+ * Raw transfer users drive their own chip select around several calls.
+ * Remember their chip selects, so that a DMA start is held off for as
+ * long as any of them is asserted, not just during each call.
+ */
+static void spiBusRawLock(const busDevice_t *bus)
+{
+    const SPIDevice device = spiDeviceByInstance(bus->busdev_u.spi.instance);
+
+    if (device != SPIINVALID) {
+        spiDevice_t *spi = &spiDevice[device];
+        const IO_t csnPin = bus->busdev_u.spi.csnPin;
+
+        if (spi->dmaBus && csnPin != spi->dmaBus->busdev_u.spi.csnPin) {
+            bool known = false;
+            for (int i = 0; i < spi->rawCsnCount; i++) {
+                known |= (spi->rawCsnPin[i] == csnPin);
+            }
+            if (!known && spi->rawCsnCount < SPI_RAW_CSN_COUNT) {
+                spi->rawCsnPin[spi->rawCsnCount++] = csnPin;
+            }
+        }
+    }
+
+    spiBusLock(bus);
+}
+#else
+static inline void spiBusLock(const busDevice_t *bus) { UNUSED(bus); }
+static inline void spiBusUnlock(const busDevice_t *bus) { UNUSED(bus); }
+static inline void spiBusRawLock(const busDevice_t *bus) { UNUSED(bus); }
+#endif
+
 uint32_t spiTimeoutUserCallback(SPI_TypeDef *instance)
 {
     SPIDevice device = spiDeviceByInstance(instance);
@@ -138,9 +201,11 @@ uint32_t spiTimeoutUserCallback(SPI_TypeDef *instance)
 
 bool spiBusTransfer(const busDevice_t *bus, const uint8_t *txData, uint8_t *rxData, int length)
 {
+    spiBusLock(bus);
     IOLo(bus->busdev_u.spi.csnPin);
     spiTransfer(bus->busdev_u.spi.instance, txData, rxData, length);
     IOHi(bus->busdev_u.spi.csnPin);
+    spiBusUnlock(bus);
     return true;
 }
 
@@ -168,37 +233,51 @@ bool spiBusIsBusBusy(const busDevice_t *bus)
 
 uint8_t spiBusTransferByte(const busDevice_t *bus, uint8_t data)
 {
-    return spiTransferByte(bus->busdev_u.spi.instance, data);
+    spiBusRawLock(bus);
+    const uint8_t value = spiTransferByte(bus->busdev_u.spi.instance, data);
+    spiBusUnlock(bus);
+
+    return value;
 }
 
 void spiBusWriteByte(const busDevice_t *bus, uint8_t data)
 {
+    spiBusLock(bus);
     IOLo(bus->busdev_u.spi.csnPin);
     spiBusTransferByte(bus, data);
     IOHi(bus->busdev_u.spi.csnPin);
+    spiBusUnlock(bus);
 }
 
 bool spiBusRawTransfer(const busDevice_t *bus, const uint8_t *txData, uint8_t *rxData, int len)
 {
-    return spiTransfer(bus->busdev_u.spi.instance, txData, rxData, len);
+    spiBusRawLock(bus);
+    const bool ack = spiTransfer(bus->busdev_u.spi.instance, txData, rxData, len);
+    spiBusUnlock(bus);
+
+    return ack;
 }
 
 bool spiBusWriteRegister(const busDevice_t *bus, uint8_t reg, uint8_t data)
 {
+    spiBusLock(bus);
     IOLo(bus->busdev_u.spi.csnPin);
     spiTransferByte(bus->busdev_u.spi.instance, reg);
     spiTransferByte(bus->busdev_u.spi.instance, data);
     IOHi(bus->busdev_u.spi.csnPin);
+    spiBusUnlock(bus);
 
     return true;
 }
 
 bool spiBusRawReadRegisterBuffer(const busDevice_t *bus, uint8_t reg, uint8_t *data, uint8_t length)
 {
+    spiBusLock(bus);
     IOLo(bus->busdev_u.spi.csnPin);
     spiTransferByte(bus->busdev_u.spi.instance, reg);
     spiTransfer(bus->busdev_u.spi.instance, NULL, data, length);
     IOHi(bus->busdev_u.spi.csnPin);
+    spiBusUnlock(bus);
 
     return true;
 }
@@ -210,19 +289,23 @@ bool spiBusReadRegisterBuffer(const busDevice_t *bus, uint8_t reg, uint8_t *data
 
 void spiBusWriteRegisterBuffer(const busDevice_t *bus, uint8_t reg, const uint8_t *data, uint8_t length)
 {
+    spiBusLock(bus);
     IOLo(bus->busdev_u.spi.csnPin);
     spiTransferByte(bus->busdev_u.spi.instance, reg);
     spiTransfer(bus->busdev_u.spi.instance, data, NULL, length);
     IOHi(bus->busdev_u.spi.csnPin);
+    spiBusUnlock(bus);
 }
 
 uint8_t spiBusRawReadRegister(const busDevice_t *bus, uint8_t reg)
 {
     uint8_t data;
+    spiBusLock(bus);
     IOLo(bus->busdev_u.spi.csnPin);
     spiTransferByte(bus->busdev_u.spi.instance, reg);
     spiTransfer(bus->busdev_u.spi.instance, NULL, &data, 1);
     IOHi(bus->busdev_u.spi.csnPin);
+    spiBusUnlock(bus);
 
     return data;
 }
@@ -249,6 +332,7 @@ void spiBusSetDivisor(busDevice_t *bus, uint16_t divisor)
 
 void spiBusTransactionBegin(const busDevice_t *bus)
 {
+    spiBusLock(bus);
     spiBusTransactionSetup(bus);
     IOLo(bus->busdev_u.spi.csnPin);
 }
@@ -256,6 +340,7 @@ void spiBusTransactionBegin(const busDevice_t *bus)
 void spiBusTransactionEnd(const busDevice_t *bus)
 {
     IOHi(bus->busdev_u.spi.csnPin);
+    spiBusUnlock(bus);
 }
 
 bool spiBusTransactionTransfer(const busDevice_t *bus, const uint8_t *txData, uint8_t *rxData, int length)
@@ -162,6 +162,14 @@ uint8_t spiBusReadRegister(const busDevice_t *bus, uint8_t reg);
 void spiBusSetInstance(busDevice_t *bus, SPI_TypeDef *instance);
 void spiBusSetDivisor(busDevice_t *bus, SPIClockDivider_e divider);
 
+#ifdef USE_SPI_DMA
+// DMA gyro reads, implemented for the F4 standard peripheral driver only
+typedef void (*spiDmaCallbackFuncPtr)(void *arg);
+
+bool spiBusDmaInit(const busDevice_t *bus, spiDmaCallbackFuncPtr callback, void *arg);
+bool spiBusTransferStart(const busDevice_t *bus, const uint8_t *txData, uint8_t *rxData, int length);
+#endif
+
 void spiBusTransactionInit(busDevice_t *bus, SPIMode_e mode, SPIClockDivider_e divider);
 void spiBusTransactionSetup(const busDevice_t *bus);
 void spiBusTransactionBegin(const busDevice_t *bus);
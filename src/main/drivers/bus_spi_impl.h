@@ -20,8 +20,16 @@
 
 #pragma once
 
+#ifdef USE_SPI_DMA
+#include "drivers/dma.h"
+#endif
+
 #define SPI_TIMEOUT_US  10000
 
+#ifdef USE_SPI_DMA
+#define SPI_RAW_CSN_COUNT   4
+#endif
+
 #if defined(STM32F1) || defined(STM32F3) || defined(STM32F4) || defined(STM32G4)
 #define MAX_SPI_PIN_SEL 2
 #elif defined(STM32F7)
@@ -81,6 +89,17 @@ typedef struct SPIDevice_s {
 #ifdef USE_SPI_TRANSACTION
     uint16_t cr1SoftCopy;   // Copy of active CR1 value for this SPI instance
 #endif
+#ifdef USE_SPI_DMA
+    dmaChannelDescriptor_t *txDma;
+    dmaChannelDescriptor_t *rxDma;
+    const busDevice_t *dmaBus;              // The only device allowed to start DMA transfers
+    spiDmaCallbackFuncPtr dmaCallback;      // Called from the DMA IRQ on completion
+    void *dmaCallbackArg;
+    volatile bool dmaBusy;                  // DMA transfer in progress
+    volatile uint8_t locked;                // Blocking transfers in progress (nesting count)
+    IO_t rawCsnPin[SPI_RAW_CSN_COUNT];      // Chip selects driven by raw transfer users
+    uint8_t rawCsnCount;
+#endif
 } spiDevice_t;
 
 extern spiDevice_t spiDevice[SPIDEV_COUNT];
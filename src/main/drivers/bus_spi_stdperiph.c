@@ -30,11 +30,16 @@
 #include "drivers/bus.h"
 #include "drivers/bus_spi.h"
 #include "drivers/bus_spi_impl.h"
+#include "drivers/dma.h"
+#include "drivers/dma_reqmap.h"
 #include "drivers/exti.h"
 #include "drivers/io.h"
+#include "drivers/nvic.h"
 #include "drivers/rcc.h"
 #include "drivers/time.h"
 
+#include "pg/bus_spi.h"
+
 static SPI_InitTypeDef defaultInit = {
     .SPI_Mode = SPI_Mode_Master,
     .SPI_Direction = SPI_Direction_2Lines_FullDuplex,
@@ -219,6 +224,157 @@ void spiSetDivisor(SPI_TypeDef *instance, uint16_t divisor)
     SPI_Cmd(instance, ENABLE);
 }
 
+#ifdef USE_SPI_DMA
+
+static void spiDmaIrqHandler(dmaChannelDescriptor_t *descriptor)
+{
+    spiDevice_t *spi = &spiDevice[descriptor->userParam];
+
+    if (DMA_GET_FLAG_STATUS(descriptor, DMA_IT_TCIF)) {
+        DMA_CLEAR_FLAG(descriptor, DMA_IT_TCIF);
+
+        // RX completes after the last byte has been clocked out
+        SPI_I2S_DMACmd(spi->dev, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, DISABLE);
+        IOHi(spi->dmaBus->busdev_u.spi.csnPin);
+
+        spi->dmaBusy = false;
+
+        if (spi->dmaCallback) {
+            spi->dmaCallback(spi->dmaCallbackArg);
+        }
+    }
+
+    if (DMA_GET_FLAG_STATUS(descriptor, DMA_IT_TEIF)) {
+        DMA_CLEAR_FLAG(descriptor, DMA_IT_TEIF);
+        xDMA_Cmd(spi->rxDma->ref, DISABLE);
+        xDMA_Cmd(spi->txDma->ref, DISABLE);
+        SPI_I2S_DMACmd(spi->dev, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, DISABLE);
+        IOHi(spi->dmaBus->busdev_u.spi.csnPin);
+        spi->errorCount++;
+        spi->dmaBusy = false;
+    }
+}
+
+static dmaChannelDescriptor_t *spiDmaStreamInit(const dmaChannelSpec_t *dmaSpec, SPIDevice device, resourceOwner_e owner, uint32_t dir)
+{
+    const dmaIdentifier_e identifier = dmaGetIdentifier(dmaSpec->ref);
+
+    dmaInit(identifier, owner, RESOURCE_INDEX(device));
+
+    DMA_InitTypeDef init;
+
+    DMA_StructInit(&init);
+    init.DMA_Channel = dmaSpec->channel;
+    init.DMA_PeripheralBaseAddr = (uint32_t)&spiDevice[device].dev->DR;
+    init.DMA_DIR = dir;
+    init.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    init.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    init.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    init.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    init.DMA_Mode = DMA_Mode_Normal;
+    init.DMA_Priority = DMA_Priority_High;
+
+    xDMA_DeInit(dmaSpec->ref);
+    xDMA_Init(dmaSpec->ref, &init);
+
+    return dmaGetDescriptorByIdentifier(identifier);
+}
+
+/*
+ * Claim the SPI TX and RX DMA streams assigned with the "dma SPI_TX/SPI_RX"
+ * commands for this device. Only one device per bus can use DMA. Blocking
+ * transfers through the busdev API hold off DMA while they run, and raw
+ * transfers hold it off for as long as their chip select is asserted.
+ */
+bool spiBusDmaInit(const busDevice_t *bus, spiDmaCallbackFuncPtr callback, void *arg)
+{
+    const SPIDevice device = spiDeviceByInstance(bus->busdev_u.spi.instance);
+
+    if (device == SPIINVALID) {
+        return false;
+    }
+
+    spiDevice_t *spi = &spiDevice[device];
+
+    if (spi->dmaBus) {
+        return false;
+    }
+
+    const dmaChannelSpec_t *txSpec = dmaGetChannelSpecByPeripheral(DMA_PERIPH_SPI_TX, device, spiPinConfig(device)->txDmaopt);
+    const dmaChannelSpec_t *rxSpec = dmaGetChannelSpecByPeripheral(DMA_PERIPH_SPI_RX, device, spiPinConfig(device)->rxDmaopt);
+
+    if (!txSpec || !rxSpec) {
+        return false;
+    }
+
+    // Check both streams before claiming either, so that a busy
+    // RX stream does not leave the TX stream claimed
+    if (dmaGetOwner(dmaGetIdentifier(txSpec->ref))->owner != OWNER_FREE ||
+        dmaGetOwner(dmaGetIdentifier(rxSpec->ref))->owner != OWNER_FREE) {
+        return false;
+    }
+
+    spi->txDma = spiDmaStreamInit(txSpec, device, OWNER_SPI_MOSI, DMA_DIR_MemoryToPeripheral);
+    spi->rxDma = spiDmaStreamInit(rxSpec, device, OWNER_SPI_MISO, DMA_DIR_PeripheralToMemory);
+
+    spi->dmaBus = bus;
+    spi->dmaCallback = callback;
+    spi->dmaCallbackArg = arg;
+
+    dmaSetHandler(dmaGetIdentifier(spi->rxDma->ref), spiDmaIrqHandler, NVIC_PRIO_SPI_DMA, device);
+
+    xDMA_ITConfig(spi->rxDma->ref, DMA_IT_TC | DMA_IT_TE, ENABLE);
+
+    return true;
+}
+
+/*
+ * Start a full duplex DMA transfer, callable from interrupt context.
+ * Returns false if the bus is in use, in which case nothing is started.
+ */
+FAST_CODE bool spiBusTransferStart(const busDevice_t *bus, const uint8_t *txData, uint8_t *rxData, int length)
+{
+    spiDevice_t *spi = &spiDevice[spiDeviceByInstance(bus->busdev_u.spi.instance)];
+
+    if (spi->dmaBus != bus || spi->locked || spi->dmaBusy) {
+        return false;
+    }
+
+    // A raw transfer user is selected between its calls
+    for (int i = 0; i < spi->rawCsnCount; i++) {
+        if (!IORead(spi->rawCsnPin[i])) {
+            return false;
+        }
+    }
+
+    spi->dmaBusy = true;
+
+    DMA_Stream_TypeDef *txStream = (DMA_Stream_TypeDef *)spi->txDma->ref;
+    DMA_Stream_TypeDef *rxStream = (DMA_Stream_TypeDef *)spi->rxDma->ref;
+
+    // All stream flags must be clear before enabling
+    DMA_CLEAR_FLAG(spi->txDma, DMA_IT_TCIF | DMA_IT_HTIF | DMA_IT_TEIF | DMA_IT_DMEIF | DMA_IT_FEIF);
+    DMA_CLEAR_FLAG(spi->rxDma, DMA_IT_TCIF | DMA_IT_HTIF | DMA_IT_TEIF | DMA_IT_DMEIF | DMA_IT_FEIF);
+
+    txStream->M0AR = (uint32_t)txData;
+    txStream->NDTR = length;
+    rxStream->M0AR = (uint32_t)rxData;
+    rxStream->NDTR = length;
+
+    DISCARD(spi->dev->DR);
+
+    IOLo(bus->busdev_u.spi.csnPin);
+
+    xDMA_Cmd(spi->rxDma->ref, ENABLE);
+    xDMA_Cmd(spi->txDma->ref, ENABLE);
+
+    SPI_I2S_DMACmd(spi->dev, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, ENABLE);
+
+    return true;
+}
+
+#endif // USE_SPI_DMA
+
 #ifdef USE_SPI_TRANSACTION
 
 void spiBusTransactionInit(busDevice_t *bus, SPIMode_e mode, SPIClockDivider_e divider)
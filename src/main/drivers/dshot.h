@@ -66,6 +66,8 @@ extern bool useDshotTelemetry;
 typedef struct dshotTelemetryMotorState_s {
     uint16_t telemetryValue;
     bool telemetryActive;
+    uint8_t validCount;             // Valid packets received (wraps)
+    uint8_t invalidCount;           // Invalid packets received (wraps)
 } dshotTelemetryMotorState_t;
 
 
@@ -476,11 +476,13 @@ static bool bbUpdateStart(void)
             if (value != BB_INVALID) {
                 dshotTelemetryState.motorState[motorIndex].telemetryValue = value;
                 dshotTelemetryState.motorState[motorIndex].telemetryActive = true;
+                dshotTelemetryState.motorState[motorIndex].validCount++;
                 if (motorIndex < 4) {
                     DEBUG_SET(DEBUG_DSHOT_RPM_TELEMETRY, motorIndex, value);
                 }
             } else {
                 dshotTelemetryState.invalidPacketCount++;
+                dshotTelemetryState.motorState[motorIndex].invalidCount++;
             }
 #ifdef USE_DSHOT_TELEMETRY_STATS
             updateDshotTelemetryQuality(&dshotTelemetryQuality[motorIndex], value != BB_INVALID, currentTimeMs);
@@ -234,6 +234,7 @@ FAST_CODE_NOINLINE bool pwmStartDshotMotorUpdate(void)
                 if (value != 0xffff) {
                     dshotTelemetryState.motorState[i].telemetryValue = value;
                     dshotTelemetryState.motorState[i].telemetryActive = true;
+                    dshotTelemetryState.motorState[i].validCount++;
                     if (i < 4) {
                         DEBUG_SET(DEBUG_DSHOT_RPM_TELEMETRY, i, value);
                     }
@@ -242,6 +243,7 @@ FAST_CODE_NOINLINE bool pwmStartDshotMotorUpdate(void)
 #endif
                 } else {
                     dshotTelemetryState.invalidPacketCount++;
+                    dshotTelemetryState.motorState[i].invalidCount++;
                     if (i == 0) {
                         memcpy(dshotTelemetryState.inputBuffer,dmaMotors[i].dmaBuffer,sizeof(dshotTelemetryState.inputBuffer));
                     }
@@ -60,6 +60,7 @@
 
 #include "flight/failsafe.h"
 #include "flight/gps_rescue.h"
+#include "flight/governor.h"
 
 #if defined(USE_GYRO_DATA_ANALYSE)
 #include "flight/gyroanalyse.h"
@@ -122,6 +123,7 @@ enum {
 #define GYRO_WATCHDOG_DELAY 80 //  delay for gyro sync
 
 static FAST_RAM_ZERO_INIT uint8_t pidUpdateCounter;
+static FAST_RAM_ZERO_INIT uint8_t subTaskCounter[PID_SUBTASK_COUNT];
 
 
 static timeUs_t disarmAt;     // Time of automatic disarm when "Don't spin the motors when armed" is enabled and auto_disarm_delay is nonzero
@@ -779,6 +781,15 @@ void subTaskTelemetryPollSensors(timeUs_t currentTimeUs)
 }
 #endif
 
+static FAST_CODE bool subTaskReady(pidSubtask_e task)
+{
+    if (++subTaskCounter[task] >= pidGetSubtaskDenom(task)) {
+        subTaskCounter[task] = 0;
+        return true;
+    }
+    return false;
+}
+
 static FAST_CODE_NOINLINE void subTaskMixerUpdate(timeUs_t currentTimeUs)
 {
     UNUSED(currentTimeUs);
@@ -795,13 +806,25 @@ static FAST_CODE_NOINLINE void subTaskMixerUpdate(timeUs_t currentTimeUs)
         startTime = micros();
     }
 
-    mixerUpdate();
+    // Each output stage runs at its own rate, decimated from the PID loop
+    const bool governorReady = subTaskReady(PID_SUBTASK_GOVERNOR);
+
+    // The governor is updated inside the mixer, after the mixer inputs
+    if (subTaskReady(PID_SUBTASK_MIXER)) {
+        mixerUpdate(governorReady);
+    } else if (governorReady) {
+        governorUpdate();
+    }
 
 #ifdef USE_SERVOS
-    servoUpdate();
+    if (subTaskReady(PID_SUBTASK_SERVO)) {
+        servoUpdate();
+    }
 #endif
 #ifdef USE_MOTOR
-    motorUpdate();
+    if (subTaskReady(PID_SUBTASK_MOTOR)) {
+        motorUpdate();
+    }
 #endif
 
     DEBUG_SET(DEBUG_PIDLOOP, 2, micros() - startTime);
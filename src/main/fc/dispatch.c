@@ -30,9 +30,38 @@
 
 #include "fc/dispatch.h"
 
-static dispatchEntry_t *head = NULL;
+/*
+ * Hierarchical timer wheel
+ *
+ * Level 0 slots are 256us wide, and each higher level is 64 times
+ * coarser, so the three levels reach about 67 seconds ahead. Entries
+ * further out are parked in the farthest top level slot and re-filed
+ * when it comes around. Insert and cancel are O(1). Entries cascade
+ * to a lower level when the wheel reaches their slot. A level 0 slot
+ * is only checked against the exact deadline when the wheel is in it,
+ * so callbacks still fire on the microsecond.
+ */
+
+#define WHEEL_LEVELS        3
+#define WHEEL_SLOT_BITS     6
+#define WHEEL_SLOTS         (1 << WHEEL_SLOT_BITS)
+#define WHEEL_SLOT_MASK     (WHEEL_SLOTS - 1)
+#define WHEEL_TICK_BITS     8
+#define WHEEL_TICK_US       (1 << WHEEL_TICK_BITS)
+
+#define WHEEL_SHIFT(level)  (WHEEL_TICK_BITS + (level) * WHEEL_SLOT_BITS)
+#define WHEEL_RANGE(level)  ((uint32_t)WHEEL_SLOTS << WHEEL_SHIFT(level))
+#define WHEEL_INDEX(time, level) (((time) >> WHEEL_SHIFT(level)) & WHEEL_SLOT_MASK)
+
+static dispatchEntry_t *wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+
+// Start of the level 0 slot being processed
+static uint32_t wheelTime;
+static uint16_t wheelCount;
+
 static bool dispatchEnabled = false;
 
+
 bool dispatchIsEnabled(void)
 {
     return dispatchEnabled;
@@ -43,33 +72,164 @@ void dispatchEnable(void)
     dispatchEnabled = true;
 }
 
-void dispatchProcess(uint32_t currentTime)
+static void wheelLink(dispatchEntry_t **slot, dispatchEntry_t *entry)
+{
+    entry->next = *slot;
+    if (entry->next)
+        entry->next->pprev = &entry->next;
+    entry->pprev = slot;
+    *slot = entry;
+}
+
+static void wheelUnlink(dispatchEntry_t *entry)
+{
+    *entry->pprev = entry->next;
+    if (entry->next)
+        entry->next->pprev = entry->pprev;
+    entry->next = NULL;
+    entry->pprev = NULL;
+}
+
+static void wheelInsert(dispatchEntry_t *entry)
+{
+    int32_t delta = cmp32(entry->delayedUntil, wheelTime);
+    uint32_t slotTime = entry->delayedUntil;
+
+    if (delta < 0) {
+        slotTime = wheelTime;
+        delta = 0;
+    }
+
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+        if ((uint32_t)delta < WHEEL_RANGE(level)) {
+            wheelLink(&wheel[level][WHEEL_INDEX(slotTime, level)], entry);
+            return;
+        }
+    }
+
+    // Beyond the wheel: park in the farthest top level slot
+    slotTime = wheelTime + WHEEL_RANGE(WHEEL_LEVELS - 1) - 1;
+    wheelLink(&wheel[WHEEL_LEVELS - 1][WHEEL_INDEX(slotTime, WHEEL_LEVELS - 1)], entry);
+}
+
+static void wheelCascade(int level)
+{
+    dispatchEntry_t *entry = wheel[level][WHEEL_INDEX(wheelTime, level)];
+    wheel[level][WHEEL_INDEX(wheelTime, level)] = NULL;
+
+    while (entry) {
+        dispatchEntry_t *next = entry->next;
+        wheelInsert(entry);
+        entry = next;
+    }
+}
+
+static void wheelAdvance(void)
+{
+    wheelTime += WHEEL_TICK_US;
+
+    // Refill the lower levels from the top down
+    int level = 0;
+    while (level < WHEEL_LEVELS - 1 && WHEEL_INDEX(wheelTime, level) == 0)
+        level++;
+    for (; level > 0; level--)
+        wheelCascade(level);
+}
+
+static bool processSlot(uint32_t currentTime, uint32_t startTime)
 {
-    for (dispatchEntry_t **p = &head; *p; ) {
-        if (cmp32(currentTime, (*p)->delayedUntil) < 0)
-            break;
+    dispatchEntry_t **slot = &wheel[0][WHEEL_INDEX(wheelTime, 0)];
+
+    // Detach the slot, so that handlers re-adding themselves
+    // end up in the wheel and not in this pass. Handlers may still
+    // cancel entries on the detached list.
+    dispatchEntry_t *pending = *slot;
+    *slot = NULL;
+    if (pending)
+        pending->pprev = &pending;
+
+    while (pending) {
+        dispatchEntry_t *current = pending;
+
+        if (cmp32(currentTime, current->delayedUntil) < 0 ||
+            cmp32(micros(), startTime) >= DISPATCH_TIME_BUDGET_US) {
+            wheelUnlink(current);
+            wheelLink(slot, current);
+            continue;
+        }
+
         // unlink entry first, so handler can replan self
-        dispatchEntry_t *current = *p;
-        *p = (*p)->next;
-        current->inQue = false;
+        wheelUnlink(current);
+
+        if (current->periodUs) {
+            current->delayedUntil += current->periodUs;
+            if (cmp32(current->delayedUntil, currentTime) <= 0)
+                current->delayedUntil = currentTime + current->periodUs;
+            wheelInsert(current);
+        } else {
+            current->inQue = false;
+            wheelCount--;
+        }
+
         (*current->dispatch)(current);
     }
+
+    return *slot == NULL;
 }
 
-void dispatchAdd(dispatchEntry_t *entry, int delayUs)
+void dispatchProcess(timeUs_t currentTimeUs)
 {
-    uint32_t delayedUntil = micros() + delayUs;
-    dispatchEntry_t **p = &head;
+    const uint32_t currentTime = currentTimeUs;
+    const uint32_t startTime = micros();
+
+    if (wheelCount == 0) {
+        wheelTime = currentTime & ~(WHEEL_TICK_US - 1);
+        return;
+    }
+
+    // Walk the wheel up to the current time. A slot still holding
+    // entries, either not yet due or left over budget, stops the walk.
+    while (processSlot(currentTime, startTime) &&
+           cmp32(currentTime, wheelTime + WHEEL_TICK_US) >= 0) {
+        wheelAdvance();
+    }
+}
 
+void dispatchAddPeriodic(dispatchEntry_t *entry, int delayUs, uint32_t periodUs)
+{
     if (entry->inQue) {
       return;    // Allready in Queue, abort
     }
 
-    while (*p && cmp32((*p)->delayedUntil, delayedUntil) < 0)
-        p = &(*p)->next;
+    const uint32_t currentTime = micros();
+
+    // Idle wheel may lag behind, bring it up to date
+    if (wheelCount == 0)
+        wheelTime = currentTime & ~(WHEEL_TICK_US - 1);
 
-    entry->next = *p;
-    entry->delayedUntil = delayedUntil;
+    entry->delayedUntil = currentTime + delayUs;
+    entry->periodUs = periodUs;
     entry->inQue = true;
-    *p = entry;
+    wheelCount++;
+
+    wheelInsert(entry);
+}
+
+void dispatchAdd(dispatchEntry_t *entry, int delayUs)
+{
+    dispatchAddPeriodic(entry, delayUs, 0);
+}
+
+void dispatchCancel(dispatchEntry_t *entry)
+{
+    if (entry->inQue) {
+        wheelUnlink(entry);
+        entry->inQue = false;
+        wheelCount--;
+    }
+}
+
+bool dispatchIsPending(const dispatchEntry_t *entry)
+{
+    return entry->inQue;
 }
@@ -20,6 +20,11 @@
 
 #pragma once
 
+#include "common/time.h"
+
+// Longest time spent in callbacks per dispatchProcess() call
+#define DISPATCH_TIME_BUDGET_US     100
+
 struct dispatchEntry_s;
 typedef void dispatchFunc(struct dispatchEntry_s* self);
 
@@ -28,9 +33,14 @@ typedef struct dispatchEntry_s {
     uint32_t delayedUntil;
     struct dispatchEntry_s *next;
     bool inQue;
+    uint32_t periodUs;                  // re-arm interval, 0 for one-shot
+    struct dispatchEntry_s **pprev;     // link pointing to this entry
 } dispatchEntry_t;
 
 bool dispatchIsEnabled(void);
 void dispatchEnable(void);
-void dispatchProcess(uint32_t currentTime);
+void dispatchProcess(timeUs_t currentTime);
 void dispatchAdd(dispatchEntry_t *entry, int delayUs);
+void dispatchAddPeriodic(dispatchEntry_t *entry, int delayUs, uint32_t periodUs);
+void dispatchCancel(dispatchEntry_t *entry);
+bool dispatchIsPending(const dispatchEntry_t *entry);
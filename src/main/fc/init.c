@@ -97,6 +97,7 @@
 #include "flight/servos.h"
 #include "flight/motors.h"
 #include "flight/rpm_filter.h"
+#include "flight/spectrum.h"
 #include "flight/failsafe.h"
 
 #include "io/asyncfatfs/asyncfatfs.h"
@@ -828,6 +829,10 @@ void init(void)
         governorInit();
     }
 
+#ifdef USE_SPECTRUM_ANALYSER
+    spectrumInit();
+#endif
+
 #ifdef USE_USB_DETECT
     usbCableDetectInit();
 #endif
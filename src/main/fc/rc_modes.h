@@ -65,6 +65,7 @@ typedef enum {
     BOXPIDAUDIO,
     BOXACROTRAINER,
     BOXVTXCONTROLDISABLE,
+    BOXGOVTUNE,
     CHECKBOX_ITEM_COUNT
 } boxId_e;
 
@@ -56,6 +56,7 @@
 #include "flight/imu.h"
 #include "flight/mixer.h"
 #include "flight/pid.h"
+#include "flight/spectrum.h"
 
 #include "io/asyncfatfs/asyncfatfs.h"
 #include "io/beeper.h"
@@ -138,6 +139,17 @@ static void taskHandleSerial(timeUs_t currentTimeUs)
     mspSerialProcess(evaluateMspData, mspFcProcessCommand, mspFcProcessReply);
 }
 
+static void taskMspStream(timeUs_t currentTimeUs)
+{
+#ifdef USE_CLI
+    // the CLI owns the port
+    if (cliMode) {
+        return;
+    }
+#endif
+    mspSerialStream(currentTimeUs, mspFcProcessStreamCommand);
+}
+
 static void taskBatteryAlerts(timeUs_t currentTimeUs)
 {
     if (!ARMING_FLAG(ARMED)) {
@@ -336,6 +348,12 @@ void tasksInit(void)
     setTaskEnabled(TASK_PINIOBOX, true);
 #endif
 
+    setTaskEnabled(TASK_CONFIG_SAVE, true);
+
+#ifdef USE_SPECTRUM_ANALYSER
+    setTaskEnabled(TASK_SPECTRUM, spectrumIsEnabled());
+#endif
+
 #ifdef USE_CMS
 #ifdef USE_MSP_DISPLAYPORT
     setTaskEnabled(TASK_CMS, true);
@@ -382,6 +400,7 @@ task_t tasks[TASK_COUNT] = {
     [TASK_SYSTEM] = DEFINE_TASK("SYSTEM", "LOAD", NULL, taskSystemLoad, TASK_PERIOD_HZ(10), TASK_PRIORITY_MEDIUM_HIGH),
     [TASK_MAIN] = DEFINE_TASK("SYSTEM", "UPDATE", NULL, taskMain, TASK_PERIOD_HZ(1000), TASK_PRIORITY_MEDIUM_HIGH),
     [TASK_SERIAL] = DEFINE_TASK("SERIAL", NULL, NULL, taskHandleSerial, TASK_PERIOD_HZ(100), TASK_PRIORITY_LOW), // 100 Hz should be enough to flush up to 115 bytes @ 115200 baud
+    [TASK_MSP_STREAM] = DEFINE_TASK("MSP_STREAM", NULL, NULL, taskMspStream, TASK_PERIOD_HZ(MSP_STREAM_MAX_RATE * 2), TASK_PRIORITY_LOW),
     [TASK_BATTERY_ALERTS] = DEFINE_TASK("BATTERY_ALERTS", NULL, NULL, taskBatteryAlerts, TASK_PERIOD_HZ(5), TASK_PRIORITY_MEDIUM),
     [TASK_BATTERY_VOLTAGE] = DEFINE_TASK("BATTERY_VOLTAGE", NULL, NULL, batteryUpdateVoltage, TASK_PERIOD_HZ(VOLTAGE_TASK_FREQ_HZ), TASK_PRIORITY_MEDIUM),
     [TASK_BATTERY_CURRENT] = DEFINE_TASK("BATTERY_CURRENT", NULL, NULL, batteryUpdateCurrentMeter, TASK_PERIOD_HZ(CURRENT_TASK_FREQ_HZ), TASK_PRIORITY_MEDIUM),
@@ -464,9 +483,15 @@ task_t tasks[TASK_COUNT] = {
     [TASK_PINIOBOX] = DEFINE_TASK("PINIOBOX", NULL, NULL, pinioBoxUpdate, TASK_PERIOD_HZ(20), TASK_PRIORITY_IDLE),
 #endif
 
+    [TASK_CONFIG_SAVE] = DEFINE_TASK("CONFIGSAVE", NULL, NULL, configSaveUpdate, TASK_PERIOD_HZ(100), TASK_PRIORITY_LOW),
+
 #ifdef USE_RANGEFINDER
     [TASK_RANGEFINDER] = DEFINE_TASK("RANGEFINDER", NULL, NULL, taskUpdateRangefinder, TASK_PERIOD_HZ(10), TASK_PRIORITY_IDLE),
 #endif
+
+#ifdef USE_SPECTRUM_ANALYSER
+    [TASK_SPECTRUM] = DEFINE_TASK("SPECTRUM", NULL, NULL, spectrumUpdate, TASK_PERIOD_HZ(100), TASK_PRIORITY_LOW),
+#endif
 };
 
 task_t *getTask(unsigned taskId)
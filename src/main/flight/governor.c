@@ -35,12 +35,16 @@
 
 #include "fc/runtime_config.h"
 #include "fc/rc_controls.h"
+#include "fc/rc_modes.h"
 
 #include "sensors/battery.h"
 #include "sensors/gyro.h"
 
 #include "rx/rx.h"
 
+#include "blackbox/blackbox.h"
+#include "blackbox/blackbox_fielddefs.h"
+
 #include "flight/governor.h"
 #include "flight/mixer.h"
 #include "flight/pid.h"
@@ -62,8 +66,50 @@
 #define GOV_RPM_INVALID_SPEED           1000
 #define GOV_RPM_INVALID_THROTTLE        0.10f
 
-
-PG_REGISTER_WITH_RESET_TEMPLATE(governorConfig_t, governorConfig, PG_GOVERNOR_CONFIG, 0);
+// Autotune sample period, number of throttle steps, entry conditions and model limits
+#define GOV_AUTOTUNE_SAMPLE_TIME        0.010f
+#define GOV_AUTOTUNE_STEPS              8
+#define GOV_AUTOTUNE_ENTRY_DELAY        1000
+#define GOV_AUTOTUNE_ENTRY_ERROR        0.02f
+#define GOV_AUTOTUNE_TAU_MIN            0.02f
+#define GOV_AUTOTUNE_TAU_MAX            5.0f
+#define GOV_AUTOTUNE_GAIN_MIN           0.1f
+#define GOV_AUTOTUNE_GAIN_MAX           20.0f
+
+// Headspeed estimator: nominal RPM noise, and process noise boost per unit/s of drive & load change
+#define GOV_EST_RPM_NOISE               0.01f
+#define GOV_EST_DRIVE_GAIN              20.0f
+#define GOV_EST_LOAD_GAIN               10.0f
+
+
+typedef struct {
+    float headspeed;        // Estimated headspeed [RPM]
+    float accel;            // Estimated headspeed rate [RPM/s]
+    float P00, P01, P11;    // Estimate covariance
+    float Q;                // Process noise density
+    float R;                // Measurement noise
+    float drive;            // Previous drive
+    float load;             // Previous load
+} govEstimator_t;
+
+typedef struct {
+    bool  done;             // Run complete - switch must be cycled
+    float base;             // Throttle at entry
+    float step;             // Throttle step amplitude
+    long  period;           // Step length [ms]
+    int   decim;            // Governor cycles per sample
+    int   count;            // Governor cycles accumulated
+    float ysum;             // Headspeed accumulator
+    float usum;             // Throttle accumulator
+    float y;                // Previous headspeed sample
+    float u;                // Previous throttle sample
+    bool  primed;           // Previous sample valid
+    float theta[3];         // Model y[k+1] = a·y[k] + b·u[k] + c
+    float P[3][3];          // RLS covariance
+} govAutotune_t;
+
+
+PG_REGISTER_WITH_RESET_TEMPLATE(governorConfig_t, governorConfig, PG_GOVERNOR_CONFIG, 2);
 
 PG_RESET_TEMPLATE(governorConfig_t, governorConfig,
     .gov_mode = GM_PASSTHROUGH,
@@ -88,12 +134,17 @@ PG_RESET_TEMPLATE(governorConfig_t, governorConfig,
     .gov_collective_ff_weight = 100,
     .gov_ff_exponent = 150,
     .gov_vbat_offset = 0,
+    .gov_autotune_step = 5,
+    .gov_autotune_period = 10,
+    .gov_autotune_bandwidth = 100,
+    .gov_tail_ratio = 0,
 );
 
 
 static FAST_RAM_ZERO_INIT uint8_t govMode;
 
 static FAST_RAM_ZERO_INIT uint8_t govState;
+static FAST_RAM_ZERO_INIT float   govDT;
 static FAST_RAM_ZERO_INIT timeMs_t govStateEntryTime;
 
 static FAST_RAM_ZERO_INIT float govGearRatio;
@@ -112,10 +163,14 @@ static FAST_RAM_ZERO_INIT biquadFilter_t govCurrentFilter;
 
 static FAST_RAM_ZERO_INIT float govMotorRPM;
 static FAST_RAM_ZERO_INIT uint32_t govMotorRPMGood;
-static FAST_RAM_ZERO_INIT biquadFilter_t govMotorRPMFilter;
+static FAST_RAM_ZERO_INIT govEstimator_t govEstimator;
+
+static FAST_RAM_ZERO_INIT govAutotune_t govTune;
 
 static FAST_RAM_ZERO_INIT float govSetpoint;
+static FAST_RAM_ZERO_INIT float govPrevSetpoint;
 static FAST_RAM_ZERO_INIT float govHeadSpeed;
+static FAST_RAM_ZERO_INIT float govHeadSpeedAccel;
 static FAST_RAM_ZERO_INIT float govMaxHeadSpeed;
 static FAST_RAM_ZERO_INIT float govTargetHeadSpeed;
 
@@ -174,6 +229,11 @@ static float govPIDControl(void);
 static float govMode1Control(void);
 static float govMode2Control(void);
 
+static void govAutotuneInit(void);
+static bool govAutotuneReady(void);
+static float govAutotuneControl(void);
+static void govAutotuneFinish(void);
+
 static void governorUpdateState(void);
 static void governorUpdatePassthrough(void);
 
@@ -200,6 +260,11 @@ float getHeadSpeed(void)
     return govHeadSpeed;
 }
 
+float getHeadSpeedAccel(void)
+{
+    return govHeadSpeedAccel;
+}
+
 float getHeadSpeedRatio(void)
 {
     return govHeadSpeed / govMaxHeadSpeed;
@@ -224,6 +289,7 @@ bool isSpooledUp(void)
         case GS_LOST_HEADSPEED:
         case GS_AUTOROTATION:
         case GS_AUTOROTATION_BAILOUT:
+        case GS_AUTOTUNE:
             return true;
 
         case GS_THROTTLE_OFF:
@@ -286,6 +352,64 @@ static void govDebugStats(void)
     DEBUG_SET(DEBUG_GOVERNOR,  3, govFeedForward * 1000);
 }
 
+/*
+ * Headspeed estimator
+ *
+ * Kalman filter with state [headspeed, headspeed rate], run at PID rate on the
+ * motor RPM. The process noise is set for a filter bandwidth of gov_rpm_filter,
+ * and it is raised when the drive (throttle × battery voltage) or the rotor
+ * load (collective & cyclic) changes, so that the estimate follows real
+ * headspeed changes immediately while staying quiet in steady state.
+ */
+
+static void govEstimatorInit(govEstimator_t *est, float bandwidth)
+{
+    memset(est, 0, sizeof(govEstimator_t));
+
+    // Measurement noise is nominal; only the Q/R ratio matters
+    est->R = sq(GOV_EST_RPM_NOISE * govMaxHeadSpeed);
+
+    // Steady state bandwidth ωn = (Q/R)^¼
+    est->Q = est->R * powf(2 * M_PIf * bandwidth, 4);
+}
+
+static void govEstimatorUpdate(govEstimator_t *est, float headspeed, float drive, float load)
+{
+    const float dT = govDT;
+
+    // Changes in drive or load predict headspeed acceleration
+    const float gain = 1 + (GOV_EST_DRIVE_GAIN * fabsf(drive - est->drive) +
+                            GOV_EST_LOAD_GAIN * fabsf(load - est->load)) / dT;
+
+    est->drive = drive;
+    est->load = load;
+
+    // Predict
+    est->headspeed += est->accel * dT;
+
+    est->P00 += dT * (2 * est->P01 + dT * est->P11) + est->Q * gain * dT * dT * dT / 3;
+    est->P01 += dT * est->P11 + est->Q * gain * dT * dT / 2;
+    est->P11 += est->Q * gain * dT;
+
+    // Correct
+    const float S = est->P00 + est->R;
+    const float K0 = est->P00 / S;
+    const float K1 = est->P01 / S;
+    const float Y = headspeed - est->headspeed;
+
+    est->headspeed += K0 * Y;
+    est->accel += K1 * Y;
+
+    est->P11 -= K1 * est->P01;
+    est->P01 -= K0 * est->P01;
+    est->P00 -= K0 * est->P00;
+
+    DEBUG_SET(DEBUG_HEADSPEED, 0, headspeed);
+    DEBUG_SET(DEBUG_HEADSPEED, 1, est->headspeed);
+    DEBUG_SET(DEBUG_HEADSPEED, 2, constrain(lrintf(est->accel * 10), INT16_MIN, INT16_MAX));
+    DEBUG_SET(DEBUG_HEADSPEED, 3, drive * 1000);
+}
+
 static void govUpdateInputs(void)
 {
     // Update throttle state
@@ -295,11 +419,32 @@ static void govUpdateInputs(void)
     // Update headspeed target
     govTargetHeadSpeed = govThrottle * govMaxHeadSpeed;
 
+    // Battery state - zero when battery unplugged
+    govNominalVoltage = getBatteryCellCount() * 3.70f;
+
+    // Voltage & current filters
+    govVoltage = biquadFilterApply(&govVoltageFilter, getBatteryVoltageLatest() * 0.01f);
+    govCurrent = biquadFilterApply(&govCurrentFilter, getAmperageLatest() * 0.01f);
+
+    // Calculate feedforward from collective deflection
+    govCollectiveFF = govColWeight * getCollectiveDeflectionAbs();
+
+    // Calculate feedforward from cyclic deflection
+    govCyclicFF = govCycWeight * getCyclicDeflection();
+
     // Assume motor[0]
     govMotorRPM = getMotorRawRPMf(0);
 
-    // RPM signal is noisy - filtering is required
-    float filteredRPM = biquadFilterApply(&govMotorRPMFilter, govMotorRPM);
+    // Motor drive relative to nominal battery voltage
+    float govDrive = (govNominalVoltage > 0) ?
+        govOutput * govVoltage / govNominalVoltage : govOutput;
+
+    // RPM signal is noisy - estimate headspeed. Fused RPM is already clean.
+    govEstimatorUpdate(&govEstimator,
+        (isRpmFusionActive() ? getMotorRPMf(0) : govMotorRPM) / govGearRatio,
+        govDrive, govCollectiveFF + govCyclicFF);
+
+    float filteredRPM = govEstimator.headspeed * govGearRatio;
 
     // Evaluate RPM signal quality
     if (govMotorRPM > 0 && filteredRPM > GOV_RPM_DETECT_SPEED) {
@@ -318,21 +463,9 @@ static void govUpdateInputs(void)
     // Headspeed should be available if throttle is high enough
     govHeadSpeedError = (govMotorRPM < GOV_RPM_INVALID_SPEED && govOutput > GOV_RPM_INVALID_THROTTLE);
 
-    // Calculate headspeed from filtered motor speed
-    govHeadSpeed = filteredRPM / govGearRatio;
-
-    // Battery state - zero when battery unplugged
-    govNominalVoltage = getBatteryCellCount() * 3.70f;
-
-    // Voltage & current filters
-    govVoltage = biquadFilterApply(&govVoltageFilter, getBatteryVoltageLatest() * 0.01f);
-    govCurrent = biquadFilterApply(&govCurrentFilter, getAmperageLatest() * 0.01f);
-
-    // Calculate feedforward from collective deflection
-    govCollectiveFF = govColWeight * getCollectiveDeflectionAbs();
-
-    // Calculate feedforward from cyclic deflection
-    govCyclicFF = govCycWeight * getCyclicDeflection();
+    // Estimated headspeed and its rate of change
+    govHeadSpeed = fmaxf(govEstimator.headspeed, 0);
+    govHeadSpeedAccel = govEstimator.accel;
 
     // Angle-of-attack vs. FeedForward curve
     govFeedForward = powf(govCollectiveFF + govCyclicFF, govFFexponent);
@@ -340,14 +473,18 @@ static void govUpdateInputs(void)
     // Normalized RPM error
     float newError = (govSetpoint - govHeadSpeed) / govMaxHeadSpeed;
 
+    // Error derivative from the setpoint ramp and the estimated headspeed rate
+    float errorRate = ((govSetpoint - govPrevSetpoint) / govDT - govHeadSpeedAccel) / govMaxHeadSpeed;
+
     // Update PIDF terms
     govP = govK * govKp * newError;
-    govC = govK * govKi * newError * pidGetDT();
-    govD = govK * govKd * (newError - govError) / pidGetDT();
+    govC = govK * govKi * newError * govDT;
+    govD = govK * govKd * errorRate;
     govF = govK * govKf * govFeedForward;
 
     // Update error term
     govError = newError;
+    govPrevSetpoint = govSetpoint;
 }
 
 
@@ -495,6 +632,12 @@ static inline void govEnterActiveState(uint8_t state)
     govActiveInit();
 }
 
+static inline void govEnterAutotuneState(uint8_t state)
+{
+    govChangeState(state);
+    govAutotuneInit();
+}
+
 static void governorUpdateState(void)
 {
     float govPrev = govOutput;
@@ -565,12 +708,41 @@ static void governorUpdateState(void)
                         govChangeState(GS_AUTOROTATION);
                     else
                         govChangeState(GS_THROTTLE_IDLE);
-                } else {
+                }
+                else if (govAutotuneReady())
+                    govEnterAutotuneState(GS_AUTOTUNE);
+                else {
                     govMain = govActiveCalc();
                     govSetpoint = rampLimit(govTargetHeadSpeed, govSetpoint, govSetpointTrackingRate);
                 }
                 break;
 
+            // Identify the rotor/ESC response with throttle steps
+            //  -- If NO throttle, move to LOST_THROTTLE
+            //  -- If no headspeed signal, move to LOST_HEADSPEED
+            //  -- If throttle <20%, move to IDLE
+            //  -- If autotune switched off, move back to ACTIVE
+            //  -- Once all steps done, apply the gains and move to ACTIVE
+            case GS_AUTOTUNE:
+                govMain = govPrev;
+                if (govThrottleLow)
+                    govChangeState(GS_LOST_THROTTLE);
+                else if (govHeadSpeedError)
+                    govChangeState(GS_LOST_HEADSPEED);
+                else if (govThrottle < GOV_THROTTLE_IDLE_LIMIT)
+                    govChangeState(GS_THROTTLE_IDLE);
+                else if (!IS_RC_MODE_ACTIVE(BOXGOVTUNE))
+                    govEnterActiveState(GS_ACTIVE);
+                else if (govStateTime() >= govTune.period * GOV_AUTOTUNE_STEPS) {
+                    govAutotuneFinish();
+                    govEnterActiveState(GS_ACTIVE);
+                }
+                else {
+                    govMain = govAutotuneControl();
+                    govSetpoint = rampLimit(govTargetHeadSpeed, govSetpoint, govSetpointTrackingRate);
+                }
+                break;
+
             // Throttle is off or low. If it is a mistake, give a chance to recover
             //  -- When throttle and *headspeed* returns, move to RECOVERY
             //  -- When timer expires, move to OFF
@@ -677,6 +849,149 @@ static void governorUpdateState(void)
 }
 
 
+/*
+ * Autotune
+ *
+ * While hovering in ACTIVE with the GOVERNOR AUTOTUNE mode on, the throttle
+ * is stepped up and down around the hover throttle. A first order model
+ *
+ *    y[k+1] = a·y[k] + b·u[k] + c
+ *
+ * of the normalized headspeed y against throttle u is fitted with recursive
+ * least squares, at a reduced sample rate. The time constant and gain of the
+ * rotor + ESC follow from a and b, and the PI gains are derived by pole-zero
+ * cancellation for a closed loop gov_autotune_bandwidth % of open loop speed.
+ */
+
+static bool govAutotuneReady(void)
+{
+    return IS_RC_MODE_ACTIVE(BOXGOVTUNE) && !govTune.done &&
+        govStateTime() > GOV_AUTOTUNE_ENTRY_DELAY &&
+        fabsf(govError) < GOV_AUTOTUNE_ENTRY_ERROR;
+}
+
+static void govAutotuneInit(void)
+{
+    memset(&govTune, 0, sizeof(govTune));
+
+    govTune.base   = govOutput;
+    govTune.step   = governorConfig()->gov_autotune_step / 100.0f;
+    govTune.period = governorConfig()->gov_autotune_period * 100;
+    govTune.decim  = MAX(lrintf(GOV_AUTOTUNE_SAMPLE_TIME / govDT), 1);
+
+    for (int i = 0; i < 3; i++)
+        govTune.P[i][i] = 1000;
+}
+
+static void govAutotuneUpdate(float y)
+{
+    const float phi[3] = { govTune.y, govTune.u, 1 };
+    float Pphi[3], K[3];
+    float den = 1, est = 0;
+
+    for (int i = 0; i < 3; i++) {
+        Pphi[i] = 0;
+        for (int j = 0; j < 3; j++)
+            Pphi[i] += govTune.P[i][j] * phi[j];
+        den += phi[i] * Pphi[i];
+        est += govTune.theta[i] * phi[i];
+    }
+
+    for (int i = 0; i < 3; i++) {
+        K[i] = Pphi[i] / den;
+        govTune.theta[i] += K[i] * (y - est);
+    }
+
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            govTune.P[i][j] -= K[i] * Pphi[j];
+}
+
+static float govAutotuneControl(void)
+{
+    // Collect the response to the throttle applied in the previous cycle
+    govTune.ysum += govHeadSpeed / govMaxHeadSpeed;
+    govTune.usum += govOutput;
+
+    if (++govTune.count >= govTune.decim) {
+        const float y = govTune.ysum / govTune.count;
+        const float u = govTune.usum / govTune.count;
+
+        if (govTune.primed)
+            govAutotuneUpdate(y);
+
+        govTune.y = y;
+        govTune.u = u;
+        govTune.primed = true;
+
+        govTune.ysum = 0;
+        govTune.usum = 0;
+        govTune.count = 0;
+    }
+
+    // Square wave around the hover throttle
+    const int step = govStateTime() / govTune.period;
+    const float output = govTune.base + ((step & 1) ? -govTune.step : govTune.step);
+
+    return constrainf(output, GOV_MIN_THROTTLE_OUTPUT, 1);
+}
+
+static void govAutotuneFinish(void)
+{
+    const float Ts = govTune.decim * govDT;
+    const float a = govTune.theta[0];
+    const float b = govTune.theta[1];
+
+    bool success = false;
+    float tau = 0, gain = 0;
+    uint16_t pGain = governorConfig()->gov_p_gain;
+    uint16_t iGain = governorConfig()->gov_i_gain;
+
+    govTune.done = true;
+
+    if (a > 0 && a < 1 && b > 0 && govK > 0) {
+        tau  = -Ts / logf(a);
+        gain = b / (1 - a);
+
+        if (tau > GOV_AUTOTUNE_TAU_MIN && tau < GOV_AUTOTUNE_TAU_MAX &&
+            gain > GOV_AUTOTUNE_GAIN_MIN && gain < GOV_AUTOTUNE_GAIN_MAX) {
+
+            // Desired closed loop time constant
+            const float lambda = tau * 100 / governorConfig()->gov_autotune_bandwidth;
+
+            // PI zero cancels the plant pole
+            const float Kp = tau / (gain * lambda);
+            const float Ki = 1 / (gain * lambda);
+
+            pGain = constrain(lrintf(Kp / govK * 10), 0, 500);
+            iGain = constrain(lrintf(Ki / govK * 10), 0, 500);
+
+            governorConfigMutable()->gov_p_gain = pGain;
+            governorConfigMutable()->gov_i_gain = iGain;
+
+            govKp = pGain / 10.0f;
+            govKi = iGain / 10.0f;
+
+            success = true;
+        }
+    }
+
+#ifdef USE_BLACKBOX
+    if (blackboxConfig()->device) {
+        flightLogEvent_govTune_t eventData;
+        eventData.success = success;
+        eventData.tau = constrain(lrintf(tau * 1000), 0, UINT16_MAX);
+        eventData.gain = constrain(lrintf(gain * 1000), 0, UINT16_MAX);
+        eventData.pGain = pGain;
+        eventData.iGain = iGain;
+        blackboxLogEvent(FLIGHT_LOG_EVENT_GOVTUNE, (flightLogEventData_t *)&eventData);
+    }
+#else
+    UNUSED(success);
+#endif
+}
+
+
 /*
  * Standard PID controller
  */
@@ -809,6 +1124,10 @@ static float govMode2Control(void)
 
 void governorUpdate(void)
 {
+    // Autotune runs once per switch activation
+    if (!IS_RC_MODE_ACTIVE(BOXGOVTUNE))
+        govTune.done = false;
+
     // Governor is active
     if (govMode)
     {
@@ -828,6 +1147,7 @@ void governorInit(void)
     {
         govMode         = governorConfig()->gov_mode;
         govState        = GS_THROTTLE_OFF;
+        govDT           = pidGetSubtaskDT(PID_SUBTASK_GOVERNOR);
 
         // Mode specific handler functions
         switch (govMode) {
@@ -879,10 +1199,10 @@ void governorInit(void)
         govAutoTimeout  = governorConfig()->gov_autorotation_timeout * 100;
         govAutoMinEntry = governorConfig()->gov_autorotation_min_entry_time * 1000;
 
-        govThrottleSpoolupRate  = pidGetDT() / constrainf(governorConfig()->gov_spoolup_time, 1, 600) * 10;
-        govThrottleTrackingRate = pidGetDT() / constrainf(governorConfig()->gov_tracking_time, 1, 50) * 10;
-        govThrottleRecoveryRate = pidGetDT() / constrainf(governorConfig()->gov_recovery_time, 1, 50) * 10;
-        govThrottleBailoutRate  = pidGetDT() / constrainf(governorConfig()->gov_autorotation_bailout_time, 1, 100) * 10;
+        govThrottleSpoolupRate  = govDT / constrainf(governorConfig()->gov_spoolup_time, 1, 600) * 10;
+        govThrottleTrackingRate = govDT / constrainf(governorConfig()->gov_tracking_time, 1, 50) * 10;
+        govThrottleRecoveryRate = govDT / constrainf(governorConfig()->gov_recovery_time, 1, 50) * 10;
+        govThrottleBailoutRate  = govDT / constrainf(governorConfig()->gov_autorotation_bailout_time, 1, 100) * 10;
 
         govSetpointSpoolupRate  = govThrottleSpoolupRate  * govMaxHeadSpeed;
         govSetpointTrackingRate = govThrottleTrackingRate * govMaxHeadSpeed;
@@ -892,9 +1212,9 @@ void governorInit(void)
         govLostThrottleTimeout  = governorConfig()->gov_lost_throttle_timeout * 100;
         govLostHeadspeedTimeout = governorConfig()->gov_lost_headspeed_timeout * 100;
 
-        biquadFilterInitBessel(&govVoltageFilter, governorConfig()->gov_pwr_filter, pidGetLooptime());
-        biquadFilterInitBessel(&govCurrentFilter, governorConfig()->gov_pwr_filter, pidGetLooptime());
-        biquadFilterInitBessel(&govMotorRPMFilter, governorConfig()->gov_rpm_filter, pidGetLooptime());
+        biquadFilterInitBessel(&govVoltageFilter, governorConfig()->gov_pwr_filter, pidGetSubtaskLooptime(PID_SUBTASK_GOVERNOR));
+        biquadFilterInitBessel(&govCurrentFilter, governorConfig()->gov_pwr_filter, pidGetSubtaskLooptime(PID_SUBTASK_GOVERNOR));
+        govEstimatorInit(&govEstimator, constrainf(governorConfig()->gov_rpm_filter, 1, 1000));
     }
 }
 
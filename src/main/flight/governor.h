@@ -40,6 +40,7 @@ typedef enum {
     GS_LOST_HEADSPEED,
     GS_AUTOROTATION,
     GS_AUTOROTATION_BAILOUT,
+    GS_AUTOTUNE,
 } govState_e;
 
 typedef struct governorConfig_s {
@@ -65,6 +66,10 @@ typedef struct governorConfig_s {
     uint16_t gov_collective_ff_weight;
     uint16_t gov_ff_exponent;
     uint16_t gov_vbat_offset;
+    uint8_t  gov_autotune_step;
+    uint8_t  gov_autotune_period;
+    uint8_t  gov_autotune_bandwidth;
+    uint16_t gov_tail_ratio;            // Tail rotor to main rotor speed ratio * 1000, 0 = unknown
 } governorConfig_t;
 
 PG_DECLARE(governorConfig_t, governorConfig);
@@ -78,6 +83,7 @@ uint8_t getGovernorState();
 float getGovernorOutput(void);
 
 float getHeadSpeed(void);
+float getHeadSpeedAccel(void);
 float getHeadSpeedRatio(void);
 
 bool isSpooledUp(void);
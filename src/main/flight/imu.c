@@ -23,6 +23,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <math.h>
+#include <string.h>
 
 #include "platform.h"
 
@@ -85,6 +86,19 @@ static bool imuUpdated = false;
 #define ATTITUDE_RESET_ACTIVE_TIME 500000  // 500ms - Time to wait for attitude to converge at high gain
 #define GPS_COG_MIN_GROUNDSPEED 500        // 500cm/s minimum groundspeed for a gps heading to be considered valid
 
+#define IMU_EKF_STATES             6       // attitude error and gyro bias
+#define IMU_EKF_GYRO_NOISE         0.005f  // gyro noise [rad/s/sqrt(Hz)]
+#define IMU_EKF_GYRO_SCALE_NOISE   0.01f   // gyro scale uncertainty, grows the noise with rotation rate
+#define IMU_EKF_BIAS_NOISE         0.0001f // gyro bias random walk [rad/s/sqrt(s)]
+#define IMU_EKF_BIAS_LIMIT         0.1f    // [rad/s]
+#define IMU_EKF_ATTITUDE_INIT      0.5f    // initial attitude uncertainty [rad]
+#define IMU_EKF_BIAS_INIT          0.02f   // initial gyro bias uncertainty [rad/s]
+#define IMU_EKF_ACC_NORM_GAIN      1.0f    // noise added per g of deviation from 1g
+#define IMU_EKF_MAG_NOISE          0.1f    // [rad]
+#define IMU_EKF_COG_NOISE          0.2f    // [rad]
+#define IMU_EKF_GATE               9.0f    // innovation gate (3 sigma squared)
+#define GRAVITY_CMSS               980.665f
+
 int32_t accSum[XYZ_AXIS_COUNT];
 float accAverage[XYZ_AXIS_COUNT];
 
@@ -107,11 +121,23 @@ STATIC_UNIT_TESTED quaternionProducts qP = QUATERNION_PRODUCTS_INITIALIZE;
 // absolute angle inclination in multiple of 0.1 degree    180 deg = 1800
 attitudeEulerAngles_t attitude = EULER_INITIALIZE;
 
-PG_REGISTER_WITH_RESET_TEMPLATE(imuConfig_t, imuConfig, PG_IMU_CONFIG, 1);
+// Error-state EKF: attitude error in body frame and gyro bias
+typedef struct imuEkf_s {
+    float P[IMU_EKF_STATES][IMU_EKF_STATES];
+    float bias[XYZ_AXIS_COUNT];
+    bool initialized;
+} imuEkf_t;
+
+static imuEkf_t ekf;
+
+PG_REGISTER_WITH_RESET_TEMPLATE(imuConfig_t, imuConfig, PG_IMU_CONFIG, 2);
 
 PG_RESET_TEMPLATE(imuConfig_t, imuConfig,
     .dcm_kp = 2500,                // 1.0 * 10000
     .dcm_ki = 0,                   // 0.003 * 10000
+    .imu_mode = IMU_MODE_MAHONY,
+    .ekf_acc_noise = 50,
+    .ekf_gps_comp = true,
 );
 
 static void imuQuaternionComputeProducts(quaternion *quat, quaternionProducts *quatProd)
@@ -162,6 +188,12 @@ void imuConfigure(void)
     imuRuntimeConfig.dcm_kp = imuConfig()->dcm_kp / 10000.0f;
     imuRuntimeConfig.dcm_ki = imuConfig()->dcm_ki / 10000.0f;
 
+    imuRuntimeConfig.imu_mode = imuConfig()->imu_mode;
+    imuRuntimeConfig.ekf_acc_variance = sq(imuConfig()->ekf_acc_noise / 1000.0f);
+    imuRuntimeConfig.ekf_gps_comp = imuConfig()->ekf_gps_comp;
+
+    ekf.initialized = false;
+
     fc_acc = calculateAccZLowPassFilterRCTimeConstant(5.0f); // Set to fix value
 }
 
@@ -197,6 +229,35 @@ static float invSqrt(float x)
     return 1.0f / sqrtf(x);
 }
 
+// Rotate the attitude by a small body frame rotation vector [rad]
+static void imuRotateQuaternion(float rx, float ry, float rz)
+{
+    rx *= 0.5f;
+    ry *= 0.5f;
+    rz *= 0.5f;
+
+    quaternion buffer;
+    buffer.w = q.w;
+    buffer.x = q.x;
+    buffer.y = q.y;
+    buffer.z = q.z;
+
+    q.w += (-buffer.x * rx - buffer.y * ry - buffer.z * rz);
+    q.x += (+buffer.w * rx + buffer.y * rz - buffer.z * ry);
+    q.y += (+buffer.w * ry - buffer.x * rz + buffer.z * rx);
+    q.z += (+buffer.w * rz + buffer.x * ry - buffer.y * rx);
+
+    // Normalise quaternion
+    float recipNorm = invSqrt(sq(q.w) + sq(q.x) + sq(q.y) + sq(q.z));
+    q.w *= recipNorm;
+    q.x *= recipNorm;
+    q.y *= recipNorm;
+    q.z *= recipNorm;
+
+    // Pre-compute rotation matrix from quaternion
+    imuComputeRotationMatrix();
+}
+
 static void imuMahonyAHRSupdate(float dt, float gx, float gy, float gz,
                                 bool useAcc, float ax, float ay, float az,
                                 bool useMag,
@@ -295,34 +356,224 @@ static void imuMahonyAHRSupdate(float dt, float gx, float gy, float gz,
     gz += dcmKpGain * ez + integralFBz;
 
     // Integrate rate of change of quaternion
-    gx *= (0.5f * dt);
-    gy *= (0.5f * dt);
-    gz *= (0.5f * dt);
+    imuRotateQuaternion(gx * dt, gy * dt, gz * dt);
 
-    quaternion buffer;
-    buffer.w = q.w;
-    buffer.x = q.x;
-    buffer.y = q.y;
-    buffer.z = q.z;
+    attitudeIsEstablished = true;
+}
 
-    q.w += (-buffer.x * gx - buffer.y * gy - buffer.z * gz);
-    q.x += (+buffer.w * gx + buffer.y * gz - buffer.z * gy);
-    q.y += (+buffer.w * gy - buffer.x * gz + buffer.z * gx);
-    q.z += (+buffer.w * gz + buffer.x * gy - buffer.y * gx);
+static void imuEkfReset(void)
+{
+    memset(&ekf, 0, sizeof(ekf));
 
-    // Normalise quaternion
-    float recipNorm = invSqrt(sq(q.w) + sq(q.x) + sq(q.y) + sq(q.z));
-    q.w *= recipNorm;
-    q.x *= recipNorm;
-    q.y *= recipNorm;
-    q.z *= recipNorm;
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        ekf.P[axis][axis] = sq(IMU_EKF_ATTITUDE_INIT);
+        ekf.P[axis + 3][axis + 3] = sq(IMU_EKF_BIAS_INIT);
+    }
 
-    // Pre-compute rotation matrix from quaternion
-    imuComputeRotationMatrix();
+    ekf.initialized = true;
+}
+
+// Covariance propagation P = F P F' + Q with
+//   F = | I - [w]x dt  -I dt |
+//       |      0         I   |
+static void imuEkfPredict(float dt, float gx, float gy, float gz)
+{
+    float F[IMU_EKF_STATES][IMU_EKF_STATES] = { { 0 } };
+    float FP[IMU_EKF_STATES][IMU_EKF_STATES];
+
+    for (int i = 0; i < IMU_EKF_STATES; i++) {
+        F[i][i] = 1.0f;
+    }
+    for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
+        F[i][i + 3] = -dt;
+    }
+
+    F[0][1] =  gz * dt;
+    F[0][2] = -gy * dt;
+    F[1][0] = -gz * dt;
+    F[1][2] =  gx * dt;
+    F[2][0] =  gy * dt;
+    F[2][1] = -gx * dt;
+
+    for (int i = 0; i < IMU_EKF_STATES; i++) {
+        for (int j = 0; j < IMU_EKF_STATES; j++) {
+            float sum = 0;
+            for (int k = 0; k < IMU_EKF_STATES; k++) {
+                sum += F[i][k] * ekf.P[k][j];
+            }
+            FP[i][j] = sum;
+        }
+    }
+
+    for (int i = 0; i < IMU_EKF_STATES; i++) {
+        for (int j = i; j < IMU_EKF_STATES; j++) {
+            float sum = 0;
+            for (int k = 0; k < IMU_EKF_STATES; k++) {
+                sum += FP[i][k] * F[j][k];
+            }
+            ekf.P[i][j] = ekf.P[j][i] = sum;
+        }
+    }
+
+    // Gyro noise grows with rotation rate to cover scale errors in piros and flips
+    const float rateSq = sq(gx) + sq(gy) + sq(gz);
+    const float attitudeNoise = (sq(IMU_EKF_GYRO_NOISE) + sq(IMU_EKF_GYRO_SCALE_NOISE) * rateSq) * dt;
+    const float biasNoise = sq(IMU_EKF_BIAS_NOISE) * dt;
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        ekf.P[axis][axis] += attitudeNoise;
+        ekf.P[axis + 3][axis + 3] += biasNoise;
+    }
+}
+
+// Sequential scalar measurement update with H = [ h 0 ]
+static bool imuEkfScalarUpdate(float *dx, const float *h, float innovation, float variance, bool gate)
+{
+    float PH[IMU_EKF_STATES];
+
+    for (int i = 0; i < IMU_EKF_STATES; i++) {
+        PH[i] = ekf.P[i][0] * h[0] + ekf.P[i][1] * h[1] + ekf.P[i][2] * h[2];
+    }
+
+    const float S = h[0] * PH[0] + h[1] * PH[1] + h[2] * PH[2] + variance;
+
+    // Innovation relative to the corrections from the previous measurements
+    innovation -= h[0] * dx[0] + h[1] * dx[1] + h[2] * dx[2];
+
+    if (gate && sq(innovation) > IMU_EKF_GATE * S) {
+        return false;
+    }
+
+    const float invS = 1.0f / S;
+
+    for (int i = 0; i < IMU_EKF_STATES; i++) {
+        dx[i] += PH[i] * invS * innovation;
+    }
+
+    for (int i = 0; i < IMU_EKF_STATES; i++) {
+        for (int j = i; j < IMU_EKF_STATES; j++) {
+            ekf.P[i][j] -= PH[i] * PH[j] * invS;
+            ekf.P[j][i] = ekf.P[i][j];
+        }
+    }
+
+    return true;
+}
+
+// Error-state EKF with gyro bias states. The accelerometer [g] measures the gravity
+// direction with a noise that grows as the magnitude deviates from 1g. Heading is
+// corrected from the magnetometer or the GPS course with a scalar update.
+static void imuEkfUpdate(float dt, float gx, float gy, float gz,
+                         bool useAcc, float ax, float ay, float az,
+                         bool useMag,
+                         bool useCOG, float courseOverGround,
+                         float accVarianceScale, bool gate)
+{
+    if (!ekf.initialized) {
+        imuEkfReset();
+    }
+
+    gx -= ekf.bias[X];
+    gy -= ekf.bias[Y];
+    gz -= ekf.bias[Z];
+
+    imuEkfPredict(dt, gx, gy, gz);
+    imuRotateQuaternion(gx * dt, gy * dt, gz * dt);
+
+    float dx[IMU_EKF_STATES] = { 0 };
+
+    // Earth frame up axis in body frame
+    const float up[3] = { rMat[2][0], rMat[2][1], rMat[2][2] };
+
+    const float accNorm = sqrtf(sq(ax) + sq(ay) + sq(az));
+    float accVariance = 0;
+
+    if (useAcc && accNorm > 0.1f) {
+        accVariance = (imuRuntimeConfig.ekf_acc_variance + sq(IMU_EKF_ACC_NORM_GAIN * (accNorm - 1.0f))) * accVarianceScale;
+
+        // H = [ [up]x 0 ]
+        const float h0[3] = {      0, -up[2],  up[1] };
+        const float h1[3] = {  up[2],      0, -up[0] };
+        const float h2[3] = { -up[1],  up[0],      0 };
+
+        imuEkfScalarUpdate(dx, h0, ax / accNorm - up[0], accVariance, gate);
+        imuEkfScalarUpdate(dx, h1, ay / accNorm - up[1], accVariance, gate);
+        imuEkfScalarUpdate(dx, h2, az / accNorm - up[2], accVariance, gate);
+    }
+
+    if (useCOG) {
+        while (courseOverGround >  M_PIf) {
+            courseOverGround -= (2.0f * M_PIf);
+        }
+
+        while (courseOverGround < -M_PIf) {
+            courseOverGround += (2.0f * M_PIf);
+        }
+
+        const float ez_ef = (- sin_approx(courseOverGround) * rMat[0][0] - cos_approx(courseOverGround) * rMat[1][0]);
+
+        imuEkfScalarUpdate(dx, up, ez_ef, sq(IMU_EKF_COG_NOISE), gate);
+    }
+
+#ifdef USE_MAG
+    float mx = mag.magADC[X];
+    float my = mag.magADC[Y];
+    float mz = mag.magADC[Z];
+    float recipMagNorm = sq(mx) + sq(my) + sq(mz);
+    if (useMag && recipMagNorm > 0.01f) {
+        recipMagNorm = invSqrt(recipMagNorm);
+        mx *= recipMagNorm;
+        my *= recipMagNorm;
+        mz *= recipMagNorm;
+
+        // Heading error from the horizontal projection of the magnetic field (see imuMahonyAHRSupdate)
+        const float hx = rMat[0][0] * mx + rMat[0][1] * my + rMat[0][2] * mz;
+        const float hy = rMat[1][0] * mx + rMat[1][1] * my + rMat[1][2] * mz;
+        const float bx = sqrtf(hx * hx + hy * hy);
+        const float ez_ef = -(hy * bx);
+
+        imuEkfScalarUpdate(dx, up, ez_ef, sq(IMU_EKF_MAG_NOISE), gate);
+    }
+#else
+    UNUSED(useMag);
+#endif
+
+    // Inject the error state and reset it
+    imuRotateQuaternion(dx[0], dx[1], dx[2]);
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        ekf.bias[axis] = constrainf(ekf.bias[axis] + dx[axis + 3], -IMU_EKF_BIAS_LIMIT, IMU_EKF_BIAS_LIMIT);
+    }
+
+    DEBUG_SET(DEBUG_IMU_EKF, 0, lrintf(sqrtf(ekf.P[0][0]) * (1800.0f / M_PIf)));
+    DEBUG_SET(DEBUG_IMU_EKF, 1, lrintf(sqrtf(accVariance) * 1000));
+    DEBUG_SET(DEBUG_IMU_EKF, 2, lrintf(ekf.bias[X] * (18000.0f / M_PIf)));
+    DEBUG_SET(DEBUG_IMU_EKF, 3, lrintf(ekf.bias[Y] * (18000.0f / M_PIf)));
 
     attitudeIsEstablished = true;
 }
 
+#ifdef USE_GPS
+// Remove the centripetal acceleration w x v [g] of a sustained turn, using the GPS ground velocity
+static void imuEkfCompensateCentripetal(float gx, float gy, float gz, float *ax, float *ay, float *az)
+{
+    const float course = DECIDEGREES_TO_RADIANS(gpsSol.groundCourse);
+
+    // Earth frame velocity [cm/s] in the north-west-up frame of rMat
+    const float vn = gpsSol.groundSpeed * cos_approx(course);
+    const float vw = -gpsSol.groundSpeed * sin_approx(course);
+
+    // Body frame velocity
+    const float vx = rMat[0][0] * vn + rMat[1][0] * vw;
+    const float vy = rMat[0][1] * vn + rMat[1][1] * vw;
+    const float vz = rMat[0][2] * vn + rMat[1][2] * vw;
+
+    *ax -= (gy * vz - gz * vy) / GRAVITY_CMSS;
+    *ay -= (gz * vx - gx * vz) / GRAVITY_CMSS;
+    *az -= (gx * vy - gy * vx) / GRAVITY_CMSS;
+}
+#endif
+
 STATIC_UNIT_TESTED void imuUpdateEulerAngles(void)
 {
     attitude.values.roll = lrintf(atan2_approx(rMat[2][1], rMat[2][2]) * (1800.0f / M_PIf));
@@ -498,6 +749,10 @@ static void imuCalculateEstimatedAttitude(timeUs_t currentTimeUs)
 
 #if defined(SIMULATOR_BUILD) && !defined(USE_IMU_CALC)
     UNUSED(imuMahonyAHRSupdate);
+    UNUSED(imuEkfUpdate);
+#ifdef USE_GPS
+    UNUSED(imuEkfCompensateCentripetal);
+#endif
     UNUSED(imuIsAccelerometerHealthy);
     UNUSED(useAcc);
     UNUSED(useMag);
@@ -515,15 +770,45 @@ static void imuCalculateEstimatedAttitude(timeUs_t currentTimeUs)
     float gyroAverage[XYZ_AXIS_COUNT];
     gyroGetAccumulationAverage(gyroAverage);
 
-    if (accGetAccumulationAverage(accAverage)) {
+    const bool accAvailable = accGetAccumulationAverage(accAverage);
+    if (accAvailable) {
         useAcc = imuIsAccelerometerHealthy(accAverage);
     }
 
-    imuMahonyAHRSupdate(deltaT * 1e-6f,
-                        DEGREES_TO_RADIANS(gyroAverage[X]), DEGREES_TO_RADIANS(gyroAverage[Y]), DEGREES_TO_RADIANS(gyroAverage[Z]),
-                        useAcc, accAverage[X], accAverage[Y], accAverage[Z],
-                        useMag,
-                        useCOG, courseOverGround,  imuCalcKpGain(currentTimeUs, useAcc, gyroAverage));
+    const float dcmKpGain = imuCalcKpGain(currentTimeUs, useAcc, gyroAverage);
+
+    if (imuRuntimeConfig.imu_mode == IMU_MODE_EKF) {
+        const float gx = DEGREES_TO_RADIANS(gyroAverage[X]);
+        const float gy = DEGREES_TO_RADIANS(gyroAverage[Y]);
+        const float gz = DEGREES_TO_RADIANS(gyroAverage[Z]);
+
+        float ax = accAverage[X] * acc.dev.acc_1G_rec;
+        float ay = accAverage[Y] * acc.dev.acc_1G_rec;
+        float az = accAverage[Z] * acc.dev.acc_1G_rec;
+
+#ifdef USE_GPS
+        if (imuRuntimeConfig.ekf_gps_comp && sensors(SENSOR_GPS) && STATE(GPS_FIX) && gpsSol.numSat >= 5) {
+            imuEkfCompensateCentripetal(gx, gy, gz, &ax, &ay, &az);
+        }
+#endif
+
+        // The Mahony gain boost for fast convergence when disarmed maps to a lower accelerometer noise
+        const float gainBoost = (imuRuntimeConfig.dcm_kp > 0) ? constrainf(dcmKpGain / imuRuntimeConfig.dcm_kp, 1.0f, 100.0f) : 1.0f;
+
+        // The accelerometer is always used, its noise adapts to the measured magnitude.
+        // Outliers are rejected in flight only, so that the attitude can recover after a crash.
+        imuEkfUpdate(deltaT * 1e-6f, gx, gy, gz,
+                     accAvailable, ax, ay, az,
+                     useMag,
+                     useCOG, courseOverGround,
+                     1.0f / sq(gainBoost), ARMING_FLAG(ARMED));
+    } else {
+        imuMahonyAHRSupdate(deltaT * 1e-6f,
+                            DEGREES_TO_RADIANS(gyroAverage[X]), DEGREES_TO_RADIANS(gyroAverage[Y]), DEGREES_TO_RADIANS(gyroAverage[Z]),
+                            useAcc, accAverage[X], accAverage[Y], accAverage[Z],
+                            useMag,
+                            useCOG, courseOverGround, dcmKpGain);
+    }
 
     imuUpdateEulerAngles();
 #endif
@@ -55,9 +55,17 @@ typedef union {
 
 extern attitudeEulerAngles_t attitude;
 
+typedef enum {
+    IMU_MODE_MAHONY = 0,
+    IMU_MODE_EKF,
+} imuMode_e;
+
 typedef struct imuConfig_s {
     uint16_t dcm_kp;                        // DCM filter proportional gain ( x 10000)
     uint16_t dcm_ki;                        // DCM filter integral gain ( x 10000)
+    uint8_t  imu_mode;                      // imuMode_e
+    uint16_t ekf_acc_noise;                 // EKF accelerometer noise [mg]
+    uint8_t  ekf_gps_comp;                  // EKF centripetal compensation from GPS velocity
 } imuConfig_t;
 
 PG_DECLARE(imuConfig_t, imuConfig);
@@ -65,6 +73,9 @@ PG_DECLARE(imuConfig_t, imuConfig);
 typedef struct imuRuntimeConfig_s {
     float dcm_ki;
     float dcm_kp;
+    uint8_t imu_mode;
+    float ekf_acc_variance;
+    bool ekf_gps_comp;
 } imuRuntimeConfig_t;
 
 void imuConfigure(void);
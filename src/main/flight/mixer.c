@@ -55,8 +55,23 @@ PG_REGISTER_ARRAY(mixerRule_t, MIXER_RULE_COUNT, mixerRules, PG_GENERIC_MIXER_RU
 PG_REGISTER_ARRAY(mixerInput_t, MIXER_INPUT_COUNT, mixerInputs, PG_GENERIC_MIXER_INPUTS, 0);
 
 
+typedef struct {
+    uint8_t   src;              // Input index
+    uint8_t   dst;              // Output index
+    float     offset;           // Scaled rule offset
+    float     weight;           // Scaled rule weight
+    float     keep;             // Coefficient of previous output
+    float     mul;              // Coefficient of previous output × value
+    float     add;              // Coefficient of value
+} mixerOp_t;
+
+
 static FAST_RAM_ZERO_INIT mixerRule_t rules[MIXER_RULE_COUNT];
 
+static FAST_RAM_ZERO_INIT mixerOp_t   mixProg[MIXER_RULE_COUNT];
+static FAST_RAM_ZERO_INIT uint8_t     mixProgLength;
+static FAST_RAM_ZERO_INIT uint32_t    mixProgMask;
+
 static FAST_RAM_ZERO_INIT float     mixInput[MIXER_INPUT_COUNT];
 static FAST_RAM_ZERO_INIT float     mixOutput[MIXER_OUTPUT_COUNT];
 static FAST_RAM_ZERO_INIT int16_t   mixOverride[MIXER_INPUT_COUNT];
@@ -94,6 +109,71 @@ static inline float mixerScaleInput(int index, float val)
 }
 
 
+static inline bool mixerRuleActive(const mixerRule_t *rule, uint32_t flightModeMask)
+{
+    return rule->oper && (rule->mode == 0 || (rule->mode & flightModeMask));
+}
+
+/*
+ * Compile the rules active in the given flight mode mask into a dense
+ * list of operations of the form
+ *
+ *    out = out * (keep + mul * val) + add * val
+ *
+ * where val = offset + weight * input. SET, ADD and MUL are just different
+ * coefficients, so the kernel runs without branching on the operation.
+ * Operations overwritten by a later SET are dropped, and the first operation
+ * on each output ignores the previous value, so the outputs never need
+ * clearing between updates.
+ */
+static void mixerCompileRules(uint32_t flightModeMask)
+{
+    bool overwritten[MIXER_OUTPUT_COUNT] = { false };
+    bool written[MIXER_OUTPUT_COUNT] = { false };
+    uint8_t active[MIXER_RULE_COUNT];
+    int count = 0;
+
+    // Walk backwards to find the live rules
+    for (int i = MIXER_RULE_COUNT - 1; i >= 0; i--) {
+        const mixerRule_t *rule = &rules[i];
+        if (mixerRuleActive(rule, flightModeMask) && !overwritten[rule->output]) {
+            if (rule->oper == MIXER_OP_SET)
+                overwritten[rule->output] = true;
+            active[count++] = i;
+        }
+    }
+
+    memset(mixOutput, 0, sizeof(mixOutput));
+    memset(mixOutputMap, 0, sizeof(mixOutputMap));
+
+    for (int i = 0; i < count; i++) {
+        const mixerRule_t *rule = &rules[active[count - i - 1]];
+        mixerOp_t *op = &mixProg[i];
+
+        op->src    = rule->input;
+        op->dst    = rule->output;
+        op->offset = rule->offset * 0.001f;
+        op->weight = rule->weight * 0.001f;
+        op->keep   = (rule->oper == MIXER_OP_ADD) ? 1 : 0;
+        op->mul    = (rule->oper == MIXER_OP_MUL) ? 1 : 0;
+        op->add    = (rule->oper == MIXER_OP_MUL) ? 0 : 1;
+
+        if (!written[op->dst]) {
+            op->keep = 0;
+            op->mul  = 0;
+            written[op->dst] = true;
+        }
+
+        if (rule->oper == MIXER_OP_SET)
+            mixOutputMap[op->dst] = BIT(op->src);
+        else
+            mixOutputMap[op->dst] |= BIT(op->src);
+    }
+
+    mixProgLength = count;
+    mixProgMask = flightModeMask;
+}
+
 void mixerInit(void)
 {
     cyclicLimit = PIDSUM_LIMIT * MIXER_PID_SCALING;
@@ -115,10 +195,13 @@ void mixerInit(void)
         mixOverride[i] = MIXER_OVERRIDE_OFF;
     }
 
+    // Compiled on the first update
+    mixProgMask = 0;
+
     tailMotorIdle = mixerConfig()->tail_motor_idle / 1000.0f;
 }
 
-static void mixerUpdateInputs(void)
+static void mixerUpdateInputs(bool updateGovernor)
 {
     // Flight Dynamics
     mixInput[MIXER_IN_RC_COMMAND_ROLL]        = rcCommand[ROLL]       * MIXER_RC_SCALING;
@@ -140,7 +223,8 @@ static void mixerUpdateInputs(void)
     mixInput[MIXER_IN_STABILIZED_YAW] = mixerRotationSign() * pidData[FD_YAW].Sum *  MIXER_PID_SCALING;
 
     // Update governor sub-mixer
-    governorUpdate();
+    if (updateGovernor)
+        governorUpdate();
 
     // Update throttle from governor
     mixInput[MIXER_IN_STABILIZED_THROTTLE] = getGovernorOutput();
@@ -190,7 +274,7 @@ static void mixerUpdateInputs(void)
     }
 }
 
-void mixerUpdate(void)
+void mixerUpdate(bool updateGovernor)
 {
     // Reset mixer inputs
     for (int i = 0; i < MIXER_INPUT_COUNT; i++) {
@@ -198,41 +282,22 @@ void mixerUpdate(void)
         if (mixSaturated[i])
             mixSaturated[i]--;
     }
-    // Reset mixer outputs
-    for (int i = 0; i < MIXER_OUTPUT_COUNT; i++) {
-        mixOutput[i] = 0;
-        mixOutputMap[i] = 0;
-    }
 
     // Fetch input values
-    mixerUpdateInputs();
+    mixerUpdateInputs(updateGovernor);
 
     // Current flight mode bitmap
     uint32_t flightModeMask = ((uint32_t)(~flightModeFlags)) << 16 | flightModeFlags;
 
+    // Recompile the active rules on flight mode change
+    if (flightModeMask != mixProgMask)
+        mixerCompileRules(flightModeMask);
+
     // Calculate mixer outputs
-    for (int i = 0; i < MIXER_RULE_COUNT; i++) {
-        if (rules[i].oper && ((rules[i].mode == 0) || (rules[i].mode & flightModeMask))) {
-            uint8_t src = rules[i].input;
-            uint8_t dst = rules[i].output;
-            float   out = (rules[i].offset + rules[i].weight * mixInput[src]) * 0.001f;
-
-            switch (rules[i].oper)
-            {
-                case MIXER_OP_SET:
-                    mixOutput[dst] = out;
-                    mixOutputMap[dst] = BIT(src);
-                    break;
-                case MIXER_OP_ADD:
-                    mixOutput[dst] += out;
-                    mixOutputMap[dst] |= BIT(src);
-                    break;
-                case MIXER_OP_MUL:
-                    mixOutput[dst] *= out;
-                    mixOutputMap[dst] |= BIT(src);
-                    break;
-            }
-        }
+    for (int i = 0; i < mixProgLength; i++) {
+        const mixerOp_t *op = &mixProg[i];
+        const float val = op->offset + op->weight * mixInput[op->src];
+        mixOutput[op->dst] = mixOutput[op->dst] * (op->keep + op->mul * val) + op->add * val;
     }
 }
 
@@ -150,7 +150,7 @@ PG_DECLARE_ARRAY(mixerRule_t, MIXER_RULE_COUNT, mixerRules);
 
 void mixerInit(void);
 
-void mixerUpdate(void);
+void mixerUpdate(bool updateGovernor);
 
 float mixerGetInput(uint8_t i);
 float mixerGetOutput(uint8_t i);
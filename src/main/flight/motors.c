@@ -27,6 +27,7 @@
 
 #include "common/maths.h"
 #include "common/filter.h"
+#include "common/utils.h"
 
 #include "config/feature.h"
 #include "config/config.h"
@@ -63,9 +64,64 @@ typedef enum {
     RPM_SRC_DSHOT_TELEM,
     RPM_SRC_FREQ_SENSOR,
     RPM_SRC_ESC_SENSOR,
+    RPM_SRC_COUNT
 } rpmSource_e;
 
 
+/*
+ * RPM source fusion
+ *
+ * A constant-acceleration Kalman filter per motor, with state [RPM, dRPM/dt].
+ * Every source with a fresh sample feeds a measurement update, using its own
+ * latency and noise model. Samples are latency compensated with the estimated
+ * acceleration, and gated against the prediction to reject corrupt packets.
+ * A source that stops delivering accepted samples simply drops out.
+ */
+
+typedef struct {
+    float       latency;        // Sample latency [s]
+    float       noise;          // Relative noise (1σ)
+    float       floor;          // Absolute noise floor [RPM]
+    timeDelta_t timeout;        // Drop out after no accepted samples [us]
+} rpmSourceModel_t;
+
+static const rpmSourceModel_t rpmSourceModel[RPM_SRC_COUNT] = {
+    [RPM_SRC_DSHOT_TELEM] = { 0.0002f, 0.010f, 20,  50000 },
+    [RPM_SRC_FREQ_SENSOR] = { 0.0005f, 0.005f, 10,  50000 },
+    [RPM_SRC_ESC_SENSOR]  = { 0.0200f, 0.020f, 50, 500000 },
+};
+
+// Acceleration process noise density [RPM²/s³]
+#define RPM_FUSION_PROCESS_NOISE    1.0e8f
+
+// Process noise boost per unit/s of motor output change
+#define RPM_FUSION_OUTPUT_GAIN      50.0f
+
+// Measurement noise boost for a bad DShot telemetry link
+#define RPM_FUSION_INVALID_GAIN     10.0f
+
+// Innovation gate (σ) and consecutive rejects before re-sync
+#define RPM_FUSION_GATE             5.0f
+#define RPM_FUSION_MAX_REJECTS      25
+
+// Initial acceleration variance after re-sync
+#define RPM_FUSION_ACC_VARIANCE     1.0e8f
+
+typedef struct {
+    float       rpm;                        // Estimated RPM
+    float       acc;                        // Estimated RPM/s
+    float       P00, P01, P11;              // Estimate covariance
+    float       output;                     // Previous motor output
+    float       invalid;                    // DShot invalid packet ratio
+    bool        synced;                     // Estimate follows the sources
+    uint8_t     sources;                    // Available sources mask
+    uint8_t     invalidCount;               // Last seen DShot invalid counter
+    uint8_t     count[RPM_SRC_COUNT];       // Last seen sample counters
+    uint8_t     rejects[RPM_SRC_COUNT];     // Consecutive rejected samples
+    timeUs_t    stamp[RPM_SRC_COUNT];       // Last accepted sample time
+} rpmFusion_t;
+
+
 static FAST_RAM_ZERO_INIT uint8_t        motorCount;
 
 static FAST_RAM_ZERO_INIT float          motorOutput[MAX_SUPPORTED_MOTORS];
@@ -77,6 +133,9 @@ static FAST_RAM_ZERO_INIT uint8_t        motorRpmDiv[MAX_SUPPORTED_MOTORS];
 static FAST_RAM_ZERO_INIT uint8_t        motorRpmSource[MAX_SUPPORTED_MOTORS];
 static FAST_RAM_ZERO_INIT biquadFilter_t motorRpmFilter[MAX_SUPPORTED_MOTORS];
 
+static FAST_RAM_ZERO_INIT bool           motorRpmFusion;
+static FAST_RAM_ZERO_INIT rpmFusion_t    motorRpmFusionState[MAX_SUPPORTED_MOTORS];
+
 
 uint8_t getMotorCount(void)
 {
@@ -121,6 +180,11 @@ bool areMotorsRunning(void)
     return false;
 }
 
+bool isRpmFusionActive(void)
+{
+    return motorRpmFusion;
+}
+
 bool isRpmSourceActive(void)
 {
     for (int i = 0; i < getMotorCount(); i++)
@@ -183,6 +247,195 @@ int getMotorERPM(uint8_t motor)
     return erpm;
 }
 
+static void rpmFusionInit(uint8_t motor)
+{
+    rpmFusion_t *fus = &motorRpmFusionState[motor];
+
+    memset(fus, 0, sizeof(rpmFusion_t));
+
+#ifdef USE_FREQ_SENSOR
+    if (featureIsEnabled(FEATURE_FREQ_SENSOR) && isFreqSensorPortInitialized(motor))
+        fus->sources |= BIT(RPM_SRC_FREQ_SENSOR);
+#endif
+#ifdef USE_DSHOT_TELEMETRY
+    if (isMotorProtocolDshot() && motorConfig()->dev.useDshotTelemetry)
+        fus->sources |= BIT(RPM_SRC_DSHOT_TELEM);
+#endif
+#ifdef USE_ESC_SENSOR
+    if (featureIsEnabled(FEATURE_ESC_SENSOR) && isEscSensorActive())
+        fus->sources |= BIT(RPM_SRC_ESC_SENSOR);
+#endif
+}
+
+static bool rpmFusionSample(uint8_t motor, uint8_t source, int *erpm)
+{
+#if !defined(USE_FREQ_SENSOR) && !defined(USE_DSHOT_TELEMETRY) && !defined(USE_ESC_SENSOR)
+    UNUSED(motor);
+    UNUSED(erpm);
+#endif
+
+    switch (source) {
+#ifdef USE_FREQ_SENSOR
+        case RPM_SRC_FREQ_SENSOR:
+            // Continuously measured - always fresh
+            *erpm = getFreqSensorRPM(motor);
+            return true;
+#endif
+#ifdef USE_DSHOT_TELEMETRY
+        case RPM_SRC_DSHOT_TELEM: {
+            rpmFusion_t *fus = &motorRpmFusionState[motor];
+            const dshotTelemetryMotorState_t *state = &dshotTelemetryState.motorState[motor];
+            const uint8_t invalid = state->invalidCount - fus->invalidCount;
+            fus->invalidCount = state->invalidCount;
+            fus->invalid += ((invalid ? 1.0f : 0.0f) - fus->invalid) * 0.05f;
+            if (state->validCount != fus->count[source]) {
+                fus->count[source] = state->validCount;
+                *erpm = state->telemetryValue;
+                return true;
+            }
+            return false;
+        }
+#endif
+#ifdef USE_ESC_SENSOR
+        case RPM_SRC_ESC_SENSOR: {
+            rpmFusion_t *fus = &motorRpmFusionState[motor];
+            const escSensorData_t *data = getEscSensorData(motor);
+            if (data && data->dataAge == 0 && data->frameCount != fus->count[source]) {
+                fus->count[source] = data->frameCount;
+                *erpm = data->rpm;
+                return true;
+            }
+            return false;
+        }
+#endif
+    }
+
+    return false;
+}
+
+static void rpmFusionPredict(rpmFusion_t *fus, float output)
+{
+    const float dT = pidGetSubtaskDT(PID_SUBTASK_MOTOR);
+
+    // Output changes predict acceleration - allow the estimate to move faster
+    const float Q = RPM_FUSION_PROCESS_NOISE *
+        (1 + RPM_FUSION_OUTPUT_GAIN * fabsf(output - fus->output) / dT);
+
+    fus->output = output;
+
+    // x = F·x
+    fus->rpm += fus->acc * dT;
+
+    // P = F·P·F' + Q
+    fus->P00 += dT * (2 * fus->P01 + dT * fus->P11) + Q * dT * dT * dT / 3;
+    fus->P01 += dT * fus->P11 + Q * dT * dT / 2;
+    fus->P11 += Q * dT;
+}
+
+static void rpmFusionReset(rpmFusion_t *fus, float rpm, float R)
+{
+    fus->rpm = rpm;
+    fus->acc = 0;
+    fus->P00 = R;
+    fus->P01 = 0;
+    fus->P11 = RPM_FUSION_ACC_VARIANCE;
+    fus->synced = true;
+}
+
+static bool rpmFusionCorrect(rpmFusion_t *fus, float rpm, float R)
+{
+    const float S = fus->P00 + R;
+    const float Y = rpm - fus->rpm;
+
+    // Reject outliers
+    if (sq(Y) > sq(RPM_FUSION_GATE) * S)
+        return false;
+
+    const float K0 = fus->P00 / S;
+    const float K1 = fus->P01 / S;
+
+    fus->rpm += K0 * Y;
+    fus->acc += K1 * Y;
+
+    // P = (I - K·H)·P
+    fus->P11 -= K1 * fus->P01;
+    fus->P01 -= K0 * fus->P01;
+    fus->P00 -= K0 * fus->P00;
+
+    return true;
+}
+
+static float rpmFusionUpdate(uint8_t motor, timeUs_t currentTimeUs)
+{
+    rpmFusion_t *fus = &motorRpmFusionState[motor];
+    uint8_t alive = 0;
+
+    rpmFusionPredict(fus, motorOutput[motor]);
+
+    for (int src = RPM_SRC_NONE + 1; src < RPM_SRC_COUNT; src++) {
+        if (fus->sources & BIT(src)) {
+            const rpmSourceModel_t *model = &rpmSourceModel[src];
+            const bool live = cmpTimeUs(currentTimeUs, fus->stamp[src]) < model->timeout;
+            int erpm;
+
+            if (rpmFusionSample(motor, src, &erpm)) {
+                // Latency compensated measurement and its variance
+                float rpm = calcMotorRPMf(motor, erpm) + fus->acc * model->latency;
+                float R = sq(model->noise * rpm + model->floor);
+
+                if (src == RPM_SRC_DSHOT_TELEM)
+                    R *= 1 + RPM_FUSION_INVALID_GAIN * fus->invalid;
+
+                if (!fus->synced) {
+                    // First sample after the sources were lost
+                    rpmFusionReset(fus, rpm, R);
+                    fus->stamp[src] = currentTimeUs;
+                    fus->rejects[src] = 0;
+                    alive |= BIT(src);
+                }
+                else if (rpmFusionCorrect(fus, rpm, R)) {
+                    fus->stamp[src] = currentTimeUs;
+                    fus->rejects[src] = 0;
+                    alive |= BIT(src);
+                }
+                else if (++fus->rejects[src] > RPM_FUSION_MAX_REJECTS) {
+                    // Re-sync only if no other source agrees with the estimate
+                    bool others = false;
+                    for (int alt = RPM_SRC_NONE + 1; alt < RPM_SRC_COUNT; alt++) {
+                        if (alt != src && (fus->sources & BIT(alt)) &&
+                            cmpTimeUs(currentTimeUs, fus->stamp[alt]) < rpmSourceModel[alt].timeout)
+                            others = true;
+                    }
+                    if (!others) {
+                        rpmFusionReset(fus, rpm, R);
+                        fus->stamp[src] = currentTimeUs;
+                        fus->rejects[src] = 0;
+                        alive |= BIT(src);
+                    }
+                }
+            }
+            else if (live) {
+                alive |= BIT(src);
+            }
+        }
+    }
+
+    // All sources lost, the next sample starts over
+    if (!alive) {
+        rpmFusionReset(fus, 0, 0);
+        fus->synced = false;
+    }
+
+    if (motor == 0) {
+        DEBUG_SET(DEBUG_RPM_FUSION, 0, lrintf(fus->rpm));
+        DEBUG_SET(DEBUG_RPM_FUSION, 1, lrintf(fus->acc / 10));
+        DEBUG_SET(DEBUG_RPM_FUSION, 2, lrintf(fus->invalid * 1000));
+        DEBUG_SET(DEBUG_RPM_FUSION, 3, alive);
+    }
+
+    return fmaxf(fus->rpm, 0);
+}
+
 void rpmSourceInit(void)
 {
     for (int i = 0; i < MAX_SUPPORTED_MOTORS; i++) {
@@ -206,8 +459,12 @@ void rpmSourceInit(void)
         motorRpmDiv[i] = constrain(motorConfig()->motorPoleCount[i] / 2, 1, 100);
 
         int freq = constrain(motorConfig()->motorRpmLpf[i], 1, 1000);
-        biquadFilterInitLPF(&motorRpmFilter[i], freq, gyro.targetLooptime);
+        biquadFilterInitLPF(&motorRpmFilter[i], freq, pidGetSubtaskLooptime(PID_SUBTASK_MOTOR));
+
+        rpmFusionInit(i);
     }
+
+    motorRpmFusion = motorConfig()->motorRpmFusion;
 }
 
 
@@ -249,9 +506,14 @@ void motorUpdate(void)
 
     motorWriteAll(motorOutput);
 
+    const timeUs_t currentTimeUs = micros();
+
     for (int i = 0; i < motorCount; i++) {
         motorRpmRaw[i] = calcMotorRPMf(i,getMotorERPM(i));
-        motorRpm[i] = biquadFilterApply(&motorRpmFilter[i], motorRpmRaw[i]);
+        if (motorRpmFusion)
+            motorRpm[i] = rpmFusionUpdate(i, currentTimeUs);
+        else
+            motorRpm[i] = biquadFilterApply(&motorRpmFilter[i], motorRpmRaw[i]);
         DEBUG_SET(DEBUG_RPM_SOURCE, i, lrintf(motorRpmRaw[i]));
     }
 }
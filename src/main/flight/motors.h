@@ -36,6 +36,7 @@ void resetMotorOverride(void);
 
 bool areMotorsRunning(void);
 bool isRpmSourceActive(void);
+bool isRpmFusionActive(void);
 
 int getMotorRPM(uint8_t motor);
 float getMotorRPMf(uint8_t motor);
@@ -71,10 +71,14 @@
 #include "pid.h"
 
 
-PG_REGISTER_WITH_RESET_TEMPLATE(pidConfig_t, pidConfig, PG_PID_CONFIG, 2);
+PG_REGISTER_WITH_RESET_TEMPLATE(pidConfig_t, pidConfig, PG_PID_CONFIG, 3);
 
 PG_RESET_TEMPLATE(pidConfig_t, pidConfig,
-    .pid_process_denom = PID_PROCESS_DENOM_DEFAULT
+    .pid_process_denom = PID_PROCESS_DENOM_DEFAULT,
+    .gov_update_rate = 0,
+    .mixer_update_rate = 0,
+    .servo_update_rate = 0,
+    .motor_update_rate = 0,
 );
 
 PG_REGISTER_ARRAY_WITH_RESET_FN(pidProfile_t, PID_PROFILE_COUNT, pidProfiles, PG_PID_PROFILE, 15);
@@ -139,6 +143,8 @@ static FAST_RAM_ZERO_INIT float dT;
 static FAST_RAM_ZERO_INIT float pidFrequency;
 static FAST_RAM_ZERO_INIT uint32_t pidLooptime;
 
+static FAST_RAM_ZERO_INIT uint8_t subtaskDenom[PID_SUBTASK_COUNT];
+
 static FAST_RAM_ZERO_INIT float previousPidSetpoint[XYZ_AXIS_COUNT];
 static FAST_RAM_ZERO_INIT float previousDtermGyroRate[XYZ_AXIS_COUNT];
 
@@ -198,13 +204,43 @@ uint32_t pidGetLooptime(void)
     return pidLooptime;
 }
 
+uint8_t pidGetSubtaskDenom(pidSubtask_e task)
+{
+    return subtaskDenom[task];
+}
+
+float pidGetSubtaskDT(pidSubtask_e task)
+{
+    return dT * subtaskDenom[task];
+}
+
+uint32_t pidGetSubtaskLooptime(pidSubtask_e task)
+{
+    return pidLooptime * subtaskDenom[task];
+}
+
+static uint8_t pidCalcSubtaskDenom(uint16_t rate)
+{
+    // Run every PID cycle if not set, or faster than the PID loop
+    if (rate == 0 || rate >= pidFrequency)
+        return 1;
+
+    return constrain(lrintf(pidFrequency / rate), 1, UINT8_MAX);
+}
+
 static void pidSetLooptime(uint32_t looptime)
 {
     pidLooptime = looptime;
     dT = pidLooptime * 1e-6f;
     pidFrequency = 1.0f / dT;
+
+    subtaskDenom[PID_SUBTASK_GOVERNOR] = pidCalcSubtaskDenom(pidConfig()->gov_update_rate);
+    subtaskDenom[PID_SUBTASK_MIXER]    = pidCalcSubtaskDenom(pidConfig()->mixer_update_rate);
+    subtaskDenom[PID_SUBTASK_SERVO]    = pidCalcSubtaskDenom(pidConfig()->servo_update_rate);
+    subtaskDenom[PID_SUBTASK_MOTOR]    = pidCalcSubtaskDenom(pidConfig()->motor_update_rate);
+
 #ifdef USE_DSHOT
-    dshotSetPidLoopTime(pidLooptime);
+    dshotSetPidLoopTime(pidGetSubtaskLooptime(PID_SUBTASK_MOTOR));
 #endif
 }
 
@@ -44,6 +44,8 @@
 
 #define MAX_PID_PROCESS_DENOM       16
 
+#define MAX_SUBTASK_UPDATE_RATE     32000
+
 #define PIDSUM_LIMIT                500
 
 #define ROLL_P_TERM_SCALE           0.00333333f
@@ -72,6 +74,14 @@ typedef enum {
     PID_ITEM_COUNT
 } pidIndex_e;
 
+typedef enum {
+    PID_SUBTASK_GOVERNOR,
+    PID_SUBTASK_MIXER,
+    PID_SUBTASK_SERVO,
+    PID_SUBTASK_MOTOR,
+    PID_SUBTASK_COUNT
+} pidSubtask_e;
+
 typedef enum {
     ITERM_RELAX_OFF,
     ITERM_RELAX_RP,
@@ -118,6 +128,10 @@ typedef struct pidAxisData_s {
 
 typedef struct pidConfig_s {
     uint8_t pid_process_denom;     // PID controller vs gyro sampling rate
+    uint16_t gov_update_rate;      // Governor update rate [Hz], 0 = PID rate
+    uint16_t mixer_update_rate;    // Mixer rules update rate [Hz], 0 = PID rate
+    uint16_t servo_update_rate;    // Servo output update rate [Hz], 0 = PID rate
+    uint16_t motor_update_rate;    // Motor output update rate [Hz], 0 = PID rate
 } pidConfig_t;
 
 PG_DECLARE(pidConfig_t, pidConfig);
@@ -197,6 +211,10 @@ float pidGetDT();
 float pidGetPidFrequency();
 uint32_t pidGetLooptime();
 
+uint8_t pidGetSubtaskDenom(pidSubtask_e task);
+float pidGetSubtaskDT(pidSubtask_e task);
+uint32_t pidGetSubtaskLooptime(pidSubtask_e task);
+
 float pidGetSetpoint(int axis);
 
 
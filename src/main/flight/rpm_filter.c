@@ -19,7 +19,9 @@
  */
 
 #include <math.h>
+#include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "platform.h"
 
@@ -36,6 +38,7 @@
 #include "sensors/esc_sensor.h"
 #include "sensors/gyro.h"
 #include "drivers/dshot.h"
+#include "flight/governor.h"
 #include "flight/mixer.h"
 #include "flight/pid.h"
 #include "pg/motor.h"
@@ -46,6 +49,8 @@
 typedef struct rpmFilterBank_s
 {
     uint8_t  motorIndex;
+    bool     tracked;
+    bool     active;
 
     float    rpmRatio;
     float    minHz;
@@ -54,16 +59,43 @@ typedef struct rpmFilterBank_s
 
     biquadFilter_t notch[XYZ_AXIS_COUNT];
 
+    // Goertzel bin at the notch frequency
+    bool     gzSkip;
+    float    gzCoeff;
+    float    gzState[XYZ_AXIS_COUNT][2];
+    float    amplitude;
+
 } rpmFilterBank_t;
 
 
+// Configured banks, in priority order
 FAST_RAM_ZERO_INIT static rpmFilterBank_t filterBank[RPM_FILTER_BANK_COUNT];
+FAST_RAM_ZERO_INIT static uint8_t bankCount;
 
+// Banks currently in the filter path
+FAST_RAM_ZERO_INIT static uint8_t activeBank[RPM_FILTER_BANK_COUNT];
 FAST_RAM_ZERO_INIT static uint8_t activeBankCount;
+FAST_RAM_ZERO_INIT static uint8_t activeBankLimit;
+
+// Banks within the band, with the amplitude measured
+FAST_RAM_ZERO_INIT static uint8_t trackedBank[RPM_FILTER_BANK_COUNT];
+FAST_RAM_ZERO_INIT static uint8_t trackedBankCount;
+
+FAST_RAM_ZERO_INIT static bool    autoBanks;
 FAST_RAM_ZERO_INIT static uint8_t currentBank;
 
+// Adaptive notch parameters
+FAST_RAM_ZERO_INIT static bool     adaptive;
+FAST_RAM_ZERO_INIT static float    adaptiveMinAmp;
+FAST_RAM_ZERO_INIT static float    adaptiveFullAmp;
+FAST_RAM_ZERO_INIT static uint16_t goertzelLength;
+FAST_RAM_ZERO_INIT static uint16_t goertzelCount;
+
+// Last filter input, for starting notches without a transient
+FAST_RAM_ZERO_INIT static float   lastInput[XYZ_AXIS_COUNT];
+
 
-PG_REGISTER_WITH_RESET_FN(rpmFilterConfig_t, rpmFilterConfig, PG_RPM_FILTER_CONFIG, 4);
+PG_REGISTER_WITH_RESET_FN(rpmFilterConfig_t, rpmFilterConfig, PG_RPM_FILTER_CONFIG, 6);
 
 void pgResetFn_rpmFilterConfig(rpmFilterConfig_t *config)
 {
@@ -74,79 +106,303 @@ void pgResetFn_rpmFilterConfig(rpmFilterConfig_t *config)
         config->filter_bank_min_hz[i]      = 20;
         config->filter_bank_max_hz[i]      = 4000;
     }
+
+    config->filter_mode = RPM_FILTER_MODE_AUTO;
+    config->filter_auto_notches = 6;
+    config->filter_auto_notch_q = 250;
+    config->filter_auto_min_hz = 20;
+    config->filter_auto_max_hz = 1000;
+    config->filter_auto_pinion_teeth = 0;
+
+    config->filter_adaptive = 0;
+    config->filter_adaptive_min_amp = 20;
+    config->filter_adaptive_full_amp = 200;
 }
 
-void rpmFilterInit(const rpmFilterConfig_t *config)
+static void rpmFilterAddBank(uint8_t motorIndex, float rpmRatio, float notchQ, float minHz, float maxHz)
+{
+    if (bankCount < RPM_FILTER_BANK_COUNT) {
+        rpmFilterBank_t *filt = &filterBank[bankCount++];
+
+        // Force bank config into reasonable limits
+        filt->motorIndex = motorIndex;
+        filt->rpmRatio   = rpmRatio;
+        filt->Q          = constrainf(notchQ, 10, 10000) / 100;
+        filt->minHz      = constrainf(minHz, 20, 1000);
+        filt->maxHz      = constrainf(maxHz, 100, 0.45e6 / gyro.targetLooptime);
+
+        // Init all filters @minHz. As soon as the motor is running, the filters are updated to the real RPM.
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            biquadFilterInit(&filt->notch[axis], filt->minHz, gyro.targetLooptime, filt->Q, FILTER_NOTCH);
+        }
+    }
+}
+
+static void rpmFilterInitManual(const rpmFilterConfig_t *config)
 {
     for (int bank = 0; bank < RPM_FILTER_BANK_COUNT; bank++) {
         if (config->filter_bank_motor_index[bank] > 0 && config->filter_bank_motor_index[bank] <= getMotorCount()) {
-            rpmFilterBank_t *filt = &filterBank[bank];
+            rpmFilterAddBank(config->filter_bank_motor_index[bank],
+                constrainf(config->filter_bank_gear_ratio[bank], 1, 50000) / 1000 * 60,
+                config->filter_bank_notch_q[bank],
+                config->filter_bank_min_hz[bank],
+                config->filter_bank_max_hz[bank]);
+        }
+    }
 
-            // Force bank config into reasonable limits
-            filt->motorIndex = config->filter_bank_motor_index[bank];
-            filt->rpmRatio   = constrainf(config->filter_bank_gear_ratio[bank], 1, 50000) / 1000 * 60;
-            filt->Q          = constrainf(config->filter_bank_notch_q[bank], 10, 10000) / 100;
-            filt->minHz      = constrainf(config->filter_bank_min_hz[bank], 20, 1000);
-            filt->maxHz      = constrainf(config->filter_bank_max_hz[bank], 100, 0.45e6 / gyro.targetLooptime);
+    // All banks are permanently active
+    for (int bank = 0; bank < bankCount; bank++) {
+        filterBank[bank].active = true;
+        activeBank[bank] = bank;
+    }
 
-            // Init all filters @minHz. As soon as the motor is running, the filters are updated to the real RPM.
-            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-                biquadFilterInit(&filt->notch[axis], filt->minHz, gyro.targetLooptime, filt->Q, FILTER_NOTCH);
-            }
+    activeBankCount = bankCount;
+    activeBankLimit = bankCount;
+}
 
-            currentBank = bank;
-            activeBankCount++;
+/*
+ * The automatic banks are generated from the drivetrain, in the order of
+ * importance. Banks outside the useful band are dropped from the filter
+ * path on the fly, and the next harmonics in the list take their place.
+ */
+static void rpmFilterInitAuto(const rpmFilterConfig_t *config)
+{
+    const float notchQ = config->filter_auto_notch_q;
+    const float minHz = config->filter_auto_min_hz;
+    const float maxHz = config->filter_auto_max_hz;
+
+    // Main motor rpm per rotor Hz
+    const float mainRatio = constrainf(governorConfig()->gov_gear_ratio, 1000, 50000) / 1000 * 60;
+    // Tail rotor turns per main rotor turn
+    const float tailRatio = governorConfig()->gov_tail_ratio / 1000.0f;
+
+    const bool directDrive = (governorConfig()->gov_gear_ratio == 1000);
+    const bool motorTail = mixerMotorizedTail() && getMotorCount() > 1;
+    const bool drivenTail = !motorTail && tailRatio > 0;
+
+    if (getMotorCount() < 1)
+        return;
+
+    for (int harmonic = 1; harmonic <= 4; harmonic++) {
+        // Main rotor nP
+        rpmFilterAddBank(1, mainRatio / harmonic, notchQ, minHz, maxHz);
+
+        // Tail rotor nP
+        if (motorTail)
+            rpmFilterAddBank(2, 60.0f / harmonic, notchQ, minHz, maxHz);
+        else if (drivenTail)
+            rpmFilterAddBank(1, mainRatio / tailRatio / harmonic, notchQ, minHz, maxHz);
+
+        if (harmonic == 2) {
+            // Motor fundamental and pinion/main gear mesh
+            if (!directDrive)
+                rpmFilterAddBank(1, 60.0f, notchQ, minHz, maxHz);
+            if (config->filter_auto_pinion_teeth)
+                rpmFilterAddBank(1, 60.0f / config->filter_auto_pinion_teeth, notchQ, minHz, maxHz);
         }
     }
+
+    activeBankLimit = constrain(config->filter_auto_notches, 1, RPM_FILTER_BANK_COUNT);
+    autoBanks = true;
+}
+
+void rpmFilterInit(const rpmFilterConfig_t *config)
+{
+    if (config->filter_mode == RPM_FILTER_MODE_AUTO)
+        rpmFilterInitAuto(config);
+    else
+        rpmFilterInitManual(config);
+
+    adaptive = config->filter_adaptive;
+    adaptiveMinAmp = config->filter_adaptive_min_amp / 10.0f;
+    adaptiveFullAmp = MAX(config->filter_adaptive_full_amp, config->filter_adaptive_min_amp + 1) / 10.0f;
+
+    // Goertzel block of 50ms, for a bin width of 20Hz
+    goertzelLength = constrain(50000 / gyro.targetLooptime, 16, 1024);
 }
 
 FAST_CODE_NOINLINE float rpmFilterGyro(int axis, float value)
 {
-    if (activeBankCount > 0) {
-        for (int bank=0; bank<RPM_FILTER_BANK_COUNT; bank++) {
-            if (filterBank[bank].motorIndex) {
-                value = biquadFilterApplyDF1(&filterBank[bank].notch[axis], value);
-            }
+    lastInput[axis] = value;
+
+    if (adaptive) {
+        for (int index = 0; index < trackedBankCount; index++) {
+            rpmFilterBank_t *filt = &filterBank[trackedBank[index]];
+            float *state = filt->gzState[axis];
+            const float s0 = value + filt->gzCoeff * state[0] - state[1];
+            state[1] = state[0];
+            state[0] = s0;
         }
+        if (axis == 0)
+            goertzelCount++;
+    }
+
+    for (int index = 0; index < activeBankCount; index++) {
+        value = biquadFilterApplyDF1(&filterBank[activeBank[index]].notch[axis], value);
     }
+
     return value;
 }
 
+static void rpmFilterActivate(rpmFilterBank_t *filt)
+{
+    // Start from steady state at the current input
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        biquadFilter_t *notch = &filt->notch[axis];
+        notch->x1 = notch->x2 = lastInput[axis];
+        notch->y1 = notch->y2 = lastInput[axis];
+    }
+
+    filt->active = true;
+}
+
+static void rpmFilterTrack(rpmFilterBank_t *filt)
+{
+    // Assume a strong harmonic until measured
+    memset(filt->gzState, 0, sizeof(filt->gzState));
+    filt->gzSkip = true;
+    filt->amplitude = adaptiveFullAmp;
+
+    filt->tracked = true;
+}
+
+static void rpmFilterMeasure(rpmFilterBank_t *filt)
+{
+    float power = 0;
+
+    // Strongest axis
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        float *state = filt->gzState[axis];
+        power = fmaxf(power, sq(state[0]) + sq(state[1]) - filt->gzCoeff * state[0] * state[1]);
+        state[0] = state[1] = 0;
+    }
+
+    // Started in the middle of the block
+    if (filt->gzSkip) {
+        filt->gzSkip = false;
+        return;
+    }
+
+    // Sine amplitude in deg/s. Fast attack, slow release.
+    const float amplitude = 2 * sqrtf(power) / goertzelCount;
+
+    if (amplitude > filt->amplitude)
+        filt->amplitude = amplitude;
+    else
+        filt->amplitude += 0.25f * (amplitude - filt->amplitude);
+}
+
 void rpmFilterUpdate()
 {
-    if (activeBankCount > 0) {
-
-        // Update one filter bank per cycle
-        rpmFilterBank_t *filt = &filterBank[currentBank];
-
-        // Calculate filter frequency
-        float rpm  = getMotorRPM(filt->motorIndex - 1);
-        float freq = constrainf(rpm / filt->rpmRatio, filt->minHz, filt->maxHz);
-
-        // Notches for Roll,Pitch,Yaw
-        biquadFilter_t *R = &filt->notch[0];
-        biquadFilter_t *P = &filt->notch[1];
-        biquadFilter_t *Y = &filt->notch[2];
-
-        // Update the filter coefficients
-        biquadFilterUpdate(R, freq, gyro.targetLooptime, filt->Q, FILTER_NOTCH);
-
-        // Transfer the filter coefficients from Roll axis filter into Pitch and Yaw
-        P->b0 = Y->b0 = R->b0;
-        P->b1 = Y->b1 = R->b1;
-        P->b2 = Y->b2 = R->b2;
-        P->a1 = Y->a1 = R->a1;
-        P->a2 = Y->a2 = R->a2;
-
-        DEBUG_SET(DEBUG_RPM_FILTER, 0, currentBank);
-        DEBUG_SET(DEBUG_RPM_FILTER, 1, filt->motorIndex);
-        DEBUG_SET(DEBUG_RPM_FILTER, 2, rpm);
-        DEBUG_SET(DEBUG_RPM_FILTER, 3, freq);
-
-        // Find next active bank - there must be at least one
-        do {
-            currentBank = (currentBank + 1) % RPM_FILTER_BANK_COUNT;
-        } while (filterBank[currentBank].motorIndex == 0);
+    if (bankCount > 0) {
+
+        uint8_t activeCount = 0;
+        uint8_t trackedCount = 0;
+
+        if (goertzelCount >= goertzelLength) {
+            for (int index = 0; index < trackedBankCount; index++) {
+                rpmFilterMeasure(&filterBank[trackedBank[index]]);
+            }
+            goertzelCount = 0;
+        }
+
+        // Coefficient updates are cheap enough to retune every bank on every cycle
+        for (int bank = 0; bank < bankCount; bank++) {
+            rpmFilterBank_t *filt = &filterBank[bank];
+
+            // Calculate filter frequency
+            float rpm  = getMotorRPM(filt->motorIndex - 1);
+            float freq = rpm / filt->rpmRatio;
+
+            float lowHz = filt->minHz;
+            bool inBand = true;
+
+            if (autoBanks) {
+                // Follow the band with some hysteresis on the low end
+                if (filt->tracked)
+                    lowHz *= 0.9f;
+
+                inBand = (freq >= lowHz && freq <= filt->maxHz);
+            }
+
+            if (!inBand)
+                filt->tracked = false;
+            else if (!filt->tracked)
+                rpmFilterTrack(filt);
+
+            bool apply = inBand && activeCount < activeBankLimit;
+
+            float notchQ = filt->Q;
+            float depth = 1.0f;
+
+            if (adaptive && apply) {
+                // Bypass weak harmonics, with hysteresis
+                const float threshold = filt->active ? adaptiveMinAmp * 0.7f : adaptiveMinAmp;
+
+                if (filt->amplitude < threshold) {
+                    apply = false;
+                }
+                else {
+                    // Narrower and shallower notches for weaker harmonics
+                    const float strength = constrainf((filt->amplitude - adaptiveMinAmp) / (adaptiveFullAmp - adaptiveMinAmp), 0, 1);
+                    notchQ *= 2 - strength;
+                    depth = 0.5f + 0.5f * strength;
+                }
+            }
+
+            if (!apply)
+                filt->active = false;
+            else if (!filt->active)
+                rpmFilterActivate(filt);
+
+            if (inBand) {
+                freq = constrainf(freq, lowHz, filt->maxHz);
+
+                // Notches for Roll,Pitch,Yaw
+                biquadFilter_t *R = &filt->notch[0];
+                biquadFilter_t *P = &filt->notch[1];
+                biquadFilter_t *Y = &filt->notch[2];
+
+                // Update the filter coefficients
+                biquadFilterUpdateNotch(R, freq, gyro.targetLooptime, notchQ);
+
+                if (adaptive) {
+                    // 2cos(w) for the Goertzel bin
+                    filt->gzCoeff = -R->b1 / R->b0;
+                    if (depth < 1.0f)
+                        biquadFilterSetNotchDepth(R, depth);
+                    trackedBank[trackedCount++] = bank;
+                }
+
+                // Transfer the filter coefficients from Roll axis filter into Pitch and Yaw
+                P->b0 = Y->b0 = R->b0;
+                P->b1 = Y->b1 = R->b1;
+                P->b2 = Y->b2 = R->b2;
+                P->a1 = Y->a1 = R->a1;
+                P->a2 = Y->a2 = R->a2;
+
+                if (filt->active)
+                    activeBank[activeCount++] = bank;
+            }
+
+            if (bank == currentBank) {
+                DEBUG_SET(DEBUG_RPM_FILTER, 0, currentBank);
+                DEBUG_SET(DEBUG_RPM_FILTER, 1, filt->active ? filt->motorIndex : 0);
+                DEBUG_SET(DEBUG_RPM_FILTER, 2, rpm);
+                DEBUG_SET(DEBUG_RPM_FILTER, 3, freq);
+
+                DEBUG_SET(DEBUG_RPM_ADAPTIVE, 0, currentBank);
+                DEBUG_SET(DEBUG_RPM_ADAPTIVE, 1, lrintf(filt->amplitude * 10));
+                DEBUG_SET(DEBUG_RPM_ADAPTIVE, 2, filt->active ? lrintf(depth * 100) : 0);
+                DEBUG_SET(DEBUG_RPM_ADAPTIVE, 3, lrintf(notchQ * 100));
+            }
+        }
+
+        activeBankCount = activeCount;
+        trackedBankCount = trackedCount;
+
+        // Show the next bank in debug
+        currentBank = (currentBank + 1) % bankCount;
     }
 }
 
@@ -25,6 +25,11 @@
 
 #define RPM_FILTER_BANK_COUNT 16
 
+typedef enum {
+    RPM_FILTER_MODE_MANUAL = 0,
+    RPM_FILTER_MODE_AUTO,
+} rpmFilterMode_e;
+
 typedef struct rpmFilteConfig_s
 {
     uint8_t  filter_bank_motor_index[RPM_FILTER_BANK_COUNT];    // Motor index
@@ -33,6 +38,17 @@ typedef struct rpmFilteConfig_s
     uint16_t filter_bank_min_hz[RPM_FILTER_BANK_COUNT];         // Filter minimum frequency
     uint16_t filter_bank_max_hz[RPM_FILTER_BANK_COUNT];         // Filter maximum frequency
 
+    uint8_t  filter_mode;                                       // Manual banks or automatic from the drivetrain
+    uint8_t  filter_auto_notches;                               // Max number of active automatic notches
+    uint16_t filter_auto_notch_q;                               // Automatic notch Q * 100
+    uint16_t filter_auto_min_hz;                                // Automatic notch minimum frequency
+    uint16_t filter_auto_max_hz;                                // Automatic notch maximum frequency
+    uint8_t  filter_auto_pinion_teeth;                          // Pinion teeth for the gear mesh notch, 0 = off
+
+    uint8_t  filter_adaptive;                                   // Adapt the notches to the measured harmonic amplitude
+    uint16_t filter_adaptive_min_amp;                           // Amplitude for bypassing a notch, deg/s * 10
+    uint16_t filter_adaptive_full_amp;                          // Amplitude for the full notch, deg/s * 10
+
 } rpmFilterConfig_t;
 
 
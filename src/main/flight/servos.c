@@ -40,6 +40,7 @@
 
 #include "flight/servos.h"
 #include "flight/mixer.h"
+#include "flight/pid.h"
 
 #include "pg/pg.h"
 #include "pg/pg_ids.h"
@@ -122,7 +123,7 @@ void servoInit(void)
         if (servoParams(i)->speed > 0) {
             float range = abs(servoParams(i)->rate);
             float speed = servoParams(i)->speed * 1000;
-            servoSpeed[i] = range * gyro.targetLooptime / speed;
+            servoSpeed[i] = range * pidGetSubtaskLooptime(PID_SUBTASK_SERVO) / speed;
         }
     }
 }
@@ -0,0 +1,293 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Vibration spectrum analyser
+ *
+ * Gyro and accelerometer samples are decimated by averaging and captured
+ * in frames of SPECTRUM_FFT_SIZE samples. Completed frames are analysed in
+ * a background task, one axis per run, and the power spectra are averaged
+ * into buckets by the headspeed at the end of the capture. While a frame
+ * is being analysed, the incoming samples are dropped.
+ *
+ * The spectra are read over MSP for vibration-vs-RPM plots.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "platform.h"
+
+#ifdef USE_SPECTRUM_ANALYSER
+
+#include "arm_math.h"
+
+#include "common/axis.h"
+#include "common/maths.h"
+#include "common/utils.h"
+
+#include "fc/runtime_config.h"
+
+#include "pg/pg.h"
+#include "pg/pg_ids.h"
+
+#include "sensors/acceleration.h"
+#include "sensors/gyro.h"
+#include "sensors/sensors.h"
+
+#include "flight/governor.h"
+#include "flight/spectrum.h"
+
+
+// Number of frames in the running average of each bucket
+#define SPECTRUM_AVERAGE_FRAMES     64
+
+typedef struct {
+    uint16_t sampleRateHz;
+    uint8_t  decimation;
+    uint8_t  sampleCount;
+    float    accumulator[XYZ_AXIS_COUNT];
+    uint8_t  frameIndex;
+    uint8_t  frameBucket;
+    bool     frameReady;
+    float    frame[XYZ_AXIS_COUNT][SPECTRUM_FFT_SIZE];
+} spectrumCapture_t;
+
+typedef struct {
+    uint16_t frames;
+    float    power[XYZ_AXIS_COUNT][SPECTRUM_BIN_COUNT];
+} spectrumBucket_t;
+
+static bool spectrumEnabled;
+
+static uint16_t spectrumBucketRpm;
+
+static uint8_t spectrumSensor;
+static uint8_t spectrumAxis;
+
+static spectrumCapture_t spectrumCapture[SPECTRUM_SENSOR_COUNT];
+static spectrumBucket_t spectrumBucket[SPECTRUM_SENSOR_COUNT][SPECTRUM_BUCKET_COUNT];
+
+static arm_rfft_fast_instance_f32 fftInstance;
+static float fftInput[SPECTRUM_FFT_SIZE];
+static float fftOutput[SPECTRUM_FFT_SIZE];
+
+static float hanningWindow[SPECTRUM_FFT_SIZE];
+static float windowPowerScale;
+
+
+PG_REGISTER_WITH_RESET_TEMPLATE(spectrumConfig_t, spectrumConfig, PG_SPECTRUM_CONFIG, 0);
+
+PG_RESET_TEMPLATE(spectrumConfig_t, spectrumConfig,
+    .spectrum_max_hz = 500,
+    .spectrum_bucket_rpm = 500,
+);
+
+
+//// Sample capture
+
+static int spectrumHeadSpeedBucket(void)
+{
+    return constrain(lrintf(getHeadSpeed()) / spectrumBucketRpm, 0, SPECTRUM_BUCKET_COUNT - 1);
+}
+
+static FAST_CODE void spectrumCaptureSample(spectrumCapture_t *capture)
+{
+    if (++capture->sampleCount < capture->decimation)
+        return;
+
+    if (!capture->frameReady) {
+        const float scale = 1.0f / capture->sampleCount;
+
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            capture->frame[axis][capture->frameIndex] = capture->accumulator[axis] * scale;
+        }
+
+        if (++capture->frameIndex == SPECTRUM_FFT_SIZE) {
+            capture->frameBucket = spectrumHeadSpeedBucket();
+            capture->frameReady = true;
+        }
+    }
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        capture->accumulator[axis] = 0;
+    }
+
+    capture->sampleCount = 0;
+}
+
+FAST_CODE void spectrumGyroPush(int axis, float sample)
+{
+    spectrumCapture[SPECTRUM_SENSOR_GYRO].accumulator[axis] += sample;
+}
+
+FAST_CODE void spectrumGyroUpdate(void)
+{
+    if (spectrumEnabled) {
+        spectrumCaptureSample(&spectrumCapture[SPECTRUM_SENSOR_GYRO]);
+    }
+}
+
+void spectrumAccUpdate(const float *sample)
+{
+    spectrumCapture_t *capture = &spectrumCapture[SPECTRUM_SENSOR_ACC];
+
+    if (spectrumEnabled && capture->sampleRateHz) {
+        // Accelerometer spectrum in mg
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            capture->accumulator[axis] += sample[axis] * acc.dev.acc_1G_rec * 1000;
+        }
+        spectrumCaptureSample(capture);
+    }
+}
+
+
+//// Spectrum analysis
+
+static void spectrumAnalyseAxis(const spectrumCapture_t *capture, spectrumBucket_t *bucket, int axis)
+{
+    const float *frame = capture->frame[axis];
+
+    // The mean would leak from the DC bin into the lowest bins through the window
+    float mean;
+    arm_mean_f32((float *)frame, SPECTRUM_FFT_SIZE, &mean);
+
+    for (int i = 0; i < SPECTRUM_FFT_SIZE; i++) {
+        fftInput[i] = (frame[i] - mean) * hanningWindow[i];
+    }
+
+    arm_rfft_fast_f32(&fftInstance, fftInput, fftOutput, 0);
+
+    // Packed DC and Nyquist components
+    fftOutput[0] = 0;
+    fftOutput[1] = 0;
+
+    arm_cmplx_mag_squared_f32(fftOutput, fftInput, SPECTRUM_BIN_COUNT);
+
+    // Running average over the last frames, plain mean until the bucket fills up
+    const float weight = 1.0f / MIN(bucket->frames + 1, SPECTRUM_AVERAGE_FRAMES);
+
+    for (int bin = 0; bin < SPECTRUM_BIN_COUNT; bin++) {
+        bucket->power[axis][bin] += weight * (fftInput[bin] * windowPowerScale - bucket->power[axis][bin]);
+    }
+}
+
+void spectrumUpdate(timeUs_t currentTimeUs)
+{
+    UNUSED(currentTimeUs);
+
+    spectrumCapture_t *capture = &spectrumCapture[spectrumSensor];
+
+    if (capture->frameReady) {
+        spectrumBucket_t *bucket = &spectrumBucket[spectrumSensor][capture->frameBucket];
+
+        spectrumAnalyseAxis(capture, bucket, spectrumAxis);
+
+        if (++spectrumAxis < XYZ_AXIS_COUNT)
+            return;
+
+        if (bucket->frames < UINT16_MAX)
+            bucket->frames++;
+
+        spectrumAxis = 0;
+
+        capture->frameIndex = 0;
+        capture->frameReady = false;
+    }
+
+    spectrumSensor = (spectrumSensor + 1) % SPECTRUM_SENSOR_COUNT;
+}
+
+
+//// Access functions
+
+bool spectrumIsEnabled(void)
+{
+    return spectrumEnabled;
+}
+
+uint16_t spectrumGetSampleRate(spectrumSensor_e sensor)
+{
+    return spectrumCapture[sensor].sampleRateHz;
+}
+
+uint16_t spectrumGetFrameCount(spectrumSensor_e sensor, int bucket)
+{
+    return spectrumBucket[sensor][bucket].frames;
+}
+
+float spectrumGetAmplitude(spectrumSensor_e sensor, int bucket, int axis, int bin)
+{
+    return sqrtf(spectrumBucket[sensor][bucket].power[axis][bin]);
+}
+
+
+//// Init functions
+
+static void spectrumCaptureInit(spectrumCapture_t *capture, uint32_t rateHz, uint16_t maxHz)
+{
+    memset(capture, 0, sizeof(spectrumCapture_t));
+
+    if (rateHz) {
+        capture->decimation = constrain(rateHz / (2 * maxHz), 1, UINT8_MAX);
+        capture->sampleRateHz = rateHz / capture->decimation;
+    }
+}
+
+void spectrumReset(void)
+{
+    memset(spectrumBucket, 0, sizeof(spectrumBucket));
+
+    for (int sensor = 0; sensor < SPECTRUM_SENSOR_COUNT; sensor++) {
+        spectrumCapture[sensor].frameIndex = 0;
+        spectrumCapture[sensor].frameReady = false;
+    }
+
+    spectrumSensor = 0;
+    spectrumAxis = 0;
+}
+
+void spectrumInit(void)
+{
+    const uint16_t maxHz = spectrumConfig()->spectrum_max_hz;
+
+    if (maxHz == 0 || !sensors(SENSOR_GYRO))
+        return;
+
+    spectrumCaptureInit(&spectrumCapture[SPECTRUM_SENSOR_GYRO], 1e6f / gyro.targetLooptime, maxHz);
+    spectrumCaptureInit(&spectrumCapture[SPECTRUM_SENSOR_ACC], sensors(SENSOR_ACC) ? acc.sampleRateHz : 0, maxHz);
+
+    spectrumBucketRpm = MAX(1, spectrumConfig()->spectrum_bucket_rpm);
+
+    arm_rfft_fast_init_f32(&fftInstance, SPECTRUM_FFT_SIZE);
+
+    // Periodic Hann window, scaled to give the amplitude of a sine wave
+    float windowSum = 0;
+    for (int i = 0; i < SPECTRUM_FFT_SIZE; i++) {
+        hanningWindow[i] = 0.5f - 0.5f * cos_approx(2 * M_PIf * i / SPECTRUM_FFT_SIZE);
+        windowSum += hanningWindow[i];
+    }
+    windowPowerScale = sq(2.0f / windowSum);
+
+    spectrumReset();
+
+    spectrumEnabled = true;
+}
+
+#endif /* USE_SPECTRUM_ANALYSER */
@@ -0,0 +1,58 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "platform.h"
+
+#include "common/time.h"
+
+#include "pg/pg.h"
+
+
+#define SPECTRUM_FFT_SIZE           128
+#define SPECTRUM_BIN_COUNT          (SPECTRUM_FFT_SIZE / 2)
+#define SPECTRUM_BUCKET_COUNT       8
+
+typedef enum {
+    SPECTRUM_SENSOR_GYRO = 0,
+    SPECTRUM_SENSOR_ACC,
+    SPECTRUM_SENSOR_COUNT
+} spectrumSensor_e;
+
+typedef struct spectrumConfig_s {
+    uint16_t spectrum_max_hz;           // Highest analysed frequency, 0 = disabled
+    uint16_t spectrum_bucket_rpm;       // Width of the headspeed buckets
+} spectrumConfig_t;
+
+PG_DECLARE(spectrumConfig_t, spectrumConfig);
+
+
+void spectrumInit(void);
+void spectrumReset(void);
+
+bool spectrumIsEnabled(void);
+
+void spectrumGyroPush(int axis, float sample);
+void spectrumGyroUpdate(void);
+void spectrumAccUpdate(const float *sample);
+
+void spectrumUpdate(timeUs_t currentTimeUs);
+
+uint16_t spectrumGetSampleRate(spectrumSensor_e sensor);
+uint16_t spectrumGetFrameCount(spectrumSensor_e sensor, int bucket);
+float spectrumGetAmplitude(spectrumSensor_e sensor, int bucket, int axis, int bin);
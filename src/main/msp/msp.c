@@ -35,6 +35,7 @@
 #include "build/version.h"
 
 #include "cli/cli.h"
+#include "cli/settings.h"
 
 #include "common/axis.h"
 #include "common/bitarray.h"
@@ -86,6 +87,7 @@
 #include "flight/servos.h"
 #include "flight/position.h"
 #include "flight/rpm_filter.h"
+#include "flight/spectrum.h"
 
 #include "io/asyncfatfs/asyncfatfs.h"
 #include "io/beeper.h"
@@ -226,6 +228,10 @@ static bool mspIsMspArmingEnabled(void)
 
 #define MSP_PASSTHROUGH_ESC_4WAY 0xff
 
+// MSP_RPM_FILTER: legacy bank arrays, followed by the automatic and adaptive filter fields
+#define MSP_RPM_FILTER_BANKS_SIZE   (RPM_FILTER_BANK_COUNT * 9)
+#define MSP_RPM_FILTER_AUTO_SIZE    15
+
 static uint8_t mspPassthroughMode;
 static uint8_t mspPassthroughArgument;
 
@@ -377,6 +383,44 @@ static void mspRebootFn(serialPort_t *serialPort)
     while (true) ;
 }
 
+#ifdef USE_SPECTRUM_ANALYSER
+static void serializeSpectrumSummaryReply(sbuf_t *dst)
+{
+    sbufWriteU16(dst, SPECTRUM_FFT_SIZE);
+    sbufWriteU8(dst, SPECTRUM_BIN_COUNT);
+    sbufWriteU8(dst, SPECTRUM_BUCKET_COUNT);
+    sbufWriteU16(dst, spectrumConfig()->spectrum_bucket_rpm);
+
+    for (int sensor = 0; sensor < SPECTRUM_SENSOR_COUNT; sensor++) {
+        sbufWriteU16(dst, spectrumGetSampleRate(sensor));
+        for (int bucket = 0; bucket < SPECTRUM_BUCKET_COUNT; bucket++) {
+            sbufWriteU16(dst, spectrumGetFrameCount(sensor, bucket));
+        }
+    }
+}
+
+/*
+ * Amplitudes are sent in 0.5dB steps above 0.001 deg/s or 0.001 mg,
+ * i.e. 40 * log10(amplitude / 0.001), saturated to 0..255.
+ */
+static void serializeSpectrumReply(sbuf_t *dst, spectrumSensor_e sensor, int bucket)
+{
+    sbufWriteU8(dst, sensor);
+    sbufWriteU8(dst, bucket);
+    sbufWriteU16(dst, spectrumGetFrameCount(sensor, bucket));
+    sbufWriteU16(dst, spectrumGetSampleRate(sensor));
+    sbufWriteU8(dst, SPECTRUM_BIN_COUNT);
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        for (int bin = 0; bin < SPECTRUM_BIN_COUNT; bin++) {
+            const float amplitude = spectrumGetAmplitude(sensor, bucket, axis, bin) * 1000;
+            const int level = (amplitude > 1) ? lrintf(17.3717793f * log_approx(amplitude)) : 0;
+            sbufWriteU8(dst, constrain(level, 0, UINT8_MAX));
+        }
+    }
+}
+#endif
+
 static void serializeSDCardSummaryReply(sbuf_t *dst)
 {
     uint8_t flags = 0;
@@ -1714,7 +1758,31 @@ static bool mspProcessOutCommand(int16_t cmdMSP, sbuf_t *dst)
 
         break;
     case MSP_RPM_FILTER:
-        sbufWriteData(dst, rpmFilterConfig(), sizeof(rpmFilterConfig_t));
+        for (int i = 0; i < RPM_FILTER_BANK_COUNT; i++) {
+            sbufWriteU8(dst, rpmFilterConfig()->filter_bank_motor_index[i]);
+        }
+        for (int i = 0; i < RPM_FILTER_BANK_COUNT; i++) {
+            sbufWriteU16(dst, rpmFilterConfig()->filter_bank_gear_ratio[i]);
+        }
+        for (int i = 0; i < RPM_FILTER_BANK_COUNT; i++) {
+            sbufWriteU16(dst, rpmFilterConfig()->filter_bank_notch_q[i]);
+        }
+        for (int i = 0; i < RPM_FILTER_BANK_COUNT; i++) {
+            sbufWriteU16(dst, rpmFilterConfig()->filter_bank_min_hz[i]);
+        }
+        for (int i = 0; i < RPM_FILTER_BANK_COUNT; i++) {
+            sbufWriteU16(dst, rpmFilterConfig()->filter_bank_max_hz[i]);
+        }
+        // Added after the bank arrays
+        sbufWriteU8(dst, rpmFilterConfig()->filter_mode);
+        sbufWriteU8(dst, rpmFilterConfig()->filter_auto_notches);
+        sbufWriteU16(dst, rpmFilterConfig()->filter_auto_notch_q);
+        sbufWriteU16(dst, rpmFilterConfig()->filter_auto_min_hz);
+        sbufWriteU16(dst, rpmFilterConfig()->filter_auto_max_hz);
+        sbufWriteU8(dst, rpmFilterConfig()->filter_auto_pinion_teeth);
+        sbufWriteU8(dst, rpmFilterConfig()->filter_adaptive);
+        sbufWriteU16(dst, rpmFilterConfig()->filter_adaptive_min_amp);
+        sbufWriteU16(dst, rpmFilterConfig()->filter_adaptive_full_amp);
 
         break;
     case MSP_PID_ADVANCED:
@@ -1908,6 +1976,300 @@ static bool mspProcessOutCommand(int16_t cmdMSP, sbuf_t *dst)
     return !unsupportedCommand;
 }
 
+// Read the setting identifier of MSP2_COMMON_SETTING and MSP2_COMMON_SET_SETTING.
+// Returns NULL if the setting does not exist.
+static const clivalue_t *mspReadSettingId(sbuf_t *src)
+{
+    const char *name = (const char *)sbufPtr(src);
+    const int available = sbufBytesRemaining(src);
+
+    int length = 0;
+    while (length < available && name[length]) {
+        length++;
+    }
+    if (length == available || length > UINT8_MAX) {
+        return NULL;
+    }
+    sbufAdvance(src, length + 1);
+
+    uint16_t index;
+    if (length > 0) {
+        index = findSettingIndex(name, length);
+    } else if (sbufBytesRemaining(src) >= 2) {
+        index = sbufReadU16(src);
+    } else {
+        return NULL;
+    }
+
+    return index < valueTableEntryCount ? &valueTable[index] : NULL;
+}
+
+static uint8_t *mspSettingPointer(const clivalue_t *value)
+{
+    const pgRegistry_t *reg = pgFind(value->pgn);
+    if (!reg) {
+        return NULL;
+    }
+
+    unsigned offset = value->offset;
+    switch (value->type & VALUE_SECTION_MASK) {
+    case PROFILE_VALUE:
+        offset += sizeof(pidProfile_t) * getCurrentPidProfileIndex();
+        break;
+    case PROFILE_RATE_VALUE:
+        offset += sizeof(controlRateConfig_t) * getCurrentControlRateProfileIndex();
+        break;
+    }
+
+    return reg->address + offset;
+}
+
+static unsigned mspSettingElementSize(const clivalue_t *value)
+{
+    switch (value->type & VALUE_TYPE_MASK) {
+    case VAR_UINT16:
+    case VAR_INT16:
+        return 2;
+    case VAR_UINT32:
+        return 4;
+    default:
+        return 1;
+    }
+}
+
+static uint32_t mspSettingWord(const clivalue_t *value, const uint8_t *ptr)
+{
+    switch (value->type & VALUE_TYPE_MASK) {
+    case VAR_UINT16:
+        return *(const uint16_t *)ptr;
+    case VAR_INT16:
+        return *(const int16_t *)ptr;
+    case VAR_UINT32:
+        return *(const uint32_t *)ptr;
+    case VAR_INT8:
+        return *(const int8_t *)ptr;
+    default:
+        return *ptr;
+    }
+}
+
+static void mspSetSettingWord(const clivalue_t *value, uint8_t *ptr, uint32_t word)
+{
+    switch (mspSettingElementSize(value)) {
+    case 2:
+        *(uint16_t *)ptr = word;
+        break;
+    case 4:
+        *(uint32_t *)ptr = word;
+        break;
+    default:
+        *ptr = word;
+        break;
+    }
+}
+
+static unsigned mspSettingValueSize(const clivalue_t *value)
+{
+    switch (value->type & VALUE_MODE_MASK) {
+    case MODE_ARRAY:
+        return mspSettingElementSize(value) * value->config.array.length;
+    case MODE_STRING:
+        return value->config.string.maxlength;
+    case MODE_BITSET:
+        return 1;
+    default:
+        return mspSettingElementSize(value);
+    }
+}
+
+static bool mspWriteSettingValue(sbuf_t *dst, const clivalue_t *value)
+{
+    const uint8_t *ptr = mspSettingPointer(value);
+    if (!ptr) {
+        return false;
+    }
+
+    if ((value->type & VALUE_MODE_MASK) == MODE_BITSET) {
+        sbufWriteU8(dst, (mspSettingWord(value, ptr) >> value->config.bitpos) & 1);
+    } else {
+        sbufWriteData(dst, ptr, mspSettingValueSize(value));
+    }
+
+    return true;
+}
+
+// Read a new value for the setting from src, with the same checks as the CLI
+static bool mspReadSettingValue(sbuf_t *src, const clivalue_t *value)
+{
+    uint8_t *ptr = mspSettingPointer(value);
+    if (!ptr) {
+        return false;
+    }
+
+    const unsigned size = mspSettingElementSize(value);
+    const int available = sbufBytesRemaining(src);
+
+    switch (value->type & VALUE_MODE_MASK) {
+    case MODE_ARRAY: {
+            const int length = size * value->config.array.length;
+            if (available < length) {
+                return false;
+            }
+            sbufReadData(src, ptr, length);
+            sbufAdvance(src, length);
+        }
+        break;
+    case MODE_STRING: {
+            const cliStringLengthConfig_t *config = &value->config.string;
+            int length = 0;
+            while (length < available && sbufConstPtr(src)[length]) {
+                length++;
+            }
+            const bool updatable = (config->flags & STRING_FLAGS_WRITEONCE) == 0
+                || ptr[0] == 0 || strncmp((const char *)sbufConstPtr(src), (const char *)ptr, length) == 0;
+            if (!updatable || length > config->maxlength) {
+                return false;
+            }
+            // shorter than the minimum clears the string, like '-' in the CLI
+            memset(ptr, 0, config->maxlength);
+            if (length >= config->minlength) {
+                sbufReadData(src, ptr, length);
+            }
+            sbufAdvance(src, MIN(length + 1, available));
+        }
+        break;
+    case MODE_BITSET: {
+            if (available < 1) {
+                return false;
+            }
+            const uint32_t mask = 1 << value->config.bitpos;
+            uint32_t word = mspSettingWord(value, ptr);
+            word = sbufReadU8(src) ? (word | mask) : (word & ~mask);
+            mspSetSettingWord(value, ptr, word);
+        }
+        break;
+    case MODE_LOOKUP:
+    case MODE_DIRECT: {
+            if (available < (int)size) {
+                return false;
+            }
+            uint8_t data[4];
+            sbufReadData(src, data, size);
+            sbufAdvance(src, size);
+
+            const uint32_t word = mspSettingWord(value, data);
+            if ((value->type & VALUE_MODE_MASK) == MODE_LOOKUP) {
+                if (word >= lookupTables[value->config.lookup.tableIndex].valueCount) {
+                    return false;
+                }
+            } else if ((value->type & VALUE_TYPE_MASK) == VAR_UINT32) {
+                if (word > value->config.u32Max) {
+                    return false;
+                }
+            } else {
+                int min, max;
+                getSettingMinMax(value, &min, &max);
+                if ((int32_t)word < min || (int32_t)word > max) {
+                    return false;
+                }
+            }
+            mspSetSettingWord(value, ptr, word);
+        }
+        break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+// Item ids of MSP_SETTINGS and MSP_SET_SETTINGS. A setting index, or a
+// parameter group number with MSP_SETTINGS_PG_FLAG set.
+#define MSP_SETTINGS_PG_FLAG    0x8000
+#define MSP_SETTINGS_PG_MASK    0x0FFF
+
+// Reply with the values of the requested items, in request order. Each
+// setting is sent in its native size, each PG as U8 version, U16 size and
+// the data. The reply starts with the number of items that fitted, the
+// client requests the rest again. This keeps the replies within the
+// buffers of the MSP telemetry tunnels.
+static mspResult_e mspSerializeSettings(sbuf_t *src, sbuf_t *dst)
+{
+    uint8_t *countPtr = sbufPtr(dst);
+    uint8_t count = 0;
+
+    sbufWriteU8(dst, 0);
+
+    while (sbufBytesRemaining(src) >= 2 && count < UINT8_MAX) {
+        const uint16_t id = sbufReadU16(src);
+
+        if (id & MSP_SETTINGS_PG_FLAG) {
+            const pgRegistry_t *reg = pgFind(id & MSP_SETTINGS_PG_MASK);
+            if (!reg) {
+                return MSP_RESULT_ERROR;
+            }
+            if (sbufBytesRemaining(dst) < 3 + pgSize(reg)) {
+                break;
+            }
+            sbufWriteU8(dst, pgVersion(reg));
+            sbufWriteU16(dst, pgSize(reg));
+            sbufWriteData(dst, reg->address, pgSize(reg));
+        } else {
+            if (id >= valueTableEntryCount) {
+                return MSP_RESULT_ERROR;
+            }
+            const clivalue_t *value = &valueTable[id];
+            if (sbufBytesRemaining(dst) < (int)mspSettingValueSize(value)) {
+                break;
+            }
+            if (!mspWriteSettingValue(dst, value)) {
+                return MSP_RESULT_ERROR;
+            }
+        }
+
+        count++;
+    }
+
+    // a first item that never fits would stall the client
+    if (count == 0 && sbufBytesRemaining(src) >= 2) {
+        return MSP_RESULT_ERROR;
+    }
+
+    *countPtr = count;
+
+    return MSP_RESULT_ACK;
+}
+
+// Set the values of a list of items, each id followed by the value in the
+// format of MSP_SETTINGS. Processing stops at the first invalid item, the
+// items before it stay applied.
+static mspResult_e mspReadSettings(sbuf_t *src)
+{
+    while (sbufBytesRemaining(src) >= 2) {
+        const uint16_t id = sbufReadU16(src);
+
+        if (id & MSP_SETTINGS_PG_FLAG) {
+            const pgRegistry_t *reg = pgFind(id & MSP_SETTINGS_PG_MASK);
+            if (!reg || sbufBytesRemaining(src) < 3) {
+                return MSP_RESULT_ERROR;
+            }
+            const uint8_t version = sbufReadU8(src);
+            const uint16_t size = sbufReadU16(src);
+            if (version != pgVersion(reg) || size != pgSize(reg) || sbufBytesRemaining(src) < size) {
+                return MSP_RESULT_ERROR;
+            }
+            sbufReadData(src, reg->address, size);
+            sbufAdvance(src, size);
+        } else {
+            if (id >= valueTableEntryCount || !mspReadSettingValue(src, &valueTable[id])) {
+                return MSP_RESULT_ERROR;
+            }
+        }
+    }
+
+    return MSP_RESULT_ACK;
+}
+
 static mspResult_e mspFcProcessOutCommandWithArg(mspDescriptor_t srcDesc, int16_t cmdMSP, sbuf_t *src, sbuf_t *dst, mspPostProcessFnPtr *mspPostProcessFn)
 {
 
@@ -2065,6 +2427,37 @@ static mspResult_e mspFcProcessOutCommandWithArg(mspDescriptor_t srcDesc, int16_
         }
 
         break;
+#ifdef USE_SPECTRUM_ANALYSER
+    case MSP_SPECTRUM:
+        if (sbufBytesRemaining(src) >= 2) {
+            const uint8_t sensor = sbufReadU8(src);
+            const uint8_t bucket = sbufReadU8(src);
+
+            if (sensor >= SPECTRUM_SENSOR_COUNT || bucket >= SPECTRUM_BUCKET_COUNT) {
+                return MSP_RESULT_ERROR;
+            }
+
+            serializeSpectrumReply(dst, sensor, bucket);
+        } else {
+            serializeSpectrumSummaryReply(dst);
+        }
+        break;
+#endif
+    case MSP2_COMMON_SETTING:
+        {
+            const clivalue_t *value = mspReadSettingId(src);
+            if (!value) {
+                return MSP_RESULT_ERROR;
+            }
+
+            sbufWriteU16(dst, value - valueTable);
+            if (!mspWriteSettingValue(dst, value)) {
+                return MSP_RESULT_ERROR;
+            }
+        }
+        break;
+    case MSP_SETTINGS:
+        return mspSerializeSettings(src, dst);
     default:
         return MSP_RESULT_CMD_UNKNOWN;
     }
@@ -2542,9 +2935,44 @@ static mspResult_e mspProcessInCommand(mspDescriptor_t srcDesc, int16_t cmdMSP,
 
         break;
     case MSP_SET_RPM_FILTER:
-        sbufReadData(src, rpmFilterConfigMutable(), sizeof(rpmFilterConfig_t));
+        if (dataSize < MSP_RPM_FILTER_BANKS_SIZE) {
+            return MSP_RESULT_ERROR;
+        }
+        for (int i = 0; i < RPM_FILTER_BANK_COUNT; i++) {
+            rpmFilterConfigMutable()->filter_bank_motor_index[i] = sbufReadU8(src);
+        }
+        for (int i = 0; i < RPM_FILTER_BANK_COUNT; i++) {
+            rpmFilterConfigMutable()->filter_bank_gear_ratio[i] = sbufReadU16(src);
+        }
+        for (int i = 0; i < RPM_FILTER_BANK_COUNT; i++) {
+            rpmFilterConfigMutable()->filter_bank_notch_q[i] = sbufReadU16(src);
+        }
+        for (int i = 0; i < RPM_FILTER_BANK_COUNT; i++) {
+            rpmFilterConfigMutable()->filter_bank_min_hz[i] = sbufReadU16(src);
+        }
+        for (int i = 0; i < RPM_FILTER_BANK_COUNT; i++) {
+            rpmFilterConfigMutable()->filter_bank_max_hz[i] = sbufReadU16(src);
+        }
+        // Older configurators send the bank arrays only
+        if (sbufBytesRemaining(src) >= MSP_RPM_FILTER_AUTO_SIZE) {
+            rpmFilterConfigMutable()->filter_mode = sbufReadU8(src);
+            rpmFilterConfigMutable()->filter_auto_notches = sbufReadU8(src);
+            rpmFilterConfigMutable()->filter_auto_notch_q = sbufReadU16(src);
+            rpmFilterConfigMutable()->filter_auto_min_hz = sbufReadU16(src);
+            rpmFilterConfigMutable()->filter_auto_max_hz = sbufReadU16(src);
+            rpmFilterConfigMutable()->filter_auto_pinion_teeth = sbufReadU8(src);
+            rpmFilterConfigMutable()->filter_adaptive = sbufReadU8(src);
+            rpmFilterConfigMutable()->filter_adaptive_min_amp = sbufReadU16(src);
+            rpmFilterConfigMutable()->filter_adaptive_full_amp = sbufReadU16(src);
+        }
 
         break;
+#ifdef USE_SPECTRUM_ANALYSER
+    case MSP_RESET_SPECTRUM:
+        spectrumReset();
+
+        break;
+#endif
     case MSP_SET_PID_ADVANCED:
         sbufReadU16(src);
         sbufReadU16(src);
@@ -2671,7 +3099,9 @@ static mspResult_e mspProcessInCommand(mspDescriptor_t srcDesc, int16_t cmdMSP,
         break;
     case MSP_EEPROM_WRITE:
         if (ARMING_FLAG(ARMED)) {
-            return MSP_RESULT_ERROR;
+            // Journal the changes in the background, the live config is already current
+            writeEEPROMAsync();
+            break;
         }
 
         writeEEPROM();
@@ -3094,6 +3524,17 @@ static mspResult_e mspProcessInCommand(mspDescriptor_t srcDesc, int16_t cmdMSP,
             }
         }
         break;
+    case MSP_SET_SETTINGS:
+        return mspReadSettings(src);
+
+    case MSP2_COMMON_SET_SETTING: {
+        const clivalue_t *value = mspReadSettingId(src);
+        if (!value || !mspReadSettingValue(src, value)) {
+            return MSP_RESULT_ERROR;
+        }
+        break;
+    }
+
     case MSP2_COMMON_SET_SERIAL_CONFIG: {
         if (dataSize < 1) {
             return MSP_RESULT_ERROR;
@@ -3516,6 +3957,12 @@ mspResult_e mspFcProcessCommand(mspDescriptor_t srcDesc, mspPacket_t *cmd, mspPa
     return ret;
 }
 
+// Only commands without arguments and side effects can be streamed
+bool mspFcProcessStreamCommand(int16_t cmdMSP, sbuf_t *dst)
+{
+    return mspCommonProcessOutCommand(cmdMSP, dst, NULL) || mspProcessOutCommand(cmdMSP, dst);
+}
+
 void mspFcProcessReply(mspPacket_t *reply)
 {
     sbuf_t *src = &reply->buf;
@@ -96,6 +96,7 @@ static const box_t boxes[CHECKBOX_ITEM_COUNT] = {
     { BOXGPSRESCUE, "GPS RESCUE", 46 },
     { BOXACROTRAINER, "ACRO TRAINER", 47 },
     { BOXVTXCONTROLDISABLE, "DISABLE VTX CONTROL", 48},
+    { BOXGOVTUNE, "GOVERNOR AUTOTUNE", 49 },
 };
 
 // mask of enabled IDs, calculated on startup based on enabled features. boxId_e is used as bit index
@@ -246,6 +247,10 @@ void initActiveBoxIds(void)
 
     BME(BOXPARALYZE);
 
+    if (featureIsEnabled(FEATURE_GOVERNOR)) {
+        BME(BOXGOVTUNE);
+    }
+
 #ifdef USE_PINIOBOX
     // Turn BOXUSERx only if pinioBox facility monitors them, as the facility is the only BOXUSERx observer.
     // Note that pinioBoxConfig can be set to monitor any box.
@@ -348,6 +348,10 @@
 #define MSP_SET_GOVERNOR         143    //in message          Sets the governor configuration
 #define MSP_RPM_FILTER           144    //out message         Gets RPM filter configuration
 #define MSP_SET_RPM_FILTER       145    //in message          Sets RPM filter configuration
+#define MSP_SPECTRUM             146    //out message         Gets the vibration spectrum of a sensor and headspeed bucket
+#define MSP_RESET_SPECTRUM       147    //in message          Clears the vibration spectra
+#define MSP_SETTINGS             148    //in/out message      Gets the values of a list of settings and parameter groups
+#define MSP_SET_SETTINGS         149    //in message          Sets the values of a list of settings and parameter groups
 
 #define MSP_MIXER_INPUTS         170    //out message         Gets the generic mixer inputs
 #define MSP_SET_MIXER_INPUTS     171    //in message          Sets the generic mixer inputs
@@ -18,5 +18,18 @@
  * If not, see <http://www.gnu.org/licenses/>.
  */
 
+// Setting access by CLI name. The setting is given as a null terminated
+// name, or as a zero byte followed by the U16 setting index. The value is
+// sent in the native size of the setting, little endian.
+#define MSP2_COMMON_SETTING             0x1003  //in/out message    Returns the index and value of a setting
+#define MSP2_COMMON_SET_SETTING         0x1004  //in message        Sets the value of a setting
+
+// Subscribes the port to a stream of replies: U16 rate [Hz], then up to
+// MSP_STREAM_MAX_COMMANDS U16 command ids, rate 0 stops the stream. The FC
+// pushes the replies in frames with this command id, each reply as U16
+// command, U16 size and the reply data. The stream stops when the port has
+// received nothing for 5s, so the subscriber needs to keep talking.
+#define MSP2_COMMON_SET_STREAM          0x1005  //in/out message    Sets the MSP reply stream of the port
+
 #define MSP2_COMMON_SERIAL_CONFIG       0x1009
 #define MSP2_COMMON_SET_SERIAL_CONFIG   0x100A
@@ -37,11 +37,46 @@
 #include "io/displayport_msp.h"
 
 #include "msp/msp.h"
+#include "msp/msp_protocol_v2_common.h"
 
 #include "msp_serial.h"
 
+#include "scheduler/scheduler.h"
+
+#define JUMBO_FRAME_SIZE_LIMIT 255
+
+// Pipelined commands processed per port and call, within the time budget
+#define MSP_SERIAL_COMMANDS_PER_CALL    8
+#define MSP_SERIAL_TIME_BUDGET_US       500
+// A reply not fitting into the TX buffer waits this long for it to drain
+#define MSP_SERIAL_REPLY_TIMEOUT_MS     100
+// A reply stream stops when nothing has been received on its port this long
+#define MSP_STREAM_TIMEOUT_MS           5000
+
 static mspPort_t mspPorts[MAX_MSP_PORT_COUNT];
 
+static uint8_t mspSerialOutBuf[MSP_PORT_OUTBUF_SIZE];
+static uint8_t mspStreamBuf[MSP_STREAM_FRAME_SIZE];
+
+// Reply held in mspSerialOutBuf until the TX buffer of its port has room
+static mspPort_t *mspPendingReplyPort;
+static mspPacket_t mspPendingReply;
+static timeMs_t mspPendingReplyMs;
+
+// Run the stream task only while some port has a reply stream
+static void mspSerialUpdateStreamTask(void)
+{
+    bool streaming = false;
+
+    for (uint8_t portIndex = 0; portIndex < MAX_MSP_PORT_COUNT; portIndex++) {
+        if (mspPorts[portIndex].port && mspPorts[portIndex].streamCount) {
+            streaming = true;
+        }
+    }
+
+    setTaskEnabled(TASK_MSP_STREAM, streaming);
+}
+
 static void resetMspPort(mspPort_t *mspPortToReset, serialPort_t *serialPort, bool sharedWithTelemetry)
 {
     memset(mspPortToReset, 0, sizeof(mspPort_t));
@@ -80,10 +115,15 @@ void mspSerialReleasePortIfAllocated(serialPort_t *serialPort)
     for (uint8_t portIndex = 0; portIndex < MAX_MSP_PORT_COUNT; portIndex++) {
         mspPort_t *candidateMspPort = &mspPorts[portIndex];
         if (candidateMspPort->port == serialPort) {
+            if (mspPendingReplyPort == candidateMspPort) {
+                mspPendingReplyPort = NULL;
+            }
             closeSerialPort(serialPort);
             memset(candidateMspPort, 0, sizeof(mspPort_t));
         }
     }
+
+    mspSerialUpdateStreamTask();
 }
 
 #if defined(USE_TELEMETRY)
@@ -91,10 +131,15 @@ void mspSerialReleaseSharedTelemetryPorts(void) {
     for (uint8_t portIndex = 0; portIndex < MAX_MSP_PORT_COUNT; portIndex++) {
         mspPort_t *candidateMspPort = &mspPorts[portIndex];
         if (candidateMspPort->sharedWithTelemetry) {
+            if (mspPendingReplyPort == candidateMspPort) {
+                mspPendingReplyPort = NULL;
+            }
             closeSerialPort(candidateMspPort->port);
             memset(candidateMspPort, 0, sizeof(mspPort_t));
         }
     }
+
+    mspSerialUpdateStreamTask();
 }
 #endif
 
@@ -281,7 +326,6 @@ static uint8_t mspSerialChecksumBuf(uint8_t checksum, const uint8_t *data, int l
     return checksum;
 }
 
-#define JUMBO_FRAME_SIZE_LIMIT 255
 static int mspSerialSendFrame(mspPort_t *msp, const uint8_t * hdr, int hdrLen, const uint8_t * data, int dataLen, const uint8_t * crc, int crcLen)
 {
     // We are allowed to send out the response if
@@ -391,12 +435,41 @@ static int mspSerialEncode(mspPort_t *msp, mspPacket_t *packet, mspVersion_e msp
     return mspSerialSendFrame(msp, hdrBuf, hdrLen, sbufPtr(&packet->buf), dataLen, crcBuf, crcLen);
 }
 
-static mspPostProcessFnPtr mspSerialProcessReceivedCommand(mspPort_t *msp, mspProcessCommandFnPtr mspProcessCommandFn)
+// Set the reply stream of the port from a MSP2_COMMON_SET_STREAM command
+static mspResult_e mspSerialSetStream(mspPort_t *msp, sbuf_t *src)
 {
-    static uint8_t outBuf[MSP_PORT_OUTBUF_SIZE];
+    if (sbufBytesRemaining(src) < 2) {
+        return MSP_RESULT_ERROR;
+    }
+
+    const uint16_t rate = sbufReadU16(src);
+    const int count = sbufBytesRemaining(src) / 2;
+
+    if (rate > MSP_STREAM_MAX_RATE || count > MSP_STREAM_MAX_COMMANDS) {
+        return MSP_RESULT_ERROR;
+    }
+
+    msp->streamCount = 0;
+
+    if (rate > 0) {
+        for (int i = 0; i < count; i++) {
+            msp->streamCmd[i] = sbufReadU16(src);
+        }
+        msp->streamCount = count;
+        msp->streamVersion = msp->mspVersion;
+        msp->streamInterval = 1000000 / rate;
+        msp->streamNextUs = micros();
+    }
 
+    mspSerialUpdateStreamTask();
+
+    return MSP_RESULT_ACK;
+}
+
+static mspPostProcessFnPtr mspSerialProcessReceivedCommand(mspPort_t *msp, mspProcessCommandFnPtr mspProcessCommandFn)
+{
     mspPacket_t reply = {
-        .buf = { .ptr = outBuf, .end = ARRAYEND(outBuf), },
+        .buf = { .ptr = mspSerialOutBuf, .end = ARRAYEND(mspSerialOutBuf), },
         .cmd = -1,
         .flags = 0,
         .result = 0,
@@ -413,11 +486,24 @@ static mspPostProcessFnPtr mspSerialProcessReceivedCommand(mspPort_t *msp, mspPr
     };
 
     mspPostProcessFnPtr mspPostProcessFn = NULL;
-    const mspResult_e status = mspProcessCommandFn(msp->descriptor, &command, &reply, &mspPostProcessFn);
+    mspResult_e status;
+
+    if (msp->cmdMSP == MSP2_COMMON_SET_STREAM) {
+        // the stream belongs to the port, not to the FC
+        reply.cmd = command.cmd;
+        reply.result = status = mspSerialSetStream(msp, &command.buf);
+    } else {
+        status = mspProcessCommandFn(msp->descriptor, &command, &reply, &mspPostProcessFn);
+    }
 
     if (status != MSP_RESULT_NO_REPLY) {
         sbufSwitchToReader(&reply.buf, outBufHead); // change streambuf direction
-        mspSerialEncode(msp, &reply, msp->mspVersion);
+        if (!mspSerialEncode(msp, &reply, msp->mspVersion)) {
+            // no room for it yet, keep it until the TX buffer drains
+            mspPendingReply = reply;
+            mspPendingReplyPort = msp;
+            mspPendingReplyMs = millis();
+        }
     }
 
     return mspPostProcessFn;
@@ -483,26 +569,67 @@ static void mspSerialProcessReceivedReply(mspPort_t *msp, mspProcessReplyFnPtr m
     msp->c_state = MSP_IDLE;
 }
 
+// Try to send the held reply, returns true once mspSerialOutBuf is free again
+static bool mspSerialSendPendingReply(void)
+{
+    if (mspPendingReplyPort) {
+        if (mspSerialEncode(mspPendingReplyPort, &mspPendingReply, mspPendingReplyPort->mspVersion) ||
+            millis() - mspPendingReplyMs >= MSP_SERIAL_REPLY_TIMEOUT_MS) {
+            mspPendingReplyPort = NULL;
+        }
+    }
+
+    return !mspPendingReplyPort;
+}
+
+// Check if another pipelined command can be processed in this call
+static bool mspSerialCanProcessMore(timeUs_t startUs, int commandCount)
+{
+    return commandCount < MSP_SERIAL_COMMANDS_PER_CALL
+        && cmpTimeUs(micros(), startUs) < MSP_SERIAL_TIME_BUDGET_US
+        && !mspPendingReplyPort;
+}
+
 /*
  * Process MSP commands from serial ports configured as MSP ports.
  *
- * Called periodically by the scheduler.
+ * Called periodically by the scheduler. Pipelined commands are processed
+ * until the command count or time limit is reached, or until a reply does
+ * not fit into the TX buffer. The rest stays in the RX buffer for the next
+ * call. A reply that does not fit is held back, and no further commands are
+ * processed on any port until it has been sent.
  */
 void mspSerialProcess(mspEvaluateNonMspData_e evaluateNonMspData, mspProcessCommandFnPtr mspProcessCommandFn, mspProcessReplyFnPtr mspProcessReplyFn)
 {
+    if (!mspSerialSendPendingReply()) {
+        return;
+    }
+
     for (uint8_t portIndex = 0; portIndex < MAX_MSP_PORT_COUNT; portIndex++) {
         mspPort_t * const mspPort = &mspPorts[portIndex];
         if (!mspPort->port) {
             continue;
         }
 
-        mspPostProcessFnPtr mspPostProcessFn = NULL;
+        if (mspPort->postProcessFn) {
+            // The post processing may take over the port, so wait for the
+            // reply to go out first. New commands wait until it has run.
+            if (isSerialTransmitBufferEmpty(mspPort->port)) {
+                const mspPostProcessFnPtr mspPostProcessFn = mspPort->postProcessFn;
+                mspPort->postProcessFn = NULL;
+                mspPostProcessFn(mspPort->port);
+            }
+            continue;
+        }
 
         if (serialRxBytesWaiting(mspPort->port)) {
             // There are bytes incoming - abort pending request
             mspPort->lastActivityMs = millis();
             mspPort->pendingRequest = MSP_PENDING_NONE;
 
+            const timeUs_t startUs = micros();
+            int commandCount = 0;
+
             while (serialRxBytesWaiting(mspPort->port)) {
                 const uint8_t c = serialRead(mspPort->port);
                 const bool consumed = mspSerialProcessReceivedData(mspPort, c);
@@ -513,19 +640,18 @@ void mspSerialProcess(mspEvaluateNonMspData_e evaluateNonMspData, mspProcessComm
 
                 if (mspPort->c_state == MSP_COMMAND_RECEIVED) {
                     if (mspPort->packetType == MSP_PACKET_COMMAND) {
-                        mspPostProcessFn = mspSerialProcessReceivedCommand(mspPort, mspProcessCommandFn);
+                        mspPort->postProcessFn = mspSerialProcessReceivedCommand(mspPort, mspProcessCommandFn);
                     } else if (mspPort->packetType == MSP_PACKET_REPLY) {
                         mspSerialProcessReceivedReply(mspPort, mspProcessReplyFn);
                     }
 
                     mspPort->c_state = MSP_IDLE;
-                    break; // process one command at a time so as not to block.
-                }
-            }
+                    commandCount++;
 
-            if (mspPostProcessFn) {
-                waitForSerialPortToFinishTransmitting(mspPort->port);
-                mspPostProcessFn(mspPort->port);
+                    if (mspPort->postProcessFn || !mspSerialCanProcessMore(startUs, commandCount)) {
+                        break;
+                    }
+                }
             }
         } else {
             mspProcessPendingRequest(mspPort);
@@ -533,6 +659,96 @@ void mspSerialProcess(mspEvaluateNonMspData_e evaluateNonMspData, mspProcessComm
     }
 }
 
+static void mspSerialSendStreamFrame(mspPort_t *mspPort, sbuf_t *frame)
+{
+    if (frame->ptr > mspStreamBuf) {
+        mspPacket_t packet = {
+            .buf = { .ptr = mspStreamBuf, .end = frame->ptr, },
+            .cmd = MSP2_COMMON_SET_STREAM,
+            .flags = 0,
+            .result = MSP_RESULT_ACK,
+            .direction = MSP_DIRECTION_REPLY,
+        };
+
+        // dropped when the TX buffer is full, the next sample follows soon
+        mspSerialEncode(mspPort, &packet, mspPort->streamVersion);
+    }
+
+    sbufInit(frame, mspStreamBuf, ARRAYEND(mspStreamBuf));
+}
+
+static void mspSerialStreamPort(mspPort_t *mspPort, mspProcessStreamCommandFnPtr mspProcessStreamCommandFn)
+{
+    sbuf_t frame;
+    sbufInit(&frame, mspStreamBuf, ARRAYEND(mspStreamBuf));
+
+    for (int i = 0; i < mspPort->streamCount; ) {
+        const uint16_t cmd = mspPort->streamCmd[i];
+
+        sbuf_t reply;
+        sbufInit(&reply, mspSerialOutBuf, ARRAYEND(mspSerialOutBuf));
+
+        if (!mspProcessStreamCommandFn(cmd, &reply)) {
+            // can not be streamed, drop it from the stream
+            mspPort->streamCount--;
+            memmove(&mspPort->streamCmd[i], &mspPort->streamCmd[i + 1], (mspPort->streamCount - i) * sizeof(mspPort->streamCmd[0]));
+            continue;
+        }
+
+        // coalesce the replies, start a new frame when full
+        const int size = reply.ptr - mspSerialOutBuf;
+        if (sbufBytesRemaining(&frame) < size + 4) {
+            mspSerialSendStreamFrame(mspPort, &frame);
+        }
+        if (sbufBytesRemaining(&frame) >= size + 4) {
+            sbufWriteU16(&frame, cmd);
+            sbufWriteU16(&frame, size);
+            sbufWriteData(&frame, mspSerialOutBuf, size);
+        }
+
+        i++;
+    }
+
+    mspSerialSendStreamFrame(mspPort, &frame);
+}
+
+/*
+ * Push the subscribed reply streams of the MSP ports.
+ *
+ * Called periodically by the scheduler.
+ */
+void mspSerialStream(timeUs_t currentTimeUs, mspProcessStreamCommandFnPtr mspProcessStreamCommandFn)
+{
+    for (uint8_t portIndex = 0; portIndex < MAX_MSP_PORT_COUNT; portIndex++) {
+        mspPort_t * const mspPort = &mspPorts[portIndex];
+        if (!mspPort->port || !mspPort->streamCount || mspPort->postProcessFn || mspPendingReplyPort) {
+            continue;
+        }
+
+        // the subscriber has gone away
+        if (millis() - mspPort->lastActivityMs > MSP_STREAM_TIMEOUT_MS) {
+            mspPort->streamCount = 0;
+            continue;
+        }
+
+        const timeDelta_t lag = cmpTimeUs(currentTimeUs, mspPort->streamNextUs);
+        if (lag < 0) {
+            continue;
+        }
+
+        // keep a uniform sample rate, unless too far behind
+        if (lag < mspPort->streamInterval) {
+            mspPort->streamNextUs += mspPort->streamInterval;
+        } else {
+            mspPort->streamNextUs = currentTimeUs + mspPort->streamInterval;
+        }
+
+        mspSerialStreamPort(mspPort, mspProcessStreamCommandFn);
+    }
+
+    mspSerialUpdateStreamTask();
+}
+
 bool mspSerialWaiting(void)
 {
     for (uint8_t portIndex = 0; portIndex < MAX_MSP_PORT_COUNT; portIndex++) {
@@ -551,6 +767,7 @@ bool mspSerialWaiting(void)
 void mspSerialInit(void)
 {
     memset(mspPorts, 0, sizeof(mspPorts));
+    mspPendingReplyPort = NULL;
     mspSerialAllocatePorts();
 }
 
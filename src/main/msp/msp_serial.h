@@ -97,6 +97,11 @@ typedef struct __attribute__((packed)) {
 
 #define MSP_MAX_HEADER_SIZE     9
 
+// Reply stream of a port, see MSP2_COMMON_SET_STREAM
+#define MSP_STREAM_MAX_COMMANDS 8
+#define MSP_STREAM_MAX_RATE     250     // [Hz], half the rate of the stream task
+#define MSP_STREAM_FRAME_SIZE   256
+
 struct serialPort_s;
 typedef struct mspPort_s {
     struct serialPort_s *port; // null when port unused.
@@ -114,11 +119,18 @@ typedef struct mspPort_s {
     uint8_t checksum2;
     bool sharedWithTelemetry;
     mspDescriptor_t descriptor;
+    mspPostProcessFnPtr postProcessFn; // run once the reply has been transmitted
+    uint16_t streamCmd[MSP_STREAM_MAX_COMMANDS];
+    uint8_t streamCount;
+    mspVersion_e streamVersion;
+    timeDelta_t streamInterval;
+    timeUs_t streamNextUs;
 } mspPort_t;
 
 void mspSerialInit(void);
 bool mspSerialWaiting(void);
 void mspSerialProcess(mspEvaluateNonMspData_e evaluateNonMspData, mspProcessCommandFnPtr mspProcessCommandFn, mspProcessReplyFnPtr mspProcessReplyFn);
+void mspSerialStream(timeUs_t currentTimeUs, mspProcessStreamCommandFnPtr mspProcessStreamCommandFn);
 void mspSerialAllocatePorts(void);
 void mspSerialReleasePortIfAllocated(struct serialPort_s *serialPort);
 void mspSerialReleaseSharedTelemetryPorts(void);
@@ -28,13 +28,62 @@
 
 #include "pg.h"
 
+// Registry positions sorted by pgn. The registry itself is collected by the
+// linker in link order, so the index is built on the first lookup.
+static uint8_t pgIndex[PG_REGISTRY_MAX];
+static bool pgIndexReady;
+
+static void pgIndexInit(void)
+{
+    const int count = PG_REGISTRY_SIZE;
+
+    // insertion sort, the registry is small and this runs once
+    for (int i = 0; i < count; i++) {
+        const pgn_t pgn = pgN(&__pg_registry_start[i]);
+        int j = i;
+        while (j > 0 && pgN(&__pg_registry_start[pgIndex[j - 1]]) > pgn) {
+            pgIndex[j] = pgIndex[j - 1];
+            j--;
+        }
+        pgIndex[j] = i;
+    }
+
+    pgIndexReady = true;
+}
+
 const pgRegistry_t* pgFind(pgn_t pgn)
 {
-    PG_FOREACH(reg) {
-        if (pgN(reg) == pgn) {
+    if (PG_REGISTRY_SIZE > PG_REGISTRY_MAX) {
+        PG_FOREACH(reg) {
+            if (pgN(reg) == pgn) {
+                return reg;
+            }
+        }
+        return NULL;
+    }
+
+    if (!pgIndexReady) {
+        pgIndexInit();
+    }
+
+    int low = 0;
+    int high = PG_REGISTRY_SIZE - 1;
+
+    while (low <= high) {
+        const int mid = (low + high) / 2;
+        const pgRegistry_t *reg = &__pg_registry_start[pgIndex[mid]];
+        const pgn_t regPgn = pgN(reg);
+
+        if (regPgn == pgn) {
             return reg;
         }
+        if (regPgn < pgn) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
     }
+
     return NULL;
 }
 
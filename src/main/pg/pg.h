@@ -83,6 +83,9 @@ extern const uint8_t __pg_resetdata_end[];
 
 #define PG_REGISTRY_SIZE (__pg_registry_end - __pg_registry_start)
 
+// Capacity of the sorted pgn index used by pgFind() and the config loader
+#define PG_REGISTRY_MAX 256
+
 // Helper to iterate over the PG register.  Cheaper than a visitor style callback.
 #define PG_FOREACH(_name) \
     for (const pgRegistry_t *(_name) = __pg_registry_start; (_name) < __pg_registry_end; _name++)
@@ -159,6 +159,7 @@
 #define PG_GENERIC_MIXER_CONFIG 1002
 #define PG_GENERIC_MIXER_RULES 1003
 #define PG_GENERIC_MIXER_INPUTS 1004
+#define PG_SPECTRUM_CONFIG 1005
 
 
 // OSD configuration (subject to change)
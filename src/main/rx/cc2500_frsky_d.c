@@ -56,6 +56,7 @@
 #include "sensors/battery.h"
 
 #include "telemetry/frsky_hub.h"
+#include "telemetry/sensors.h"
 
 #include "cc2500_frsky_d.h"
 
@@ -86,6 +87,7 @@ static uint8_t appendFrSkyHubData(uint8_t *buf)
         if (!telemetryBytesGenerated) {
             telemetryBytesSent = 0;
 
+            telemetrySensorsUpdate();
             processFrSkyHubTelemetry(micros());
         }
     } else { // rx re-requests last packet
@@ -55,6 +55,7 @@
 
 #include "sensors/battery.h"
 
+#include "telemetry/sensors.h"
 #include "telemetry/smartport.h"
 
 #include "cc2500_frsky_x.h"
@@ -563,6 +564,7 @@ rx_spi_received_e frSkyXProcessFrame(uint8_t * const packet)
         }
     }
 
+    telemetrySensorsUpdate();
     processSmartPortTelemetry(payload, &clearToSend, NULL);
 
     return RX_SPI_RECEIVED_NONE;
@@ -69,6 +69,7 @@ static uint8_t telemetryBuf[CRSF_FRAME_SIZE_MAX];
 static uint8_t telemetryBufLen = 0;
 
 static timeUs_t lastRcFrameTimeUs = 0;
+static int32_t rcFrameIntervalUs = 0;   // smoothed interval between RC frames, ie the link packet rate
 
 /*
  * CRSF protocol
@@ -265,6 +266,14 @@ STATIC_UNIT_TESTED void crsfDataReceive(uint16_t c, void *data)
                 {
                     case CRSF_FRAMETYPE_RC_CHANNELS_PACKED:
                         if (crsfFrame.frame.deviceAddress == CRSF_ADDRESS_FLIGHT_CONTROLLER) {
+                            const timeDelta_t frameIntervalUs = cmpTimeUs(currentTimeUs, lastRcFrameTimeUs);
+                            if (frameIntervalUs >= CRSF_LINK_STATUS_UPDATE_TIMEOUT_US) {
+                                rcFrameIntervalUs = 0;
+                            } else if (rcFrameIntervalUs) {
+                                rcFrameIntervalUs += (frameIntervalUs - rcFrameIntervalUs) / 8;
+                            } else {
+                                rcFrameIntervalUs = frameIntervalUs;
+                            }
                             lastRcFrameTimeUs = currentTimeUs;
                             crsfFrameDone = true;
                             memcpy(&crsfChannelDataFrame, &crsfFrame, sizeof(crsfFrame));
@@ -375,6 +384,15 @@ void crsfRxSendTelemetryData(void)
     }
 }
 
+uint16_t crsfRxGetPacketRate(timeUs_t currentTimeUs)
+{
+    // the receiver forwards one RC frame for every packet received over the air
+    if (rcFrameIntervalUs <= 0 || cmpTimeUs(currentTimeUs, lastRcFrameTimeUs) > CRSF_LINK_STATUS_UPDATE_TIMEOUT_US) {
+        return 0;
+    }
+    return (1000000 + rcFrameIntervalUs / 2) / rcFrameIntervalUs;
+}
+
 static timeUs_t crsfFrameTimeUs(void)
 {
     return lastRcFrameTimeUs;
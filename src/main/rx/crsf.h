@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include "common/time.h"
+
 #include "rx/crsf_protocol.h"
 
 
@@ -55,6 +57,7 @@ typedef union crsfFrame_u {
 
 void crsfRxWriteTelemetryData(const void *data, int len);
 void crsfRxSendTelemetryData(void);
+uint16_t crsfRxGetPacketRate(timeUs_t currentTimeUs);
 
 struct rxConfig_s;
 struct rxRuntimeState_s;
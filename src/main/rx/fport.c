@@ -38,6 +38,7 @@
 
 #ifdef USE_TELEMETRY
 #include "telemetry/telemetry.h"
+#include "telemetry/sensors.h"
 #include "telemetry/smartport.h"
 #endif
 
@@ -368,6 +369,7 @@ static bool fportProcessFrame(const rxRuntimeState_t *rxRuntimeState)
     }
 
     if (clearToSend) {
+        telemetrySensorsUpdate();
         processSmartPortTelemetry(mspPayload, &clearToSend, NULL);
 
         if (clearToSend) {
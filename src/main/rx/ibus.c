@@ -45,6 +45,7 @@
 
 #ifdef USE_TELEMETRY
 #include "telemetry/telemetry.h"
+#include "telemetry/sensors.h"
 #endif
 
 #include "rx/rx.h"
@@ -187,6 +188,7 @@ static uint8_t ibusFrameStatus(rxRuntimeState_t *rxRuntimeState)
             lastRcFrameTimeUs = lastFrameTimeUs;
 #if defined(USE_TELEMETRY) && defined(USE_TELEMETRY_IBUS)
         } else {
+            telemetrySensorsUpdate();
             rxBytesToIgnore = respondToIbusRequest(ibus);
 #endif
         }
@@ -77,6 +77,7 @@ typedef enum {
     TASK_ATTITUDE,
     TASK_RX,
     TASK_SERIAL,
+    TASK_MSP_STREAM,
     TASK_DISPATCH,
     TASK_BATTERY_VOLTAGE,
     TASK_BATTERY_CURRENT,
@@ -139,6 +140,12 @@ typedef enum {
     TASK_PINIOBOX,
 #endif
 
+    TASK_CONFIG_SAVE,
+
+#ifdef USE_SPECTRUM_ANALYSER
+    TASK_SPECTRUM,
+#endif
+
     /* Count of real tasks */
     TASK_COUNT,
 
@@ -72,6 +72,8 @@
 #include "config/config.h"
 #include "fc/runtime_config.h"
 
+#include "flight/spectrum.h"
+
 #include "io/beeper.h"
 
 #include "pg/gyrodev.h"
@@ -533,6 +535,10 @@ void accUpdate(timeUs_t currentTimeUs, rollAndPitchTrims_t *rollAndPitchTrims)
 
     applyAccelerationTrims(accelerationTrims);
 
+#ifdef USE_SPECTRUM_ANALYSER
+    spectrumAccUpdate(acc.accADC);
+#endif
+
     ++accumulatedMeasurementCount;
     for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
         accumulatedMeasurements[axis] += acc.accADC[axis];
@@ -43,6 +43,7 @@ typedef struct {
     int32_t current;     // 0.01A
     int32_t consumption; // mAh
     int16_t rpm;         // 0.01erpm
+    uint8_t frameCount;  // Valid frames received (wraps)
 } escSensorData_t;
 
 #define ESC_DATA_INVALID 255
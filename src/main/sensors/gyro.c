@@ -26,6 +26,9 @@
 
 #include "platform.h"
 
+#include "blackbox/blackbox.h"
+#include "blackbox/blackbox_fielddefs.h"
+
 #include "build/debug.h"
 
 #include "common/axis.h"
@@ -47,6 +50,11 @@
 #ifdef USE_GYRO_DATA_ANALYSE
 #include "flight/gyroanalyse.h"
 #endif
+
+#ifdef USE_SPECTRUM_ANALYSER
+#include "flight/spectrum.h"
+#endif
+
 #include "flight/rpm_filter.h"
 
 #include "io/beeper.h"
@@ -90,7 +98,9 @@ STATIC_UNIT_TESTED gyroDev_t * const gyroDevPtr = &gyro.gyroSensor1.gyroDev;
 #define GYRO_OVERFLOW_TRIGGER_THRESHOLD 31980  // 97.5% full scale (1950dps for 2000dps gyro)
 #define GYRO_OVERFLOW_RESET_THRESHOLD 30340    // 92.5% full scale (1850dps for 2000dps gyro)
 
-PG_REGISTER_WITH_RESET_FN(gyroConfig_t, gyroConfig, PG_GYRO_CONFIG, 8);
+#define GYRO_VOTE_SILENT_RATIO 0.01f           // noise variance ratio of a sensor gone silent
+
+PG_REGISTER_WITH_RESET_FN(gyroConfig_t, gyroConfig, PG_GYRO_CONFIG, 10);
 
 #ifndef GYRO_CONFIG_USE_GYRO_DEFAULT
 #define GYRO_CONFIG_USE_GYRO_DEFAULT GYRO_CONFIG_USE_GYRO_1
@@ -131,6 +141,8 @@ void pgResetFn_gyroConfig(gyroConfig_t *gyroConfig)
     gyroConfig->dterm_dyn_lpf_min_hz = 70;
     gyroConfig->dterm_dyn_lpf_max_hz = 170;
     gyroConfig->gyro_filter_debug_axis = FD_ROLL;
+    gyroConfig->gyro_fifo_mode = false;
+    gyroConfig->gyro_vote_threshold = 100;
 }
 
 #ifdef USE_GYRO_DATA_ANALYSE
@@ -203,6 +215,11 @@ void gyroStartCalibration(bool isFirstArmingCalibration)
     if (isFirstArmingCalibration) {
         firstArmingCalibrationWasStarted = true;
     }
+
+#ifdef USE_MULTI_GYRO
+    // Sensor faults are cleared by recalibration
+    gyroInitVote();
+#endif
 }
 
 bool isFirstArmingGyroCalibrationRunning(void)
@@ -335,6 +352,27 @@ static FAST_CODE void checkForOverflow(timeUs_t currentTimeUs)
 }
 #endif // USE_GYRO_OVERFLOW_CHECK
 
+static FAST_CODE void gyroProcessSample(gyroSensor_t *gyroSensor)
+{
+    // move 16-bit gyro data into 32-bit variables to avoid overflows in calculations
+
+#if defined(USE_GYRO_SLEW_LIMITER)
+    gyroSensor->gyroDev.gyroADC[X] = gyroSlewLimiter(gyroSensor, X) - gyroSensor->gyroDev.gyroZero[X];
+    gyroSensor->gyroDev.gyroADC[Y] = gyroSlewLimiter(gyroSensor, Y) - gyroSensor->gyroDev.gyroZero[Y];
+    gyroSensor->gyroDev.gyroADC[Z] = gyroSlewLimiter(gyroSensor, Z) - gyroSensor->gyroDev.gyroZero[Z];
+#else
+    gyroSensor->gyroDev.gyroADC[X] = gyroSensor->gyroDev.gyroADCRaw[X] - gyroSensor->gyroDev.gyroZero[X];
+    gyroSensor->gyroDev.gyroADC[Y] = gyroSensor->gyroDev.gyroADCRaw[Y] - gyroSensor->gyroDev.gyroZero[Y];
+    gyroSensor->gyroDev.gyroADC[Z] = gyroSensor->gyroDev.gyroADCRaw[Z] - gyroSensor->gyroDev.gyroZero[Z];
+#endif
+
+    if (gyroSensor->gyroDev.gyroAlign == ALIGN_CUSTOM) {
+        alignSensorViaMatrix(gyroSensor->gyroDev.gyroADC, &gyroSensor->gyroDev.rotationMatrix);
+    } else {
+        alignSensorViaRotation(gyroSensor->gyroDev.gyroADC, gyroSensor->gyroDev.gyroAlign);
+    }
+}
+
 static FAST_CODE FAST_CODE_NOINLINE void gyroUpdateSensor(gyroSensor_t *gyroSensor)
 {
     if (!gyroSensor->gyroDev.readFn(&gyroSensor->gyroDev)) {
@@ -343,30 +381,206 @@ static FAST_CODE FAST_CODE_NOINLINE void gyroUpdateSensor(gyroSensor_t *gyroSens
     gyroSensor->gyroDev.dataReady = false;
 
     if (isGyroSensorCalibrationComplete(gyroSensor)) {
-        // move 16-bit gyro data into 32-bit variables to avoid overflows in calculations
+        gyroProcessSample(gyroSensor);
+    } else {
+        performGyroCalibration(gyroSensor, gyroConfig()->gyroMovementCalibrationThreshold);
+    }
+}
 
-#if defined(USE_GYRO_SLEW_LIMITER)
-        gyroSensor->gyroDev.gyroADC[X] = gyroSlewLimiter(gyroSensor, X) - gyroSensor->gyroDev.gyroZero[X];
-        gyroSensor->gyroDev.gyroADC[Y] = gyroSlewLimiter(gyroSensor, Y) - gyroSensor->gyroDev.gyroZero[Y];
-        gyroSensor->gyroDev.gyroADC[Z] = gyroSlewLimiter(gyroSensor, Z) - gyroSensor->gyroDev.gyroZero[Z];
-#else
-        gyroSensor->gyroDev.gyroADC[X] = gyroSensor->gyroDev.gyroADCRaw[X] - gyroSensor->gyroDev.gyroZero[X];
-        gyroSensor->gyroDev.gyroADC[Y] = gyroSensor->gyroDev.gyroADCRaw[Y] - gyroSensor->gyroDev.gyroZero[Y];
-        gyroSensor->gyroDev.gyroADC[Z] = gyroSensor->gyroDev.gyroADCRaw[Z] - gyroSensor->gyroDev.gyroZero[Z];
+static FAST_CODE void gyroDownsampleSample(void)
+{
+    if (gyro.downsampleFilterEnabled) {
+        // using gyro lowpass 2 filter for downsampling
+        gyro.sampleSum[X] = filterChainApply(&gyro.lowpass2Chain[X], gyro.gyroADC[X]);
+        gyro.sampleSum[Y] = filterChainApply(&gyro.lowpass2Chain[Y], gyro.gyroADC[Y]);
+        gyro.sampleSum[Z] = filterChainApply(&gyro.lowpass2Chain[Z], gyro.gyroADC[Z]);
+    } else {
+        // using simple averaging for downsampling
+        gyro.sampleSum[X] += gyro.gyroADC[X];
+        gyro.sampleSum[Y] += gyro.gyroADC[Y];
+        gyro.sampleSum[Z] += gyro.gyroADC[Z];
+        gyro.sampleCount++;
+    }
+}
+
+#ifdef USE_MULTI_GYRO
+static FAST_CODE_NOINLINE void gyroVoteFault(int index, gyroFault_e fault)
+{
+    gyro.vote.sensor[index].fault = fault;
+
+#ifdef USE_BLACKBOX
+    if (blackboxConfig()->device) {
+        flightLogEvent_gyroFault_t eventData;
+        eventData.sensor = index + 1;
+        eventData.fault = fault;
+        blackboxLogEvent(FLIGHT_LOG_EVENT_GYRO_FAULT, (flightLogEventData_t *)&eventData);
+    }
 #endif
+}
+
+static FAST_CODE bool gyroVoteSensorClipped(const gyroDev_t *gyroDev)
+{
+    return (abs(gyroDev->gyroADCRaw[X]) > GYRO_OVERFLOW_TRIGGER_THRESHOLD) ||
+           (abs(gyroDev->gyroADCRaw[Y]) > GYRO_OVERFLOW_TRIGGER_THRESHOLD) ||
+           (abs(gyroDev->gyroADCRaw[Z]) > GYRO_OVERFLOW_TRIGGER_THRESHOLD);
+}
+
+// Pick the sensor to drop when the two disagree. A sensor that has gone
+// silent on a disagreeing axis is suspect, otherwise drop the noisier one.
+static FAST_CODE_NOINLINE int gyroVoteSelectFaulty(const bool *disagree)
+{
+    const gyroVoteSensor_t *sensor1 = &gyro.vote.sensor[0];
+    const gyroVoteSensor_t *sensor2 = &gyro.vote.sensor[1];
+    float variance1 = 0, variance2 = 0;
 
-        if (gyroSensor->gyroDev.gyroAlign == ALIGN_CUSTOM) {
-            alignSensorViaMatrix(gyroSensor->gyroDev.gyroADC, &gyroSensor->gyroDev.rotationMatrix);
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        if (disagree[axis]) {
+            const float axisVariance1 = sensor1->variance[axis].state;
+            const float axisVariance2 = sensor2->variance[axis].state;
+            if (axisVariance1 < GYRO_VOTE_SILENT_RATIO * axisVariance2) {
+                return 0;
+            }
+            if (axisVariance2 < GYRO_VOTE_SILENT_RATIO * axisVariance1) {
+                return 1;
+            }
+        }
+        variance1 += sensor1->variance[axis].state;
+        variance2 += sensor2->variance[axis].state;
+    }
+
+    return (variance1 > variance2) ? 0 : 1;
+}
+
+// Fuse both sensors using the inverse of their recent noise variance.
+// Clipped samples are ignored and faulty sensors are dropped.
+static FAST_CODE void gyroVoteUpdate(void)
+{
+    gyroVote_t *vote = &gyro.vote;
+    const gyroDev_t *gyroDev[2] = { &gyro.gyroSensor1.gyroDev, &gyro.gyroSensor2.gyroDev };
+    float value[2][XYZ_AXIS_COUNT];
+    bool usable[2];
+    bool clipped[2];
+
+    for (int i = 0; i < 2; i++) {
+        gyroVoteSensor_t *sensor = &vote->sensor[i];
+        const gyroDev_t *dev = gyroDev[i];
+
+        if ((dev->gyroADCRaw[X] == sensor->previousRaw[X]) &&
+            (dev->gyroADCRaw[Y] == sensor->previousRaw[Y]) &&
+            (dev->gyroADCRaw[Z] == sensor->previousRaw[Z])) {
+            if (++sensor->stuckCount >= vote->stuckLimit && !sensor->fault) {
+                gyroVoteFault(i, GYRO_FAULT_STUCK);
+            }
         } else {
-            alignSensorViaRotation(gyroSensor->gyroDev.gyroADC, gyroSensor->gyroDev.gyroAlign);
+            sensor->stuckCount = 0;
         }
-    } else {
-        performGyroCalibration(gyroSensor, gyroConfig()->gyroMovementCalibrationThreshold);
+
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            sensor->previousRaw[axis] = dev->gyroADCRaw[axis];
+            value[i][axis] = dev->gyroADC[axis] * dev->scale;
+            const float noise = value[i][axis] - pt1FilterApply(&sensor->lowpass[axis], value[i][axis]);
+            pt1FilterApply(&sensor->variance[axis], sq(noise));
+        }
+
+        clipped[i] = gyroVoteSensorClipped(dev);
+        usable[i] = !sensor->fault && !clipped[i];
+    }
+
+    if (vote->threshold > 0 && !vote->sensor[0].fault && !vote->sensor[1].fault) {
+        bool disagree[XYZ_AXIS_COUNT];
+        bool anyDisagree = false;
+
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            disagree[axis] = fabsf(vote->sensor[0].lowpass[axis].state - vote->sensor[1].lowpass[axis].state) > vote->threshold;
+            anyDisagree |= disagree[axis];
+        }
+
+        if (!anyDisagree) {
+            vote->disagreeCount = 0;
+        } else if (++vote->disagreeCount >= vote->disagreeLimit) {
+            gyroVoteFault(gyroVoteSelectFaulty(disagree), GYRO_FAULT_DISAGREE);
+        }
+    }
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        float weight;
+
+        if (usable[0] && usable[1]) {
+            const float variance1 = vote->sensor[0].variance[axis].state;
+            const float variance2 = vote->sensor[1].variance[axis].state;
+            const float varianceSum = variance1 + variance2;
+            weight = (varianceSum > 0) ? variance2 / varianceSum : 0.5f;
+        } else if (usable[0] || usable[1]) {
+            weight = usable[0] ? 1.0f : 0.0f;
+        } else if (vote->sensor[0].fault && !vote->sensor[1].fault) {
+            // Neither usable - a clipped sensor is still better than a faulty one
+            weight = 0.0f;
+        } else if (vote->sensor[1].fault && !vote->sensor[0].fault) {
+            weight = 1.0f;
+        } else {
+            weight = 0.5f;
+        }
+
+        vote->weight[axis] = weight;
+        gyro.gyroADC[axis] = weight * value[0][axis] + (1.0f - weight) * value[1][axis];
+    }
+
+    DEBUG_SET(DEBUG_GYRO_VOTE, 0, lrintf(vote->weight[gyro.gyroDebugAxis] * 1000));
+    DEBUG_SET(DEBUG_GYRO_VOTE, 1, lrintf(sqrtf(vote->sensor[0].variance[gyro.gyroDebugAxis].state) * 10));
+    DEBUG_SET(DEBUG_GYRO_VOTE, 2, lrintf(sqrtf(vote->sensor[1].variance[gyro.gyroDebugAxis].state) * 10));
+    DEBUG_SET(DEBUG_GYRO_VOTE, 3, vote->sensor[0].fault | vote->sensor[1].fault << 2 | clipped[0] << 4 | clipped[1] << 5);
+}
+#endif
+
+#ifdef USE_GYRO_FIFO
+static FAST_CODE FAST_CODE_NOINLINE void gyroUpdateSensorFifo(gyroSensor_t *gyroSensor)
+{
+    gyroDev_t *gyroDev = &gyroSensor->gyroDev;
+
+    const int count = gyroDev->readFn(gyroDev) ? gyroDev->fifoCount : 0;
+
+    gyroDev->dataReady = false;
+
+    // Calibration runs once per batch on the newest sample
+    if (!isGyroSensorCalibrationComplete(gyroSensor)) {
+        if (count) {
+            performGyroCalibration(gyroSensor, gyroConfig()->gyroMovementCalibrationThreshold);
+        }
+        gyroDownsampleSample();
+        return;
+    }
+
+    // Empty FIFO - repeat the previous sample to keep the downsampler fed
+    if (count == 0) {
+        gyroDownsampleSample();
+        return;
+    }
+
+    for (int i = 0; i < count; i++) {
+        gyroDev->gyroADCRaw[X] = gyroDev->fifoData[i][X];
+        gyroDev->gyroADCRaw[Y] = gyroDev->fifoData[i][Y];
+        gyroDev->gyroADCRaw[Z] = gyroDev->fifoData[i][Z];
+
+        gyroProcessSample(gyroSensor);
+
+        gyro.gyroADC[X] = gyroDev->gyroADC[X] * gyroDev->scale;
+        gyro.gyroADC[Y] = gyroDev->gyroADC[Y] * gyroDev->scale;
+        gyro.gyroADC[Z] = gyroDev->gyroADC[Z] * gyroDev->scale;
+
+        gyroDownsampleSample();
     }
 }
+#endif
 
 FAST_CODE void gyroUpdate(void)
 {
+#ifdef USE_GYRO_FIFO
+    if (gyro.fifoEnabled) {
+        gyroUpdateSensorFifo(ACTIVE_GYRO);
+        return;
+    }
+#endif
+
     switch (gyro.gyroToUse) {
     case GYRO_CONFIG_USE_GYRO_1:
         gyroUpdateSensor(&gyro.gyroSensor1);
@@ -389,26 +603,13 @@ FAST_CODE void gyroUpdate(void)
         gyroUpdateSensor(&gyro.gyroSensor1);
         gyroUpdateSensor(&gyro.gyroSensor2);
         if (isGyroSensorCalibrationComplete(&gyro.gyroSensor1) && isGyroSensorCalibrationComplete(&gyro.gyroSensor2)) {
-            gyro.gyroADC[X] = ((gyro.gyroSensor1.gyroDev.gyroADC[X] * gyro.gyroSensor1.gyroDev.scale) + (gyro.gyroSensor2.gyroDev.gyroADC[X] * gyro.gyroSensor2.gyroDev.scale)) / 2.0f;
-            gyro.gyroADC[Y] = ((gyro.gyroSensor1.gyroDev.gyroADC[Y] * gyro.gyroSensor1.gyroDev.scale) + (gyro.gyroSensor2.gyroDev.gyroADC[Y] * gyro.gyroSensor2.gyroDev.scale)) / 2.0f;
-            gyro.gyroADC[Z] = ((gyro.gyroSensor1.gyroDev.gyroADC[Z] * gyro.gyroSensor1.gyroDev.scale) + (gyro.gyroSensor2.gyroDev.gyroADC[Z] * gyro.gyroSensor2.gyroDev.scale)) / 2.0f;
+            gyroVoteUpdate();
         }
         break;
 #endif
     }
 
-    if (gyro.downsampleFilterEnabled) {
-        // using gyro lowpass 2 filter for downsampling
-        gyro.sampleSum[X] = gyro.lowpass2FilterApplyFn((filter_t *)&gyro.lowpass2Filter[X], gyro.gyroADC[X]);
-        gyro.sampleSum[Y] = gyro.lowpass2FilterApplyFn((filter_t *)&gyro.lowpass2Filter[Y], gyro.gyroADC[Y]);
-        gyro.sampleSum[Z] = gyro.lowpass2FilterApplyFn((filter_t *)&gyro.lowpass2Filter[Z], gyro.gyroADC[Z]);
-    } else {
-        // using simple averaging for downsampling
-        gyro.sampleSum[X] += gyro.gyroADC[X];
-        gyro.sampleSum[Y] += gyro.gyroADC[Y];
-        gyro.sampleSum[Z] += gyro.gyroADC[Z];
-        gyro.sampleCount++;
-    }
+    gyroDownsampleSample();
 }
 
 #define GYRO_FILTER_FUNCTION_NAME filterGyro
@@ -441,6 +642,10 @@ FAST_CODE void gyroFiltering(timeUs_t currentTimeUs)
     }
 #endif
 
+#ifdef USE_SPECTRUM_ANALYSER
+    spectrumGyroUpdate();
+#endif
+
     if (gyro.useDualGyroDebugging) {
         switch (gyro.gyroToUse) {
         case GYRO_CONFIG_USE_GYRO_1:
@@ -565,17 +770,9 @@ static void dynLpfGyroUpdate(float ratio)
 {
     if (gyro.dynLpfFilter != DYN_LPF_NONE) {
         const unsigned int cutoffFreq = constrainf(ratio * gyro.dynLpfHz, gyro.dynLpfMin, gyro.dynLpfMax);
-
-        if (gyro.dynLpfFilter == DYN_LPF_PT1) {
-            DEBUG_SET(DEBUG_DYN_LPF, 2, cutoffFreq);
-            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-                pt1FilterUpdateCutoff(&gyro.lowpassFilter[axis].pt1FilterState, pt1FilterGain(cutoffFreq, gyro.targetLooptime * 1e-6f));
-            }
-        } else if (gyro.dynLpfFilter == DYN_LPF_BIQUAD) {
-            DEBUG_SET(DEBUG_DYN_LPF, 2, cutoffFreq);
-            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-                biquadFilterUpdateLPF(&gyro.lowpassFilter[axis].biquadFilterState, cutoffFreq, gyro.targetLooptime);
-            }
+        DEBUG_SET(DEBUG_DYN_LPF, 2, cutoffFreq);
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            lowpassFilterUpdate(gyro.lowpassFilter[axis], gyro.dynLpfType, cutoffFreq, gyro.targetLooptime);
         }
     }
 }
@@ -584,15 +781,8 @@ static void dynLpfDTermUpdate(float ratio)
 {
     if (gyro.dynLpfDtermFilter != DYN_LPF_NONE) {
         const unsigned int cutoffFreq = constrainf(ratio * gyro.dynLpfDtermHz, gyro.dynLpfDtermMin, gyro.dynLpfDtermMax);
-
-        if (gyro.dynLpfDtermFilter == DYN_LPF_PT1) {
-            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-                pt1FilterUpdateCutoff(&gyro.dtermLowpassFilter[axis].pt1FilterState, pt1FilterGain(cutoffFreq, gyro.targetLooptime * 1e-6f));
-            }
-        } else if (gyro.dynLpfDtermFilter == DYN_LPF_BIQUAD) {
-            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-                biquadFilterUpdateLPF(&gyro.dtermLowpassFilter[axis].biquadFilterState, cutoffFreq, gyro.targetLooptime);
-            }
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            lowpassFilterUpdate(gyro.dtermLowpassFilter[axis], gyro.dynLpfDtermType, cutoffFreq, gyro.targetLooptime);
         }
     }
 }
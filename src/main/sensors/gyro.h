@@ -40,11 +40,6 @@
 
 #define DYN_LPF_UPDATE_DELAY_US 5000
 
-typedef union gyroLowpassFilter_u {
-    pt1Filter_t pt1FilterState;
-    biquadFilter_t biquadFilterState;
-} gyroLowpassFilter_t;
-
 typedef enum gyroDetectionFlags_e {
     GYRO_NONE_MASK = 0,
     GYRO_1_MASK = BIT(0),
@@ -61,6 +56,31 @@ typedef struct gyroCalibration_s {
     int32_t cyclesRemaining;
 } gyroCalibration_t;
 
+#ifdef USE_MULTI_GYRO
+typedef enum {
+    GYRO_FAULT_NONE = 0,
+    GYRO_FAULT_STUCK,                  // output frozen on all axes
+    GYRO_FAULT_DISAGREE,               // persistent disagreement, noisier sensor dropped
+} gyroFault_e;
+
+typedef struct gyroVoteSensor_s {
+    pt1Filter_t lowpass[XYZ_AXIS_COUNT];   // reference for the consistency check and noise estimate
+    pt1Filter_t variance[XYZ_AXIS_COUNT];  // recent noise variance
+    int16_t previousRaw[XYZ_AXIS_COUNT];
+    uint16_t stuckCount;
+    uint8_t fault;                         // latched gyroFault_e
+} gyroVoteSensor_t;
+
+typedef struct gyroVote_s {
+    gyroVoteSensor_t sensor[2];
+    float threshold;                       // consistency limit [dps]
+    uint16_t disagreeCount;
+    uint16_t disagreeLimit;                // samples
+    uint16_t stuckLimit;                   // samples
+    float weight[XYZ_AXIS_COUNT];          // gyro 1 weight in the fused output
+} gyroVote_t;
+#endif
+
 typedef struct gyroSensor_s {
     gyroDev_t gyroDev;
     gyroCalibration_t calibration;
@@ -77,6 +97,10 @@ typedef struct gyro_s {
     uint8_t sampleCount;               // gyro sensor sample counter
     float sampleSum[XYZ_AXIS_COUNT];   // summed samples used for downsampling
     bool downsampleFilterEnabled;      // if true then downsample using gyro lowpass 2, otherwise use averaging
+#ifdef USE_GYRO_FIFO
+    bool fifoEnabled;                  // active sensor delivers batches of samples from its FIFO
+    uint32_t fifoLooptime;             // native sensor sample period in FIFO mode
+#endif
 
     gyroSensor_t gyroSensor1;
 #ifdef USE_MULTI_GYRO
@@ -85,37 +109,31 @@ typedef struct gyro_s {
 
     gyroDev_t *rawSensorDev;           // pointer to the sensor providing the raw data for DEBUG_GYRO_RAW
 
-    // lowpass gyro soft filter
-    filterApplyFnPtr lowpassFilterApplyFn;
-    gyroLowpassFilter_t lowpassFilter[XYZ_AXIS_COUNT];
-
-    // lowpass2 gyro soft filter
-    filterApplyFnPtr lowpass2FilterApplyFn;
-    gyroLowpassFilter_t lowpass2Filter[XYZ_AXIS_COUNT];
-
-    // notch filters
-    filterApplyFnPtr notchFilter1ApplyFn;
-    biquadFilter_t notchFilter1[XYZ_AXIS_COUNT];
+#ifdef USE_MULTI_GYRO
+    gyroVote_t vote;                   // redundant sensor fusion for GYRO_CONFIG_USE_GYRO_BOTH
+#endif
 
-    filterApplyFnPtr notchFilter2ApplyFn;
-    biquadFilter_t notchFilter2[XYZ_AXIS_COUNT];
+    // lowpass2 gyro soft filter, used for downsampling
+    filterChain_t lowpass2Chain[XYZ_AXIS_COUNT];
 
-    filterApplyFnPtr notchFilterDynApplyFn;
-    filterApplyFnPtr notchFilterDynApplyFn2;
-    biquadFilter_t notchFilterDyn[XYZ_AXIS_COUNT];
-    biquadFilter_t notchFilterDyn2[XYZ_AXIS_COUNT];
+    // static notches and lowpass, only the active stages
+    filterChain_t filterChain[XYZ_AXIS_COUNT];
+    biquadFilter_t *lowpassFilter[XYZ_AXIS_COUNT];
 
-    // D-term filters
-    filterApplyFnPtr dtermNotchApplyFn;
-    biquadFilter_t dtermNotch[XYZ_AXIS_COUNT];
+#ifdef USE_GYRO_DATA_ANALYSE
+    // dynamic notches
+    filterChain_t dynNotchChain[XYZ_AXIS_COUNT];
+    biquadFilter_t *notchFilterDyn[XYZ_AXIS_COUNT];
+    biquadFilter_t *notchFilterDyn2[XYZ_AXIS_COUNT];
+#endif
 
-    filterApplyFnPtr dtermLowpassApplyFn;
-    gyroLowpassFilter_t dtermLowpassFilter[XYZ_AXIS_COUNT];
-    filterApplyFnPtr dtermLowpass2ApplyFn;
-    gyroLowpassFilter_t dtermLowpass2Filter[XYZ_AXIS_COUNT];
+    // D-term notch and lowpass filters
+    filterChain_t dtermFilterChain[XYZ_AXIS_COUNT];
+    biquadFilter_t *dtermLowpassFilter[XYZ_AXIS_COUNT];
 
 #ifdef USE_DYN_LPF
     uint8_t  dynLpfDtermFilter;
+    uint8_t  dynLpfDtermType;
     uint16_t dynLpfDtermHz;
     uint16_t dynLpfDtermMin;
     uint16_t dynLpfDtermMax;
@@ -134,6 +152,7 @@ typedef struct gyro_s {
 
 #ifdef USE_DYN_LPF
     uint8_t dynLpfFilter;
+    uint8_t dynLpfType;
     uint16_t dynLpfHz;
     uint16_t dynLpfMin;
     uint16_t dynLpfMax;
@@ -156,21 +175,13 @@ enum {
 
 enum {
     DYN_LPF_NONE = 0,
-    DYN_LPF_PT1,
-    DYN_LPF_BIQUAD
+    DYN_LPF_ENABLED,
 };
 
 #define GYRO_CONFIG_USE_GYRO_1      0
 #define GYRO_CONFIG_USE_GYRO_2      1
 #define GYRO_CONFIG_USE_GYRO_BOTH   2
 
-enum {
-    FILTER_LOWPASS = 0,
-    FILTER_LOWPASS2,
-    FILTER_DTERM_LOWPASS,
-    FILTER_DTERM_LOWPASS2,
-};
-
 typedef struct gyroConfig_s {
 
     uint8_t  gyrosDetected;                     // What gyros should detection be attempted for on startup. Automatically set on first startup.
@@ -217,6 +228,10 @@ typedef struct gyroConfig_s {
 
     uint8_t  gyro_filter_debug_axis;
 
+    uint8_t  gyro_fifo_mode;                  // read batched samples from the sensor FIFO
+
+    uint16_t gyro_vote_threshold;             // dual gyro consistency limit [dps], 0 = disabled
+
 } gyroConfig_t;
 
 PG_DECLARE(gyroConfig_t, gyroConfig);
@@ -49,6 +49,10 @@ static FAST_CODE void GYRO_FILTER_FUNCTION_NAME(void)
         // DEBUG_GYRO_SAMPLE(1) Record the post-downsample value for the selected debug axis
         GYRO_FILTER_AXIS_DEBUG_SET(axis, DEBUG_GYRO_SAMPLE, 1, lrintf(gyroADCf));
 
+#ifdef USE_SPECTRUM_ANALYSER
+        spectrumGyroPush(axis, gyroADCf);
+#endif
+
 #ifdef USE_GYRO_DATA_ANALYSE
         if (isDynamicFilterActive()) {
             if (axis == gyro.gyroDebugAxis) {
@@ -66,10 +70,8 @@ static FAST_CODE void GYRO_FILTER_FUNCTION_NAME(void)
         // DEBUG_GYRO_SAMPLE(2) Record the post-RPM Filter value for the selected debug axis
         GYRO_FILTER_AXIS_DEBUG_SET(axis, DEBUG_GYRO_SAMPLE, 2, lrintf(gyroADCf));
 
-        // apply static notch filters and software lowpass filters
-        gyroADCf = gyro.notchFilter1ApplyFn((filter_t *)&gyro.notchFilter1[axis], gyroADCf);
-        gyroADCf = gyro.notchFilter2ApplyFn((filter_t *)&gyro.notchFilter2[axis], gyroADCf);
-        gyroADCf = gyro.lowpassFilterApplyFn((filter_t *)&gyro.lowpassFilter[axis], gyroADCf);
+        // apply the active static notch filters and software lowpass filters
+        gyroADCf = filterChainApply(&gyro.filterChain[axis], gyroADCf);
 
         // DEBUG_GYRO_SAMPLE(3) Record the post-static notch and lowpass filter value for the selected debug axis
         GYRO_FILTER_AXIS_DEBUG_SET(axis, DEBUG_GYRO_SAMPLE, 3, lrintf(gyroADCf));
@@ -82,8 +84,7 @@ static FAST_CODE void GYRO_FILTER_FUNCTION_NAME(void)
                 GYRO_FILTER_DEBUG_SET(DEBUG_DYN_LPF, 3, lrintf(gyroADCf));
             }
             gyroDataAnalysePush(&gyro.gyroAnalyseState, axis, gyroADCf);
-            gyroADCf = gyro.notchFilterDynApplyFn((filter_t *)&gyro.notchFilterDyn[axis], gyroADCf);
-            gyroADCf = gyro.notchFilterDynApplyFn2((filter_t *)&gyro.notchFilterDyn2[axis], gyroADCf);
+            gyroADCf = filterChainApply(&gyro.dynNotchChain[axis], gyroADCf);
         }
 #endif
 
@@ -93,9 +94,7 @@ static FAST_CODE void GYRO_FILTER_FUNCTION_NAME(void)
         gyro.gyroADCf[axis] = gyroADCf;
 
         // Further filtering for D-term
-        gyroADCf = gyro.dtermNotchApplyFn((filter_t *) &gyro.dtermNotch[axis], gyroADCf);
-        gyroADCf = gyro.dtermLowpassApplyFn((filter_t *) &gyro.dtermLowpassFilter[axis], gyroADCf);
-        gyroADCf = gyro.dtermLowpass2ApplyFn((filter_t *) &gyro.dtermLowpass2Filter[axis], gyroADCf);
+        gyroADCf = filterChainApply(&gyro.dtermFilterChain[axis], gyroADCf);
 
         gyro.gyroDtermADCf[axis] = gyroADCf;
     }
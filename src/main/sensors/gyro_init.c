@@ -69,6 +69,7 @@
 #include "pg/gyrodev.h"
 
 #include "sensors/gyro.h"
+#include "sensors/gyro_init.h"
 #include "sensors/sensors.h"
 
 #ifdef USE_GYRO_DATA_ANALYSE
@@ -77,9 +78,10 @@
 #endif
 
 #ifdef USE_MULTI_GYRO
-#define ACTIVE_GYRO ((gyro.gyroToUse == GYRO_CONFIG_USE_GYRO_2) ? &gyro.gyroSensor2 : &gyro.gyroSensor1)
-#else
-#define ACTIVE_GYRO (&gyro.gyroSensor1)
+#define GYRO_VOTE_LOWPASS_HZ        50      // consistency check and noise reference
+#define GYRO_VOTE_VARIANCE_HZ       2       // noise variance averaging
+#define GYRO_VOTE_DISAGREE_MS       100     // sustained disagreement before failover
+#define GYRO_VOTE_STUCK_MS          20      // frozen output before failover
 #endif
 
 static gyroDetectionFlags_t gyroDetectionFlags = GYRO_NONE_MASK;
@@ -98,32 +100,28 @@ static uint16_t calculateNyquistAdjustedNotchHz(uint16_t notchHz, uint16_t notch
     return notchHz;
 }
 
-static void gyroInitFilterNotch1(uint16_t notchHz, uint16_t notchCutoffHz)
+// Adds a stage to the filter chain of every axis
+static bool gyroAddFilterStage(filterChain_t *chain, biquadFilter_t **stage)
 {
-    gyro.notchFilter1ApplyFn = nullFilterApply;
-
-    notchHz = calculateNyquistAdjustedNotchHz(notchHz, notchCutoffHz);
-
-    if (notchHz != 0 && notchCutoffHz != 0) {
-        gyro.notchFilter1ApplyFn = (filterApplyFnPtr)biquadFilterApply;
-        const float notchQ = filterGetNotchQ(notchHz, notchCutoffHz);
-        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-            biquadFilterInit(&gyro.notchFilter1[axis], notchHz, gyro.targetLooptime, notchQ, FILTER_NOTCH);
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        stage[axis] = filterChainAddStage(&chain[axis]);
+        if (stage[axis] == NULL) {
+            return false;
         }
     }
+    return true;
 }
 
-static void gyroInitFilterNotch2(uint16_t notchHz, uint16_t notchCutoffHz)
+static void gyroInitFilterNotch(filterChain_t *chain, uint16_t notchHz, uint16_t notchCutoffHz)
 {
-    gyro.notchFilter2ApplyFn = nullFilterApply;
+    biquadFilter_t *stage[XYZ_AXIS_COUNT];
 
     notchHz = calculateNyquistAdjustedNotchHz(notchHz, notchCutoffHz);
 
-    if (notchHz != 0 && notchCutoffHz != 0) {
-        gyro.notchFilter2ApplyFn = (filterApplyFnPtr)biquadFilterApply;
+    if (notchHz != 0 && notchCutoffHz != 0 && gyroAddFilterStage(chain, stage)) {
         const float notchQ = filterGetNotchQ(notchHz, notchCutoffHz);
         for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-            biquadFilterInit(&gyro.notchFilter2[axis], notchHz, gyro.targetLooptime, notchQ, FILTER_NOTCH);
+            biquadFilterInit(stage[axis], notchHz, gyro.targetLooptime, notchQ, FILTER_NOTCH);
         }
     }
 }
@@ -131,151 +129,85 @@ static void gyroInitFilterNotch2(uint16_t notchHz, uint16_t notchCutoffHz)
 #ifdef USE_GYRO_DATA_ANALYSE
 static void gyroInitFilterDynamicNotch()
 {
-    gyro.notchFilterDynApplyFn = nullFilterApply;
-    gyro.notchFilterDynApplyFn2 = nullFilterApply;
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        filterChainReset(&gyro.dynNotchChain[axis]);
+        gyro.notchFilterDyn[axis] = NULL;
+        gyro.notchFilterDyn2[axis] = NULL;
+    }
 
     if (isDynamicFilterActive()) {
-        gyro.notchFilterDynApplyFn = (filterApplyFnPtr)biquadFilterApplyDF1; // must be this function, not DF2
-        if(gyroConfig()->dyn_notch_width_percent != 0) {
-            gyro.notchFilterDynApplyFn2 = (filterApplyFnPtr)biquadFilterApplyDF1; // must be this function, not DF2
+        gyroAddFilterStage(gyro.dynNotchChain, gyro.notchFilterDyn);
+        if (gyroConfig()->dyn_notch_width_percent != 0) {
+            gyroAddFilterStage(gyro.dynNotchChain, gyro.notchFilterDyn2);
         }
         const float notchQ = filterGetNotchQ(DYNAMIC_NOTCH_DEFAULT_CENTER_HZ, DYNAMIC_NOTCH_DEFAULT_CUTOFF_HZ); // any defaults OK here
         for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-            biquadFilterInit(&gyro.notchFilterDyn[axis], DYNAMIC_NOTCH_DEFAULT_CENTER_HZ, gyro.targetLooptime, notchQ, FILTER_NOTCH);
-            biquadFilterInit(&gyro.notchFilterDyn2[axis], DYNAMIC_NOTCH_DEFAULT_CENTER_HZ, gyro.targetLooptime, notchQ, FILTER_NOTCH);
+            biquadFilterInit(gyro.notchFilterDyn[axis], DYNAMIC_NOTCH_DEFAULT_CENTER_HZ, gyro.targetLooptime, notchQ, FILTER_NOTCH);
+            if (gyro.notchFilterDyn2[axis]) {
+                biquadFilterInit(gyro.notchFilterDyn2[axis], DYNAMIC_NOTCH_DEFAULT_CENTER_HZ, gyro.targetLooptime, notchQ, FILTER_NOTCH);
+            }
         }
     }
 }
 #endif
 
-static bool gyroInitLowpassFilterLpf(int slot, int type, uint16_t lpfHz, uint32_t looptime)
+// Adds the lowpass sections to the chains. If lowpass is given, it receives the first sections for dynamic updates.
+static bool gyroInitFilterLowpass(filterChain_t *chain, biquadFilter_t **lowpass, int type, uint16_t lpfHz, uint32_t looptime)
 {
-    filterApplyFnPtr *lowpassFilterApplyFn;
-    gyroLowpassFilter_t *lowpassFilter = NULL;
+    biquadFilter_t *sections[XYZ_AXIS_COUNT];
 
-    switch (slot) {
-    case FILTER_LOWPASS:
-        lowpassFilterApplyFn = &gyro.lowpassFilterApplyFn;
-        lowpassFilter = gyro.lowpassFilter;
-        break;
-
-    case FILTER_LOWPASS2:
-        lowpassFilterApplyFn = &gyro.lowpass2FilterApplyFn;
-        lowpassFilter = gyro.lowpass2Filter;
-        break;
-
-    case FILTER_DTERM_LOWPASS:
-        lowpassFilterApplyFn = &gyro.dtermLowpassApplyFn;
-        lowpassFilter = gyro.dtermLowpassFilter;
-        break;
+    const uint32_t gyroFrequencyNyquist = 1000000 / 2 / looptime;
 
-    case FILTER_DTERM_LOWPASS2:
-        lowpassFilterApplyFn = &gyro.dtermLowpass2ApplyFn;
-        lowpassFilter = gyro.dtermLowpass2Filter;
-        break;
+    if (lowpass) {
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            lowpass[axis] = NULL;
+        }
+    }
 
-    default:
+    // If lowpass cutoff has been specified and is less than the Nyquist frequency
+    if (lpfHz == 0 || lpfHz > gyroFrequencyNyquist) {
         return false;
     }
 
-    bool ret = false;
-
-    // Establish some common constants
-    const uint32_t gyroFrequencyNyquist = 1000000 / 2 / looptime;
-    const float gyroDt = looptime * 1e-6f;
-
-    // Gain could be calculated a little later as it is specific to the pt1/bqrcf2/fkf branches
-    const float gain = pt1FilterGain(lpfHz, gyroDt);
-
-    // Dereference the pointer to null before checking valid cutoff and filter
-    // type. It will be overridden for positive cases.
-    *lowpassFilterApplyFn = nullFilterApply;
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        sections[axis] = filterChainAddLowpass(&chain[axis], type, lpfHz, looptime);
+        if (sections[axis] == NULL) {
+            return false;
+        }
+    }
 
-    // If lowpass cutoff has been specified and is less than the Nyquist frequency
-    if (lpfHz && lpfHz <= gyroFrequencyNyquist) {
-        switch (type) {
-        case FILTER_PT1:
-            *lowpassFilterApplyFn = (filterApplyFnPtr) pt1FilterApply;
-            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-                pt1FilterInit(&lowpassFilter[axis].pt1FilterState, gain);
-            }
-            ret = true;
-            break;
-        case FILTER_BIQUAD:
-#ifdef USE_DYN_LPF
-            *lowpassFilterApplyFn = (filterApplyFnPtr) biquadFilterApplyDF1;
-#else
-            *lowpassFilterApplyFn = (filterApplyFnPtr) biquadFilterApply;
-#endif
-            for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-                biquadFilterInitLPF(&lowpassFilter[axis].biquadFilterState, lpfHz, looptime);
-            }
-            ret = true;
-            break;
+    if (lowpass) {
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            lowpass[axis] = sections[axis];
         }
     }
-    return ret;
+
+    return true;
 }
 
 #ifdef USE_DYN_LPF
 static void dynLpfFilterInit()
 {
-    if (gyroConfig()->gyro_dyn_lpf_min_hz > 0) {
-        switch (gyroConfig()->gyro_lowpass_type) {
-        case FILTER_PT1:
-            gyro.dynLpfFilter = DYN_LPF_PT1;
-            break;
-        case FILTER_BIQUAD:
-            gyro.dynLpfFilter = DYN_LPF_BIQUAD;
-            break;
-        default:
-            gyro.dynLpfFilter = DYN_LPF_NONE;
-            break;
-        }
-    } else {
-        gyro.dynLpfFilter = DYN_LPF_NONE;
+    gyro.dynLpfFilter = DYN_LPF_NONE;
+    if (gyroConfig()->gyro_dyn_lpf_min_hz > 0 && gyro.lowpassFilter[X]) {
+        gyro.dynLpfFilter = DYN_LPF_ENABLED;
     }
+    gyro.dynLpfType = gyroConfig()->gyro_lowpass_type;
     gyro.dynLpfHz  = gyroConfig()->gyro_lowpass_hz;
     gyro.dynLpfMin = gyroConfig()->gyro_dyn_lpf_min_hz;
     gyro.dynLpfMax = gyroConfig()->gyro_dyn_lpf_max_hz;
 
-    if (gyroConfig()->dterm_dyn_lpf_min_hz > 0) {
-        switch (gyroConfig()->dterm_filter_type) {
-        case FILTER_PT1:
-            gyro.dynLpfDtermFilter = DYN_LPF_PT1;
-            break;
-        case FILTER_BIQUAD:
-            gyro.dynLpfDtermFilter = DYN_LPF_BIQUAD;
-            break;
-        default:
-            gyro.dynLpfDtermFilter = DYN_LPF_NONE;
-            break;
-        }
-    } else {
-        gyro.dynLpfDtermFilter = DYN_LPF_NONE;
+    gyro.dynLpfDtermFilter = DYN_LPF_NONE;
+    if (gyroConfig()->dterm_dyn_lpf_min_hz > 0 && gyro.dtermLowpassFilter[X]) {
+        gyro.dynLpfDtermFilter = DYN_LPF_ENABLED;
     }
+    gyro.dynLpfDtermType = gyroConfig()->dterm_filter_type;
     gyro.dynLpfDtermHz  = gyroConfig()->dterm_lowpass_hz;
     gyro.dynLpfDtermMin = gyroConfig()->dterm_dyn_lpf_min_hz;
     gyro.dynLpfDtermMax = gyroConfig()->dterm_dyn_lpf_max_hz;
-
 }
 #endif
 
-static void gyroInitDtermFilterNotch(uint16_t notchHz, uint16_t notchCutoffHz)
-{
-    gyro.dtermNotchApplyFn = nullFilterApply;
-
-    notchHz = calculateNyquistAdjustedNotchHz(notchHz, notchCutoffHz);
-
-    if (notchHz != 0 && notchCutoffHz != 0) {
-        gyro.dtermNotchApplyFn = (filterApplyFnPtr)biquadFilterApply;
-        const float notchQ = filterGetNotchQ(notchHz, notchCutoffHz);
-        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-            biquadFilterInit(&gyro.dtermNotch[axis], notchHz, gyro.targetLooptime, notchQ, FILTER_NOTCH);
-        }
-    }
-}
-
 void gyroInitFilters(void)
 {
     uint16_t gyro_lowpass_hz = gyroConfig()->gyro_lowpass_hz;
@@ -290,39 +222,57 @@ void gyroInitFilters(void)
     }
 #endif
 
-    gyroInitLowpassFilterLpf(
-      FILTER_LOWPASS,
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        filterChainReset(&gyro.filterChain[axis]);
+        filterChainReset(&gyro.dtermFilterChain[axis]);
+        filterChainReset(&gyro.lowpass2Chain[axis]);
+    }
+
+    gyroInitFilterNotch(gyro.filterChain, gyroConfig()->gyro_soft_notch_hz_1, gyroConfig()->gyro_soft_notch_cutoff_1);
+    gyroInitFilterNotch(gyro.filterChain, gyroConfig()->gyro_soft_notch_hz_2, gyroConfig()->gyro_soft_notch_cutoff_2);
+
+    gyroInitFilterLowpass(
+      gyro.filterChain,
+      gyro.lowpassFilter,
       gyroConfig()->gyro_lowpass_type,
       gyro_lowpass_hz,
       gyro.targetLooptime
     );
 
-    gyro.downsampleFilterEnabled = gyroInitLowpassFilterLpf(
-      FILTER_LOWPASS2,
+#ifdef USE_GYRO_FIFO
+    // The downsampling filter runs once per sample in the FIFO batch
+    const uint32_t downsampleLooptime = gyro.fifoEnabled ? gyro.fifoLooptime : gyro.sampleLooptime;
+#else
+    const uint32_t downsampleLooptime = gyro.sampleLooptime;
+#endif
+
+    // The downsampling filter runs at the sensor sample rate, outside the main filter chain
+    gyro.downsampleFilterEnabled = gyroInitFilterLowpass(
+      gyro.lowpass2Chain,
+      NULL,
       gyroConfig()->gyro_lowpass2_type,
       gyroConfig()->gyro_lowpass2_hz,
-      gyro.sampleLooptime
+      downsampleLooptime
     );
 
-    gyroInitFilterNotch1(gyroConfig()->gyro_soft_notch_hz_1, gyroConfig()->gyro_soft_notch_cutoff_1);
-    gyroInitFilterNotch2(gyroConfig()->gyro_soft_notch_hz_2, gyroConfig()->gyro_soft_notch_cutoff_2);
+    gyroInitFilterNotch(gyro.dtermFilterChain, gyroConfig()->dterm_notch_hz, gyroConfig()->dterm_notch_cutoff);
 
-    gyroInitLowpassFilterLpf(
-      FILTER_DTERM_LOWPASS,
+    gyroInitFilterLowpass(
+      gyro.dtermFilterChain,
+      gyro.dtermLowpassFilter,
       gyroConfig()->dterm_filter_type,
       dterm_lowpass_hz,
       gyro.targetLooptime
     );
 
-    gyroInitLowpassFilterLpf(
-      FILTER_DTERM_LOWPASS2,
+    gyroInitFilterLowpass(
+      gyro.dtermFilterChain,
+      NULL,
       gyroConfig()->dterm_filter2_type,
       gyroConfig()->dterm_lowpass2_hz,
       gyro.targetLooptime
     );
 
-    gyroInitDtermFilterNotch(gyroConfig()->dterm_notch_hz, gyroConfig()->dterm_notch_cutoff);
-
 #ifdef USE_GYRO_DATA_ANALYSE
     gyroInitFilterDynamicNotch();
 #endif
@@ -332,8 +282,43 @@ void gyroInitFilters(void)
 #ifdef USE_GYRO_DATA_ANALYSE
     gyroDataAnalyseStateInit(&gyro.gyroAnalyseState, gyro.targetLooptime);
 #endif
+#ifdef USE_MULTI_GYRO
+    gyroInitVote();
+#endif
 }
 
+#ifdef USE_MULTI_GYRO
+void gyroInitVote(void)
+{
+    gyroVote_t *vote = &gyro.vote;
+
+    memset(vote, 0, sizeof(gyroVote_t));
+
+    if (gyro.gyroToUse != GYRO_CONFIG_USE_GYRO_BOTH || !gyro.sampleLooptime) {
+        return;
+    }
+
+    const float sampleDt = gyro.sampleLooptime * 1e-6f;
+    const float lowpassGain = pt1FilterGain(GYRO_VOTE_LOWPASS_HZ, sampleDt);
+    const float varianceGain = pt1FilterGain(GYRO_VOTE_VARIANCE_HZ, sampleDt);
+
+    for (int i = 0; i < 2; i++) {
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            pt1FilterInit(&vote->sensor[i].lowpass[axis], lowpassGain);
+            pt1FilterInit(&vote->sensor[i].variance[axis], varianceGain);
+        }
+    }
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        vote->weight[axis] = 0.5f;
+    }
+
+    vote->threshold = gyroConfig()->gyro_vote_threshold;
+    vote->disagreeLimit = GYRO_VOTE_DISAGREE_MS * 1000 / gyro.sampleLooptime;
+    vote->stuckLimit = GYRO_VOTE_STUCK_MS * 1000 / gyro.sampleLooptime;
+}
+#endif
+
 #if defined(USE_GYRO_SLEW_LIMITER)
 void gyroInitSlewLimiter(gyroSensor_t *gyroSensor) {
 
@@ -359,6 +344,11 @@ void gyroInitSensor(gyroSensor_t *gyroSensor, const gyroDeviceConfig_t *config)
     buildRotationMatrixFromAlignment(&config->customAlignment, &gyroSensor->gyroDev.rotationMatrix);
     gyroSensor->gyroDev.mpuIntExtiTag = config->extiTag;
     gyroSensor->gyroDev.hardware_lpf = gyroConfig()->gyro_hardware_lpf;
+#ifdef USE_GYRO_FIFO
+    // Batches are downsampled per sample only when a single sensor is used.
+    // Otherwise the sensor stays in register mode with its DLPF.
+    gyroSensor->gyroDev.fifoEnabled = gyroConfig()->gyro_fifo_mode && (gyro.gyroToUse != GYRO_CONFIG_USE_GYRO_BOTH);
+#endif
 
     // The targetLooptime gets set later based on the active sensor's gyroSampleRateHz and pid_process_denom
     gyroSensor->gyroDev.gyroSampleRateHz = gyroSetSampleRate(&gyroSensor->gyroDev);
@@ -717,6 +707,10 @@ bool gyroInit(void)
     if (gyro.rawSensorDev) {
         gyro.sampleRateHz = gyro.rawSensorDev->gyroSampleRateHz;
         gyro.accSampleRateHz = gyro.rawSensorDev->accSampleRateHz;
+#ifdef USE_GYRO_FIFO
+        gyro.fifoEnabled = gyro.rawSensorDev->fifoEnabled;
+        gyro.fifoLooptime = gyro.fifoEnabled ? 1e6 / gyro.rawSensorDev->fifoSampleRateHz : 0;
+#endif
     } else {
         gyro.sampleRateHz = 0;
         gyro.accSampleRateHz = 0;
@@ -23,10 +23,19 @@
 #include "pg/gyrodev.h"
 #include "sensors/gyro.h"
 
+#ifdef USE_MULTI_GYRO
+#define ACTIVE_GYRO ((gyro.gyroToUse == GYRO_CONFIG_USE_GYRO_2) ? &gyro.gyroSensor2 : &gyro.gyroSensor1)
+#else
+#define ACTIVE_GYRO (&gyro.gyroSensor1)
+#endif
+
 void gyroSetTargetLooptime(uint8_t pidDenom);
 void gyroPreInit(void);
 bool gyroInit(void);
 void gyroInitFilters(void);
+#ifdef USE_MULTI_GYRO
+void gyroInitVote(void);
+#endif
 void gyroInitSensor(gyroSensor_t *gyroSensor, const gyroDeviceConfig_t *config);
 gyroDetectionFlags_t getGyroDetectionFlags(void);
 const busDevice_t *gyroSensorBus(void);
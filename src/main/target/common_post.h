@@ -229,6 +229,17 @@
 #define USE_SPI_GYRO
 #endif
 
+// Batched gyro FIFO reads at the native sensor sample rate
+#if defined(USE_GYRO_SPI_ICM20689) || defined(USE_GYRO_SPI_ICM42605) || defined(USE_ACCGYRO_BMI270)
+#define USE_GYRO_FIFO
+#endif
+
+// EXTI triggered SPI DMA gyro reads (F4 standard peripheral driver only)
+#if defined(STM32F4) && defined(USE_SPI_GYRO) && defined(USE_GYRO_EXTI) && defined(USE_DMA) && defined(USE_DMA_SPEC)
+#define USE_SPI_DMA
+#define USE_GYRO_DMA
+#endif
+
 // CX10 is a special case of SPI RX which requires XN297
 #if defined(USE_RX_CX10)
 #define USE_RX_XN297
@@ -286,6 +297,11 @@
 #undef USE_GYRO_DATA_ANALYSE
 #endif
 
+// Vibration spectrum analyser, uses the same FFT as the dynamic notch
+#if defined(USE_GYRO_DATA_ANALYSE) && (TARGET_FLASH_SIZE > 256)
+#define USE_SPECTRUM_ANALYSER
+#endif
+
 #ifndef USE_CMS
 #undef USE_CMS_FAILSAFE_MENU
 #endif
@@ -366,6 +382,11 @@ extern uint8_t __config_start;   // configured via linker script when building b
 extern uint8_t __config_end;
 #endif
 
+// Changed PGs are appended after the config snapshot, this needs a flash like store
+#if defined(CONFIG_IN_FLASH) || defined(CONFIG_IN_FILE)
+#define USE_CONFIG_JOURNAL
+#endif
+
 #if defined(USE_EXST) && !defined(RAMBASED)
 #define USE_FLASH_BOOT_LOADER
 #endif
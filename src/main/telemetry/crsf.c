@@ -28,6 +28,7 @@
 
 #include "build/atomic.h"
 #include "build/build_config.h"
+#include "build/debug.h"
 #include "build/version.h"
 
 #include "config/feature.h"
@@ -63,11 +64,13 @@
 
 #include "telemetry/telemetry.h"
 #include "telemetry/msp_shared.h"
+#include "telemetry/sensors.h"
 
 #include "telemetry/crsf.h"
 
 
-#define CRSF_CYCLETIME_US                   100000 // 100ms, 10 Hz
+#define CRSF_TELEMETRY_RATE_MIN             4      // frames per second, lower bound of the link budget
+#define CRSF_TELEMETRY_RATE_UNPACED         40     // periodic frames per second without a link budget, as the former 10Hz round of four frames
 #define CRSF_DEVICEINFO_VERSION             0x01
 #define CRSF_DEVICEINFO_PARAMETER_COUNT     0
 
@@ -77,6 +80,7 @@
 static bool crsfTelemetryEnabled;
 static bool deviceInfoReplyPending;
 static uint8_t crsfFrame[CRSF_FRAME_SIZE_MAX];
+static uint16_t crsfFrameBytes;     // bytes handed to the receiver since the last reset
 
 #if defined(USE_MSP_OVER_TELEMETRY)
 typedef struct mspBuffer_s {
@@ -141,6 +145,7 @@ static void crsfFinalize(sbuf_t *dst)
     crc8_dvb_s2_sbuf_append(dst, &crsfFrame[2]); // start at byte 2, since CRC does not include device address and frame length
     sbufSwitchToReader(dst, crsfFrame);
     // write the telemetry frame to the receiver.
+    crsfFrameBytes += sbufBytesRemaining(dst);
     crsfRxWriteTelemetryData(sbufPtr(dst), sbufBytesRemaining(dst));
 }
 
@@ -179,13 +184,13 @@ void crsfFrameGps(sbuf_t *dst)
     // use sbufWrite since CRC does not include frame length
     sbufWriteU8(dst, CRSF_FRAME_GPS_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_TYPE_CRC);
     sbufWriteU8(dst, CRSF_FRAMETYPE_GPS);
-    sbufWriteU32BigEndian(dst, gpsSol.llh.lat); // CRSF and betaflight use same units for degrees
-    sbufWriteU32BigEndian(dst, gpsSol.llh.lon);
-    sbufWriteU16BigEndian(dst, (gpsSol.groundSpeed * 36 + 50) / 100); // gpsSol.groundSpeed is in cm/s
-    sbufWriteU16BigEndian(dst, gpsSol.groundCourse * 10); // gpsSol.groundCourse is degrees * 10
-    const uint16_t altitude = (constrain(getEstimatedAltitudeCm(), 0 * 100, 5000 * 100) / 100) + 1000; // constrain altitude from 0 to 5,000m
+    sbufWriteU32BigEndian(dst, telemetrySensorValue(TELEM_GPS_LATITUDE)); // CRSF and betaflight use same units for degrees
+    sbufWriteU32BigEndian(dst, telemetrySensorValue(TELEM_GPS_LONGITUDE));
+    sbufWriteU16BigEndian(dst, (telemetrySensorValue(TELEM_GPS_GROUNDSPEED) * 36 + 50) / 100); // groundspeed is in cm/s
+    sbufWriteU16BigEndian(dst, telemetrySensorValue(TELEM_GPS_GROUNDCOURSE) * 10); // groundcourse is degrees * 10
+    const uint16_t altitude = (constrain(telemetrySensorValue(TELEM_ALTITUDE), 0 * 100, 5000 * 100) / 100) + 1000; // constrain altitude from 0 to 5,000m
     sbufWriteU16BigEndian(dst, altitude);
-    sbufWriteU8(dst, gpsSol.numSat);
+    sbufWriteU8(dst, telemetrySensorValue(TELEM_GPS_SATS));
 }
 
 /*
@@ -202,19 +207,80 @@ void crsfFrameBatterySensor(sbuf_t *dst)
     sbufWriteU8(dst, CRSF_FRAME_BATTERY_SENSOR_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_TYPE_CRC);
     sbufWriteU8(dst, CRSF_FRAMETYPE_BATTERY_SENSOR);
     if (telemetryConfig()->report_cell_voltage) {
-        sbufWriteU16BigEndian(dst, (getBatteryAverageCellVoltage() + 5) / 10); // vbat is in units of 0.01V
+        sbufWriteU16BigEndian(dst, (telemetrySensorValue(TELEM_BATTERY_CELL_VOLTAGE) + 5) / 10); // vbat is in units of 0.01V
     } else {
-        sbufWriteU16BigEndian(dst, getLegacyBatteryVoltage());
+        sbufWriteU16BigEndian(dst, (telemetrySensorValue(TELEM_BATTERY_VOLTAGE) + 5) / 10);
     }
-    sbufWriteU16BigEndian(dst, getAmperage() / 10);
-    const uint32_t mAhDrawn = getMAhDrawn();
-    const uint8_t batteryRemainingPercentage = calculateBatteryPercentageRemaining();
+    sbufWriteU16BigEndian(dst, telemetrySensorValueScaled(TELEM_BATTERY_CURRENT, -1));
+    const uint32_t mAhDrawn = telemetrySensorValue(TELEM_BATTERY_CONSUMPTION);
+    const uint8_t batteryRemainingPercentage = telemetrySensorValue(TELEM_BATTERY_CHARGE_LEVEL);
     sbufWriteU8(dst, (mAhDrawn >> 16));
     sbufWriteU8(dst, (mAhDrawn >> 8));
     sbufWriteU8(dst, (uint8_t)mAhDrawn);
     sbufWriteU8(dst, batteryRemainingPercentage);
 }
 
+/*
+0x0C RPM
+Payload:
+uint8_t     RPM source id
+int24_t     RPM value ( rpm )
+*/
+void crsfFrameHeadspeed(sbuf_t *dst)
+{
+    sbufWriteU8(dst, CRSF_FRAME_RPM_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_TYPE_CRC);
+    sbufWriteU8(dst, CRSF_FRAMETYPE_RPM);
+    sbufWriteU8(dst, 0); // source id, the main rotor
+    const int32_t headspeed = telemetrySensorValue(TELEM_HEADSPEED);
+    sbufWriteU8(dst, (headspeed >> 16));
+    sbufWriteU8(dst, (headspeed >> 8));
+    sbufWriteU8(dst, (uint8_t)headspeed);
+}
+
+/*
+0x0D Temperature
+Payload:
+uint8_t     Temperature source id
+int16_t     Temperature values ( degree C / 10 ), enabled sensors only
+*/
+void crsfFrameTemperature(sbuf_t *dst)
+{
+    const bool escTemperature = telemetryIsSensorEnabled(ESC_SENSOR_TEMPERATURE);
+    const bool mcuTemperature = telemetryIsSensorEnabled(SENSOR_TEMPERATURE);
+
+    uint8_t payloadSize = CRSF_FRAME_TEMP_PAYLOAD_SIZE;
+    if (!escTemperature) {
+        payloadSize -= sizeof(int16_t);
+    }
+    if (!mcuTemperature) {
+        payloadSize -= sizeof(int16_t);
+    }
+
+    sbufWriteU8(dst, payloadSize + CRSF_FRAME_LENGTH_TYPE_CRC);
+    sbufWriteU8(dst, CRSF_FRAMETYPE_TEMP);
+    sbufWriteU8(dst, 0); // source id, the flight controller
+    if (escTemperature) {
+        sbufWriteU16BigEndian(dst, telemetrySensorValueScaled(TELEM_ESC_TEMPERATURE, -1));
+    }
+    if (mcuTemperature) {
+        sbufWriteU16BigEndian(dst, telemetrySensorValueScaled(TELEM_MCU_TEMPERATURE, -1));
+    }
+}
+
+/*
+0x0E Voltages
+Payload:
+uint8_t     Voltage source id
+uint16_t    Voltage values ( mV )
+*/
+void crsfFrameBecVoltage(sbuf_t *dst)
+{
+    sbufWriteU8(dst, CRSF_FRAME_VOLTAGES_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_TYPE_CRC);
+    sbufWriteU8(dst, CRSF_FRAMETYPE_VOLTAGES);
+    sbufWriteU8(dst, 0); // source id, the BEC
+    sbufWriteU16BigEndian(dst, telemetrySensorValueScaled(TELEM_BEC_VOLTAGE, -3));
+}
+
 typedef enum {
     CRSF_ACTIVE_ANTENNA1 = 0,
     CRSF_ACTIVE_ANTENNA2 = 1
@@ -250,9 +316,9 @@ void crsfFrameAttitude(sbuf_t *dst)
 {
      sbufWriteU8(dst, CRSF_FRAME_ATTITUDE_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_TYPE_CRC);
      sbufWriteU8(dst, CRSF_FRAMETYPE_ATTITUDE);
-     sbufWriteU16BigEndian(dst, DECIDEGREES_TO_RADIANS10000(attitude.values.pitch));
-     sbufWriteU16BigEndian(dst, DECIDEGREES_TO_RADIANS10000(attitude.values.roll));
-     sbufWriteU16BigEndian(dst, DECIDEGREES_TO_RADIANS10000(attitude.values.yaw));
+     sbufWriteU16BigEndian(dst, DECIDEGREES_TO_RADIANS10000(telemetrySensorValue(TELEM_ATTITUDE_PITCH)));
+     sbufWriteU16BigEndian(dst, DECIDEGREES_TO_RADIANS10000(telemetrySensorValue(TELEM_ATTITUDE_ROLL)));
+     sbufWriteU16BigEndian(dst, DECIDEGREES_TO_RADIANS10000(telemetrySensorValue(TELEM_ATTITUDE_YAW)));
 }
 
 /*
@@ -365,20 +431,57 @@ static void crsfFrameDisplayPortClear(sbuf_t *dst)
 
 #endif
 
-#define BV(x)  (1 << (x)) // bit value
-
-// schedule array to decide how often each type of frame is sent
+// periodic frames, each sent at its own target rate
 typedef enum {
     CRSF_FRAME_START_INDEX = 0,
     CRSF_FRAME_ATTITUDE_INDEX = CRSF_FRAME_START_INDEX,
     CRSF_FRAME_BATTERY_SENSOR_INDEX,
+    CRSF_FRAME_HEADSPEED_INDEX,
+    CRSF_FRAME_TEMPERATURE_INDEX,
+    CRSF_FRAME_BEC_VOLTAGE_INDEX,
     CRSF_FRAME_FLIGHT_MODE_INDEX,
     CRSF_FRAME_GPS_INDEX,
     CRSF_SCHEDULE_COUNT_MAX
 } crsfFrameTypeIndex_e;
 
-static uint8_t crsfScheduleCount;
-static uint8_t crsfSchedule[CRSF_SCHEDULE_COUNT_MAX];
+typedef struct crsfScheduleEntry_s {
+    void (*frameFn)(sbuf_t *dst);
+    uint8_t rateHz;         // target rate when the link has room for it
+    uint8_t priority;       // the highest priority goes first when due frames have the same deadline
+} crsfScheduleEntry_t;
+
+static const crsfScheduleEntry_t crsfScheduleTable[CRSF_SCHEDULE_COUNT_MAX] = {
+    [CRSF_FRAME_ATTITUDE_INDEX]       = { crsfFrameAttitude,      10, 1 },
+    [CRSF_FRAME_BATTERY_SENSOR_INDEX] = { crsfFrameBatterySensor, 20, 3 },
+    [CRSF_FRAME_HEADSPEED_INDEX]      = { crsfFrameHeadspeed,     20, 3 },
+    [CRSF_FRAME_TEMPERATURE_INDEX]    = { crsfFrameTemperature,    2, 0 },
+    [CRSF_FRAME_BEC_VOLTAGE_INDEX]    = { crsfFrameBecVoltage,     5, 1 },
+    [CRSF_FRAME_FLIGHT_MODE_INDEX]    = { crsfFrameFlightMode,     5, 2 },
+    [CRSF_FRAME_GPS_INDEX]            = { crsfFrameGps,            2, 0 },
+};
+
+STATIC_UNIT_TESTED uint8_t crsfScheduleCount;
+STATIC_UNIT_TESTED uint8_t crsfSchedule[CRSF_SCHEDULE_COUNT_MAX];
+STATIC_UNIT_TESTED timeDelta_t crsfScheduleInterval[CRSF_SCHEDULE_COUNT_MAX];
+static timeUs_t crsfScheduleDue[CRSF_SCHEDULE_COUNT_MAX];
+static uint16_t crsfScheduleRate;   // sum of the target rates
+
+// Ad-hoc replies (MSP, device info, displayport) and the periodic frames
+// share the link through deficit round-robin. Each queue earns a quantum
+// of bytes per round, so neither can starve the other.
+typedef enum {
+    CRSF_QUEUE_SCHEDULED = 0,
+    CRSF_QUEUE_ADHOC,
+    CRSF_QUEUE_COUNT
+} crsfQueue_e;
+
+#define CRSF_QUEUE_QUANTUM  CRSF_FRAME_SIZE_MAX
+
+static int16_t crsfQueueDeficit[CRSF_QUEUE_COUNT];
+static uint8_t crsfQueueActive;
+
+static uint16_t crsfFrameRate;      // telemetry frames per second the link can carry, 0 = unpaced
+static timeUs_t crsfNextFrameUs;
 
 #if defined(USE_MSP_OVER_TELEMETRY)
 
@@ -404,39 +507,128 @@ void crsfSendMspResponse(uint8_t *payload)
 }
 #endif
 
-static void processCrsf(void)
+// Slow all periodic frames down by the same factor if they don't fit the budget
+STATIC_UNIT_TESTED void crsfScheduleBudget(uint16_t frameRate)
 {
-    static uint8_t crsfScheduleIndex = 0;
+    // Without a link budget, keep the aggregate rate of the former fixed round
+    const uint32_t budget = frameRate ? frameRate : CRSF_TELEMETRY_RATE_UNPACED;
+    const uint32_t overload = (crsfScheduleRate > budget) ? crsfScheduleRate : 0;
+
+    for (int i = 0; i < crsfScheduleCount; i++) {
+        const uint32_t rate = crsfScheduleTable[crsfSchedule[i]].rateHz;
+        crsfScheduleInterval[i] = overload ? (1000000 * overload) / (rate * budget) : 1000000 / rate;
+    }
+
+    crsfFrameRate = frameRate;
+}
 
-    const uint8_t currentSchedule = crsfSchedule[crsfScheduleIndex];
+static void crsfUpdateFrameRate(timeUs_t currentTimeUs)
+{
+    const uint8_t ratio = telemetryConfig()->crsf_telemetry_ratio;
+    const uint16_t packetRate = crsfRxGetPacketRate(currentTimeUs);
 
+    uint16_t frameRate = 0;
+    if (ratio && packetRate) {
+        frameRate = MAX(packetRate / ratio, CRSF_TELEMETRY_RATE_MIN);
+    }
+
+    DEBUG_SET(DEBUG_CRSF_TELEMETRY, 0, packetRate);
+    DEBUG_SET(DEBUG_CRSF_TELEMETRY, 1, frameRate);
+
+    if (frameRate != crsfFrameRate) {
+        crsfScheduleBudget(frameRate);
+    }
+}
+
+// Earliest deadline first among the due frames, the deadline being the next due
+// time. A frame keeps its deadline while it waits, so it can't be starved by
+// frames with higher rates or priorities, nor by the ad-hoc replies.
+static int crsfNextScheduledFrame(timeUs_t currentTimeUs)
+{
+    int next = -1;
+    timeUs_t nextDeadline = 0;
+
+    for (int i = 0; i < crsfScheduleCount; i++) {
+        if (cmpTimeUs(currentTimeUs, crsfScheduleDue[i]) >= 0) {
+            const timeUs_t deadline = crsfScheduleDue[i] + crsfScheduleInterval[i];
+            if (next < 0 || cmpTimeUs(nextDeadline, deadline) > 0 ||
+                (deadline == nextDeadline && crsfScheduleTable[crsfSchedule[i]].priority > crsfScheduleTable[crsfSchedule[next]].priority)) {
+                next = i;
+                nextDeadline = deadline;
+            }
+        }
+    }
+
+    return next;
+}
+
+static void crsfSendScheduledFrame(int index, timeUs_t currentTimeUs)
+{
     sbuf_t crsfPayloadBuf;
     sbuf_t *dst = &crsfPayloadBuf;
 
-    if (currentSchedule & BV(CRSF_FRAME_ATTITUDE_INDEX)) {
-        crsfInitializeFrame(dst);
-        crsfFrameAttitude(dst);
-        crsfFinalize(dst);
+    crsfInitializeFrame(dst);
+    crsfScheduleTable[crsfSchedule[index]].frameFn(dst);
+    crsfFinalize(dst);
+
+    // Don't try to catch up with frames missed while the link was busy
+    if (cmpTimeUs(currentTimeUs, crsfScheduleDue[index]) > crsfScheduleInterval[index]) {
+        crsfScheduleDue[index] = currentTimeUs;
+    }
+    crsfScheduleDue[index] += crsfScheduleInterval[index];
+}
+
+static bool crsfAdHocPending(void)
+{
+#if defined(USE_MSP_OVER_TELEMETRY)
+    if (mspReplyPending) {
+        return true;
+    }
+#endif
+#if defined(USE_CRSF_CMS_TELEMETRY)
+    if (crsfDisplayPortScreen()->reset || crsfDisplayPortNextRow() >= 0) {
+        return true;
+    }
+#endif
+    return deviceInfoReplyPending;
+}
+
+static void crsfSendAdHocFrame(void)
+{
+    sbuf_t crsfPayloadBuf;
+    sbuf_t *dst = &crsfPayloadBuf;
+
+#if defined(USE_MSP_OVER_TELEMETRY)
+    if (mspReplyPending) {
+        mspReplyPending = handleCrsfMspFrameBuffer(CRSF_FRAME_TX_MSP_FRAME_SIZE, &crsfSendMspResponse);
+        return;
     }
-    if (currentSchedule & BV(CRSF_FRAME_BATTERY_SENSOR_INDEX)) {
+#endif
+
+    if (deviceInfoReplyPending) {
         crsfInitializeFrame(dst);
-        crsfFrameBatterySensor(dst);
+        crsfFrameDeviceInfo(dst);
         crsfFinalize(dst);
+        deviceInfoReplyPending = false;
+        return;
     }
 
-    if (currentSchedule & BV(CRSF_FRAME_FLIGHT_MODE_INDEX)) {
+#if defined(USE_CRSF_CMS_TELEMETRY)
+    if (crsfDisplayPortScreen()->reset) {
+        crsfDisplayPortScreen()->reset = false;
         crsfInitializeFrame(dst);
-        crsfFrameFlightMode(dst);
+        crsfFrameDisplayPortClear(dst);
         crsfFinalize(dst);
+        return;
     }
-#ifdef USE_GPS
-    if (currentSchedule & BV(CRSF_FRAME_GPS_INDEX)) {
+    const int nextRow = crsfDisplayPortNextRow();
+    if (nextRow >= 0) {
         crsfInitializeFrame(dst);
-        crsfFrameGps(dst);
+        crsfFrameDisplayPortRow(dst, nextRow);
         crsfFinalize(dst);
+        crsfDisplayPortScreen()->pendingTransport[nextRow] = false;
     }
 #endif
-    crsfScheduleIndex = (crsfScheduleIndex + 1) % crsfScheduleCount;
 }
 
 void crsfScheduleDeviceInfoResponse(void)
@@ -462,21 +654,39 @@ void initCrsfTelemetry(void)
 
     int index = 0;
     if (sensors(SENSOR_ACC) && telemetryIsSensorEnabled(SENSOR_PITCH | SENSOR_ROLL | SENSOR_HEADING)) {
-        crsfSchedule[index++] = BV(CRSF_FRAME_ATTITUDE_INDEX);
+        crsfSchedule[index++] = CRSF_FRAME_ATTITUDE_INDEX;
     }
     if ((isBatteryVoltageConfigured() && telemetryIsSensorEnabled(SENSOR_VOLTAGE))
         || (isAmperageConfigured() && telemetryIsSensorEnabled(SENSOR_CURRENT | SENSOR_FUEL))) {
-        crsfSchedule[index++] = BV(CRSF_FRAME_BATTERY_SENSOR_INDEX);
+        crsfSchedule[index++] = CRSF_FRAME_BATTERY_SENSOR_INDEX;
+    }
+    if (telemetryIsSensorEnabled(SENSOR_HEADSPEED)) {
+        crsfSchedule[index++] = CRSF_FRAME_HEADSPEED_INDEX;
     }
-    crsfSchedule[index++] = BV(CRSF_FRAME_FLIGHT_MODE_INDEX);
+    if (telemetryIsSensorEnabled(SENSOR_TEMPERATURE | ESC_SENSOR_TEMPERATURE)) {
+        crsfSchedule[index++] = CRSF_FRAME_TEMPERATURE_INDEX;
+    }
+#ifdef ADC_POWER_5V
+    if (telemetryIsSensorEnabled(SENSOR_BEC_VOLTAGE)) {
+        crsfSchedule[index++] = CRSF_FRAME_BEC_VOLTAGE_INDEX;
+    }
+#endif
+    crsfSchedule[index++] = CRSF_FRAME_FLIGHT_MODE_INDEX;
 #ifdef USE_GPS
     if (featureIsEnabled(FEATURE_GPS)
        && telemetryIsSensorEnabled(SENSOR_ALTITUDE | SENSOR_LAT_LONG | SENSOR_GROUND_SPEED | SENSOR_HEADING)) {
-        crsfSchedule[index++] = BV(CRSF_FRAME_GPS_INDEX);
+        crsfSchedule[index++] = CRSF_FRAME_GPS_INDEX;
     }
 #endif
     crsfScheduleCount = (uint8_t)index;
- }
+
+    crsfScheduleRate = 0;
+    for (int i = 0; i < crsfScheduleCount; i++) {
+        crsfScheduleRate += crsfScheduleTable[crsfSchedule[i]].rateHz;
+        crsfScheduleDue[i] = 0;
+    }
+    crsfScheduleBudget(0);
+}
 
 bool checkCrsfTelemetryState(void)
 {
@@ -513,8 +723,6 @@ void crsfProcessDisplayPortCmd(uint8_t *frameStart)
  */
 void handleCrsfTelemetry(timeUs_t currentTimeUs)
 {
-    static uint32_t crsfLastCycleTime;
-
     if (!crsfTelemetryEnabled) {
         return;
     }
@@ -523,55 +731,49 @@ void handleCrsfTelemetry(timeUs_t currentTimeUs)
     // in between the RX frames.
     crsfRxSendTelemetryData();
 
-    // Send ad-hoc response frames as soon as possible
-#if defined(USE_MSP_OVER_TELEMETRY)
-    if (mspReplyPending) {
-        mspReplyPending = handleCrsfMspFrameBuffer(CRSF_FRAME_TX_MSP_FRAME_SIZE, &crsfSendMspResponse);
-        crsfLastCycleTime = currentTimeUs; // reset telemetry timing due to ad-hoc request
+    crsfUpdateFrameRate(currentTimeUs);
+
+    // Don't hand the receiver more frames than the link can carry
+    if (crsfFrameRate && cmpTimeUs(currentTimeUs, crsfNextFrameUs) < 0) {
         return;
     }
-#endif
 
-    if (deviceInfoReplyPending) {
-        sbuf_t crsfPayloadBuf;
-        sbuf_t *dst = &crsfPayloadBuf;
-        crsfInitializeFrame(dst);
-        crsfFrameDeviceInfo(dst);
-        crsfFinalize(dst);
-        deviceInfoReplyPending = false;
-        crsfLastCycleTime = currentTimeUs; // reset telemetry timing due to ad-hoc request
+    const int scheduledIndex = crsfNextScheduledFrame(currentTimeUs);
+    const bool pending[CRSF_QUEUE_COUNT] = {
+        [CRSF_QUEUE_SCHEDULED] = (scheduledIndex >= 0),
+        [CRSF_QUEUE_ADHOC] = crsfAdHocPending(),
+    };
+
+    if (!pending[CRSF_QUEUE_SCHEDULED] && !pending[CRSF_QUEUE_ADHOC]) {
+        crsfQueueDeficit[CRSF_QUEUE_SCHEDULED] = 0;
+        crsfQueueDeficit[CRSF_QUEUE_ADHOC] = 0;
         return;
     }
 
-#if defined(USE_CRSF_CMS_TELEMETRY)
-    if (crsfDisplayPortScreen()->reset) {
-        crsfDisplayPortScreen()->reset = false;
-        sbuf_t crsfDisplayPortBuf;
-        sbuf_t *dst = &crsfDisplayPortBuf;
-        crsfInitializeFrame(dst);
-        crsfFrameDisplayPortClear(dst);
-        crsfFinalize(dst);
-        crsfLastCycleTime = currentTimeUs;
-        return;
+    // Stay on the active queue while it has credit, otherwise pass the turn on
+    while (!pending[crsfQueueActive] || crsfQueueDeficit[crsfQueueActive] <= 0) {
+        if (!pending[crsfQueueActive]) {
+            crsfQueueDeficit[crsfQueueActive] = 0;
+        }
+        crsfQueueActive = (crsfQueueActive + 1) % CRSF_QUEUE_COUNT;
+        if (pending[crsfQueueActive]) {
+            crsfQueueDeficit[crsfQueueActive] += CRSF_QUEUE_QUANTUM;
+        }
     }
-    const int nextRow = crsfDisplayPortNextRow();
-    if (nextRow >= 0) {
-        sbuf_t crsfDisplayPortBuf;
-        sbuf_t *dst = &crsfDisplayPortBuf;
-        crsfInitializeFrame(dst);
-        crsfFrameDisplayPortRow(dst, nextRow);
-        crsfFinalize(dst);
-        crsfDisplayPortScreen()->pendingTransport[nextRow] = false;
-        crsfLastCycleTime = currentTimeUs;
-        return;
+
+    crsfFrameBytes = 0;
+    if (crsfQueueActive == CRSF_QUEUE_SCHEDULED) {
+        crsfSendScheduledFrame(scheduledIndex, currentTimeUs);
+    } else {
+        crsfSendAdHocFrame();
     }
-#endif
+    crsfQueueDeficit[crsfQueueActive] -= crsfFrameBytes;
 
-    // Actual telemetry data only needs to be sent at a low frequency, ie 10Hz
-    // Spread out scheduled frames evenly so each frame is sent at the same frequency.
-    if (currentTimeUs >= crsfLastCycleTime + (CRSF_CYCLETIME_US / crsfScheduleCount)) {
-        crsfLastCycleTime = currentTimeUs;
-        processCrsf();
+    DEBUG_SET(DEBUG_CRSF_TELEMETRY, 2, crsfQueueDeficit[CRSF_QUEUE_SCHEDULED]);
+    DEBUG_SET(DEBUG_CRSF_TELEMETRY, 3, crsfQueueDeficit[CRSF_QUEUE_ADHOC]);
+
+    if (crsfFrameRate) {
+        crsfNextFrameUs = currentTimeUs + 1000000 / crsfFrameRate;
     }
 }
 
@@ -589,6 +791,15 @@ int getCrsfFrame(uint8_t *frame, crsfFrameType_e frameType)
     case CRSF_FRAMETYPE_BATTERY_SENSOR:
         crsfFrameBatterySensor(sbuf);
         break;
+    case CRSF_FRAMETYPE_RPM:
+        crsfFrameHeadspeed(sbuf);
+        break;
+    case CRSF_FRAMETYPE_TEMP:
+        crsfFrameTemperature(sbuf);
+        break;
+    case CRSF_FRAMETYPE_VOLTAGES:
+        crsfFrameBecVoltage(sbuf);
+        break;
     case CRSF_FRAMETYPE_FLIGHT_MODE:
         crsfFrameFlightMode(sbuf);
         break;
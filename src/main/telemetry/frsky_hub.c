@@ -65,6 +65,7 @@
 
 #include "rx/rx.h"
 
+#include "telemetry/sensors.h"
 #include "telemetry/telemetry.h"
 
 #if defined(USE_ESC_SENSOR_TELEMETRY)
@@ -178,14 +179,14 @@ static void frSkyHubWriteByteInternal(const char data)
 static void sendAccel(void)
 {
     for (unsigned i = 0; i < 3; i++) {
-        frSkyHubWriteFrame(ID_ACC_X + i, ((int16_t)(acc.accADC[i] * acc.dev.acc_1G_rec) * 1000));
+        frSkyHubWriteFrame(ID_ACC_X + i, telemetrySensorValue(TELEM_ACCEL_X + i));
     }
 }
 #endif
 
 static void sendHeadSpeed(void)
 {
-    frSkyHubWriteFrame(ID_RPM, getHeadSpeed());
+    frSkyHubWriteFrame(ID_RPM, telemetrySensorValue(TELEM_HEADSPEED));
 }
 
 static void sendTemperature1(void)
@@ -252,7 +253,7 @@ static void sendLatLong(int32_t coord[2])
 #if defined(USE_GPS)
 static void sendGpsAltitude(void)
 {
-    int32_t altitudeCm = gpsSol.llh.altCm;
+    int32_t altitudeCm = telemetrySensorValue(TELEM_GPS_ALTITUDE);
 
     // Send real GPS altitude only if it's reliable (there's a GPS fix)
     if (!STATE(GPS_FIX)) {
@@ -264,10 +265,10 @@ static void sendGpsAltitude(void)
 
 static void sendSatalliteSignalQualityAsTemperature2(uint8_t cycleNum)
 {
-    uint16_t satellite = gpsSol.numSat;
+    uint16_t satellite = telemetrySensorValue(TELEM_GPS_SATS);
 
-    if (gpsSol.hdop > GPS_BAD_QUALITY && ( (cycleNum % 16 ) < 8)) { // Every 1s
-        satellite = constrain(gpsSol.hdop, 0, GPS_MAX_HDOP_VAL);
+    if (telemetrySensorValue(TELEM_GPS_HDOP) > GPS_BAD_QUALITY && ( (cycleNum % 16 ) < 8)) { // Every 1s
+        satellite = constrain(telemetrySensorValue(TELEM_GPS_HDOP), 0, GPS_MAX_HDOP_VAL);
     }
     int16_t data;
     if (telemetryConfig()->frsky_unit == FRSKY_UNIT_METRICS) {
@@ -288,8 +289,8 @@ static void sendSpeed(void)
     }
     // Speed should be sent in knots (GPS speed is in cm/s)
     // convert to knots: 1cm/s = 0.0194384449 knots
-    frSkyHubWriteFrame(ID_GPS_SPEED_BP, gpsSol.groundSpeed * 1944 / 100000);
-    frSkyHubWriteFrame(ID_GPS_SPEED_AP, (gpsSol.groundSpeed * 1944 / 100) % 100);
+    frSkyHubWriteFrame(ID_GPS_SPEED_BP, telemetrySensorValue(TELEM_GPS_GROUNDSPEED) * 1944 / 100000);
+    frSkyHubWriteFrame(ID_GPS_SPEED_AP, (telemetrySensorValue(TELEM_GPS_GROUNDSPEED) * 1944 / 100) % 100);
 }
 
 static void sendFakeLatLong(void)
@@ -311,8 +312,8 @@ static void sendGPSLatLong(void)
     if (STATE(GPS_FIX) || gpsFixOccured == 1) {
         // If we have ever had a fix, send the last known lat/long
         gpsFixOccured = 1;
-        coord[LAT] = gpsSol.llh.lat;
-        coord[LON] = gpsSol.llh.lon;
+        coord[LAT] = telemetrySensorValue(TELEM_GPS_LATITUDE);
+        coord[LON] = telemetrySensorValue(TELEM_GPS_LONGITUDE);
         sendLatLong(coord);
     } else {
         // otherwise send fake lat/long in order to display compass value
@@ -333,7 +334,7 @@ static void sendVoltageCells(void)
 {
     static uint16_t currentCell;
     uint32_t cellVoltage = 0;
-    const uint8_t cellCount = getBatteryCellCount();
+    const uint8_t cellCount = telemetrySensorValue(TELEM_BATTERY_CELL_COUNT);
 
     if (cellCount) {
         currentCell %= cellCount;
@@ -348,7 +349,7 @@ static void sendVoltageCells(void)
         * The actual value sent for cell voltage has resolution of 0.002 volts
         * Since vbat has resolution of 0.1 volts it has to be multiplied by 50
         */
-        cellVoltage = ((uint32_t)getBatteryVoltage() * 100 + cellCount) / (cellCount * 2);
+        cellVoltage = ((uint32_t)telemetrySensorValue(TELEM_BATTERY_VOLTAGE) * 100 + cellCount) / (cellCount * 2);
     } else {
         currentCell = 0;
     }
@@ -373,7 +374,7 @@ static void sendVoltageCells(void)
 static void sendVoltageAmp(void)
 {
     uint16_t voltage = getLegacyBatteryVoltage();
-    const uint8_t cellCount = getBatteryCellCount();
+    const uint8_t cellCount = telemetrySensorValue(TELEM_BATTERY_CELL_COUNT);
 
     if (telemetryConfig()->frsky_vfas_precision == FRSKY_VFAS_PRECISION_HIGH) {
         // Use new ID 0x39 to send voltage directly in 0.1 volts resolution
@@ -395,16 +396,16 @@ static void sendVoltageAmp(void)
 
 static void sendAmperage(void)
 {
-    frSkyHubWriteFrame(ID_CURRENT, (uint16_t)(getAmperage() / 10));
+    frSkyHubWriteFrame(ID_CURRENT, (uint16_t)(telemetrySensorValue(TELEM_BATTERY_CURRENT) / 10));
 }
 
 static void sendFuelLevel(void)
 {
     int16_t data;
     if (batteryConfig()->batteryCapacity > 0) {
-        data = (uint16_t)calculateBatteryPercentageRemaining();
+        data = (uint16_t)telemetrySensorValue(TELEM_BATTERY_CHARGE_LEVEL);
     } else {
-        data = (uint16_t)constrain(getMAhDrawn(), 0, 0xFFFF);
+        data = (uint16_t)constrain(telemetrySensorValue(TELEM_BATTERY_CONSUMPTION), 0, 0xFFFF);
     }
     frSkyHubWriteFrame(ID_FUEL_LEVEL, data);
 }
@@ -423,7 +424,7 @@ static void sendFakeLatLongThatAllowsHeadingDisplay(void)
 
 static void sendHeading(void)
 {
-    frSkyHubWriteFrame(ID_COURSE_BP, DECIDEGREES_TO_DEGREES(attitude.values.yaw));
+    frSkyHubWriteFrame(ID_COURSE_BP, DECIDEGREES_TO_DEGREES(telemetrySensorValue(TELEM_ATTITUDE_YAW)));
     frSkyHubWriteFrame(ID_COURSE_AP, 0);
 }
 #endif
@@ -516,13 +517,13 @@ void processFrSkyHubTelemetry(timeUs_t currentTimeUs)
         // Unit is cm/s
 #ifdef USE_VARIO
         if (telemetryIsSensorEnabled(SENSOR_VARIO)) {
-            frSkyHubWriteFrame(ID_VERT_SPEED, getEstimatedVario());
+            frSkyHubWriteFrame(ID_VERT_SPEED, telemetrySensorValue(TELEM_VARIO));
         }
 #endif
 
         // Sent every 500ms
         if ((cycleNum % 4) == 0 && telemetryIsSensorEnabled(SENSOR_ALTITUDE)) {
-            int32_t altitudeCm = getEstimatedAltitudeCm();
+            int32_t altitudeCm = telemetrySensorValue(TELEM_ALTITUDE);
 
             /* Allow 5s to boot correctly othervise send zero to prevent OpenTX
              * sensor lost notifications after warm boot. */
@@ -87,6 +87,7 @@
 #include "sensors/sensors.h"
 
 #include "telemetry/hott.h"
+#include "telemetry/sensors.h"
 #include "telemetry/telemetry.h"
 
 #if defined (USE_HOTT_TEXTMODE) && defined (USE_CMS)
@@ -214,32 +215,32 @@ void addGPSCoordinates(HOTT_GPS_MSG_t *hottGPSMessage, int32_t latitude, int32_t
 
 void hottPrepareGPSResponse(HOTT_GPS_MSG_t *hottGPSMessage)
 {
-    hottGPSMessage->gps_satelites = gpsSol.numSat;
+    hottGPSMessage->gps_satelites = telemetrySensorValue(TELEM_GPS_SATS);
 
     if (!STATE(GPS_FIX)) {
         hottGPSMessage->gps_fix_char = GPS_FIX_CHAR_NONE;
         return;
     }
 
-    if (gpsSol.numSat >= 5) {
+    if (telemetrySensorValue(TELEM_GPS_SATS) >= 5) {
         hottGPSMessage->gps_fix_char = GPS_FIX_CHAR_3D;
     } else {
         hottGPSMessage->gps_fix_char = GPS_FIX_CHAR_2D;
     }
 
-    addGPSCoordinates(hottGPSMessage, gpsSol.llh.lat, gpsSol.llh.lon);
+    addGPSCoordinates(hottGPSMessage, telemetrySensorValue(TELEM_GPS_LATITUDE), telemetrySensorValue(TELEM_GPS_LONGITUDE));
 
     // GPS Speed is returned in cm/s (from io/gps.c) and must be sent in km/h (Hott requirement)
-    const uint16_t speed = (gpsSol.groundSpeed * 36) / 1000;
+    const uint16_t speed = (telemetrySensorValue(TELEM_GPS_GROUNDSPEED) * 36) / 1000;
     hottGPSMessage->gps_speed_L = speed & 0x00FF;
     hottGPSMessage->gps_speed_H = speed >> 8;
 
-    hottGPSMessage->home_distance_L = GPS_distanceToHome & 0x00FF;
-    hottGPSMessage->home_distance_H = GPS_distanceToHome >> 8;
+    hottGPSMessage->home_distance_L = telemetrySensorValue(TELEM_GPS_HOME_DISTANCE) & 0x00FF;
+    hottGPSMessage->home_distance_H = telemetrySensorValue(TELEM_GPS_HOME_DISTANCE) >> 8;
 
-    int32_t altitudeM = gpsSol.llh.altCm / 100;
+    int32_t altitudeM = telemetrySensorValue(TELEM_GPS_ALTITUDE) / 100;
     if (!STATE(GPS_FIX)) {
-        altitudeM = getEstimatedAltitudeCm() / 100;
+        altitudeM = telemetrySensorValue(TELEM_ALTITUDE) / 100;
     }
 
     const uint16_t hottGpsAltitude = constrain(altitudeM + HOTT_GPS_ALTITUDE_OFFSET, 0 , UINT16_MAX); // gpsSol.llh.alt in m ; offset = 500 -> O m
@@ -247,7 +248,7 @@ void hottPrepareGPSResponse(HOTT_GPS_MSG_t *hottGPSMessage)
     hottGPSMessage->altitude_L = hottGpsAltitude & 0x00FF;
     hottGPSMessage->altitude_H = hottGpsAltitude >> 8;
 
-    hottGPSMessage->home_direction = GPS_directionToHome;
+    hottGPSMessage->home_direction = telemetrySensorValue(TELEM_GPS_HOME_DIRECTION);
 }
 #endif
 
@@ -290,21 +291,21 @@ static inline void hottEAMUpdateBattery(HOTT_EAM_MSG_t *hottEAMMessage)
 
 static inline void hottEAMUpdateCurrentMeter(HOTT_EAM_MSG_t *hottEAMMessage)
 {
-    const int32_t amp = getAmperage() / 10;
+    const int32_t amp = telemetrySensorValue(TELEM_BATTERY_CURRENT) / 10;
     hottEAMMessage->current_L = amp & 0xFF;
     hottEAMMessage->current_H = amp >> 8;
 }
 
 static inline void hottEAMUpdateBatteryDrawnCapacity(HOTT_EAM_MSG_t *hottEAMMessage)
 {
-    const int32_t mAh = getMAhDrawn() / 10;
+    const int32_t mAh = telemetrySensorValue(TELEM_BATTERY_CONSUMPTION) / 10;
     hottEAMMessage->batt_cap_L = mAh & 0xFF;
     hottEAMMessage->batt_cap_H = mAh >> 8;
 }
 
 static inline void hottEAMUpdateAltitude(HOTT_EAM_MSG_t *hottEAMMessage)
 {
-    const uint16_t hottEamAltitude = (getEstimatedAltitudeCm() / 100) + HOTT_EAM_OFFSET_HEIGHT;
+    const uint16_t hottEamAltitude = (telemetrySensorValue(TELEM_ALTITUDE) / 100) + HOTT_EAM_OFFSET_HEIGHT;
 
     hottEAMMessage->altitude_L = hottEamAltitude & 0x00FF;
     hottEAMMessage->altitude_H = hottEamAltitude >> 8;
@@ -313,7 +314,7 @@ static inline void hottEAMUpdateAltitude(HOTT_EAM_MSG_t *hottEAMMessage)
 #ifdef USE_VARIO
 static inline void hottEAMUpdateClimbrate(HOTT_EAM_MSG_t *hottEAMMessage)
 {
-    const int32_t vario = getEstimatedVario();
+    const int32_t vario = telemetrySensorValue(TELEM_VARIO);
     hottEAMMessage->climbrate_L = (30000 + vario) & 0x00FF;
     hottEAMMessage->climbrate_H = (30000 + vario) >> 8;
     hottEAMMessage->climbrate3s = 120 + (vario / 100);
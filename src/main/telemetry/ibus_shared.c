@@ -34,6 +34,7 @@
 #include <limits.h>
 
 #include "platform.h"
+#include "telemetry/sensors.h"
 #include "telemetry/telemetry.h"
 #include "telemetry/ibus_shared.h"
 
@@ -210,9 +211,9 @@ static void setIbusSensorType(ibusAddress_t address)
 
 static uint16_t getVoltage()
 {
-    uint16_t voltage = getBatteryVoltage();
+    uint16_t voltage = telemetrySensorValue(TELEM_BATTERY_VOLTAGE);
     if (telemetryConfig()->report_cell_voltage) {
-        voltage /= getBatteryCellCount();
+        voltage /= telemetrySensorValue(TELEM_BATTERY_CELL_COUNT);
     }
     return voltage;
 }
@@ -233,9 +234,9 @@ static uint16_t getFuel()
 {
     uint16_t fuel = 0;
     if (batteryConfig()->batteryCapacity > 0) {
-        fuel = (uint16_t)calculateBatteryPercentageRemaining();
+        fuel = (uint16_t)telemetrySensorValue(TELEM_BATTERY_CHARGE_LEVEL);
     } else {
-        fuel = (uint16_t)constrain(getMAhDrawn(), 0, 0xFFFF);
+        fuel = (uint16_t)constrain(telemetrySensorValue(TELEM_BATTERY_CONSUMPTION), 0, 0xFFFF);
     }
     return fuel;
 }
@@ -272,7 +273,7 @@ static uint16_t getMode()
 #if defined(USE_ACC)
 static int16_t getACC(uint8_t index)
 {
-    return (int16_t)((acc.accADC[index] * acc.dev.acc_1G_rec) * 1000);
+    return telemetrySensorValue(TELEM_ACCEL_X + index);
 }
 #endif
 
@@ -306,33 +307,33 @@ static bool setGPS(uint8_t sensorType, ibusTelemetry_s* value)
     uint16_t gpsFixType = 0;
     uint16_t sats = 0;
     if (sensors(SENSOR_GPS)) {
-        gpsFixType = !STATE(GPS_FIX) ? 1 : (gpsSol.numSat < 5 ? 2 : 3);
-        sats = gpsSol.numSat;
+        gpsFixType = !STATE(GPS_FIX) ? 1 : (telemetrySensorValue(TELEM_GPS_SATS) < 5 ? 2 : 3);
+        sats = telemetrySensorValue(TELEM_GPS_SATS);
         if (STATE(GPS_FIX) || sensorType == IBUS_SENSOR_TYPE_GPS_STATUS) {
             result = true;
             switch (sensorType) {
             case IBUS_SENSOR_TYPE_SPE:
-                value->uint16 = gpsSol.groundSpeed * 36 / 100;
+                value->uint16 = telemetrySensorValue(TELEM_GPS_GROUNDSPEED) * 36 / 100;
                 break;
             case IBUS_SENSOR_TYPE_GPS_LAT:
-                value->int32 = gpsSol.llh.lat;
+                value->int32 = telemetrySensorValue(TELEM_GPS_LATITUDE);
                 break;
             case IBUS_SENSOR_TYPE_GPS_LON:
-                value->int32 = gpsSol.llh.lon;
+                value->int32 = telemetrySensorValue(TELEM_GPS_LONGITUDE);
                 break;
             case IBUS_SENSOR_TYPE_GPS_ALT:
-                value->int32 = (int32_t)gpsSol.llh.altCm;
+                value->int32 = (int32_t)telemetrySensorValue(TELEM_GPS_ALTITUDE);
                 break;
             case IBUS_SENSOR_TYPE_GROUND_SPEED:
-                value->uint16 = gpsSol.groundSpeed;
+                value->uint16 = telemetrySensorValue(TELEM_GPS_GROUNDSPEED);
                 break;
             case IBUS_SENSOR_TYPE_ODO1:
             case IBUS_SENSOR_TYPE_ODO2:
             case IBUS_SENSOR_TYPE_GPS_DIST:
-                value->uint16 = GPS_distanceToHome;
+                value->uint16 = telemetrySensorValue(TELEM_GPS_HOME_DISTANCE);
                 break;
             case IBUS_SENSOR_TYPE_COG:
-                value->uint16 = gpsSol.groundCourse * 100;
+                value->uint16 = telemetrySensorValue(TELEM_GPS_GROUNDCOURSE) * 100;
                 break;
             case IBUS_SENSOR_TYPE_GPS_STATUS:
                 value->byte[0] = gpsFixType;
@@ -389,10 +390,10 @@ static void setValue(uint8_t* bufferPtr, uint8_t sensorType, uint8_t length)
             value.uint16 = getMode();
             break;
         case IBUS_SENSOR_TYPE_CELL:
-            value.uint16 = (uint16_t)(getBatteryAverageCellVoltage());
+            value.uint16 = (uint16_t)(telemetrySensorValue(TELEM_BATTERY_CELL_VOLTAGE));
             break;
         case IBUS_SENSOR_TYPE_BAT_CURR:
-            value.uint16 = (uint16_t)getAmperage();
+            value.uint16 = (uint16_t)telemetrySensorValue(TELEM_BATTERY_CURRENT);
             break;
 #if defined(USE_ACC)
         case IBUS_SENSOR_TYPE_ACC_X:
@@ -402,21 +403,25 @@ static void setValue(uint8_t* bufferPtr, uint8_t sensorType, uint8_t length)
             break;
 #endif
         case IBUS_SENSOR_TYPE_ROLL:
+            value.int16 = telemetrySensorValue(TELEM_ATTITUDE_ROLL) * 10;
+            break;
         case IBUS_SENSOR_TYPE_PITCH:
+            value.int16 = telemetrySensorValue(TELEM_ATTITUDE_PITCH) * 10;
+            break;
         case IBUS_SENSOR_TYPE_YAW:
-            value.int16 = attitude.raw[sensorType - IBUS_SENSOR_TYPE_ROLL] *10;
+            value.int16 = telemetrySensorValue(TELEM_ATTITUDE_YAW) * 10;
             break;
         case IBUS_SENSOR_TYPE_ARMED:
             value.uint16 = ARMING_FLAG(ARMED) ? 1 : 0;
             break;
 #if defined(USE_TELEMETRY_IBUS_EXTENDED)
         case IBUS_SENSOR_TYPE_CMP_HEAD:
-            value.uint16 = DECIDEGREES_TO_DEGREES(attitude.values.yaw);
+            value.uint16 = DECIDEGREES_TO_DEGREES(telemetrySensorValue(TELEM_ATTITUDE_YAW));
             break;
 #ifdef USE_VARIO
         case IBUS_SENSOR_TYPE_VERTICAL_SPEED:
         case IBUS_SENSOR_TYPE_CLIMB_RATE:
-            value.int16 = (int16_t) constrain(getEstimatedVario(), SHRT_MIN, SHRT_MAX);
+            value.int16 = (int16_t) constrain(telemetrySensorValue(TELEM_VARIO), SHRT_MIN, SHRT_MAX);
             break;
 #endif
 #ifdef USE_BARO
@@ -53,6 +53,7 @@
 #include "sensors/acceleration.h"
 
 #include "telemetry/jetiexbus.h"
+#include "telemetry/sensors.h"
 #include "telemetry/telemetry.h"
 
 #define EXTEL_DATA_MSG      (0x40)
@@ -310,84 +311,84 @@ int32_t getSensorValue(uint8_t sensor)
         break;
 
     case EX_CURRENT:
-        return getAmperage();
+        return telemetrySensorValue(TELEM_BATTERY_CURRENT);
         break;
 
     case EX_ALTITUDE:
-        return getEstimatedAltitudeCm();
+        return telemetrySensorValue(TELEM_ALTITUDE);
         break;
 
     case EX_CAPACITY:
-        return getMAhDrawn();
+        return telemetrySensorValue(TELEM_BATTERY_CONSUMPTION);
         break;
 
     case EX_POWER:
-        return (getBatteryVoltage() * getAmperage() / 1000);
+        return (telemetrySensorValue(TELEM_BATTERY_VOLTAGE) * telemetrySensorValue(TELEM_BATTERY_CURRENT) / 1000);
         break;
 
     case EX_ROLL_ANGLE:
-        return attitude.values.roll;
+        return telemetrySensorValue(TELEM_ATTITUDE_ROLL);
         break;
 
     case EX_PITCH_ANGLE:
-        return attitude.values.pitch;
+        return telemetrySensorValue(TELEM_ATTITUDE_PITCH);
         break;
 
     case EX_HEADING:
-        return attitude.values.yaw;
+        return telemetrySensorValue(TELEM_ATTITUDE_YAW);
         break;
 
 #ifdef USE_VARIO
     case EX_VARIO:
-        return getEstimatedVario();
+        return telemetrySensorValue(TELEM_VARIO);
         break;
 #endif
 
 #ifdef USE_GPS
     case EX_GPS_SATS:
-        return gpsSol.numSat;
+        return telemetrySensorValue(TELEM_GPS_SATS);
     break;
 
     case EX_GPS_LONG:
-        return calcGpsDDMMmmm(gpsSol.llh.lon, true);
+        return calcGpsDDMMmmm(telemetrySensorValue(TELEM_GPS_LONGITUDE), true);
     break;
 
     case EX_GPS_LAT:
-        return calcGpsDDMMmmm(gpsSol.llh.lat, false);
+        return calcGpsDDMMmmm(telemetrySensorValue(TELEM_GPS_LATITUDE), false);
     break;
 
     case EX_GPS_SPEED:
-        return gpsSol.groundSpeed;
+        return telemetrySensorValue(TELEM_GPS_GROUNDSPEED);
     break;
 
     case EX_GPS_DISTANCE_TO_HOME:
-        return GPS_distanceToHome;
+        return telemetrySensorValue(TELEM_GPS_HOME_DISTANCE);
     break;
 
     case EX_GPS_DIRECTION_TO_HOME:
-        return GPS_directionToHome;
+        return telemetrySensorValue(TELEM_GPS_HOME_DIRECTION);
     break;
 
     case EX_GPS_HEADING:
-        return gpsSol.groundCourse;
+        return telemetrySensorValue(TELEM_GPS_GROUNDCOURSE);
     break;
 
     case EX_GPS_ALTITUDE:
-        return gpsSol.llh.altCm;
+        return telemetrySensorValue(TELEM_GPS_ALTITUDE);
     break;
 #endif
 
 #if defined(USE_ACC)
     case EX_GFORCE_X:
-       return (int16_t)(((float)acc.accADC[0] / acc.dev.acc_1G) * 1000);
+       return telemetrySensorValue(TELEM_ACCEL_X);
     break;
 
     case EX_GFORCE_Y:
-       return (int16_t)(((float)acc.accADC[1] / acc.dev.acc_1G) * 1000);
+       return telemetrySensorValue(TELEM_ACCEL_Y);
     break;
 
     case EX_GFORCE_Z:
-        return (int16_t)(((float)acc.accADC[2] / acc.dev.acc_1G) * 1000);
+        return telemetrySensorValue(TELEM_ACCEL_Z);
     break;
 #endif
 
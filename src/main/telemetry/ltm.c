@@ -75,6 +75,7 @@
 #include "flight/failsafe.h"
 #include "flight/position.h"
 
+#include "telemetry/sensors.h"
 #include "telemetry/telemetry.h"
 #include "telemetry/ltm.h"
 
@@ -136,23 +137,23 @@ static void ltm_gframe(void)
 
     if (!STATE(GPS_FIX))
         gps_fix_type = 1;
-    else if (gpsSol.numSat < 5)
+    else if (telemetrySensorValue(TELEM_GPS_SATS) < 5)
         gps_fix_type = 2;
     else
         gps_fix_type = 3;
 
     ltm_initialise_packet('G');
-    ltm_serialise_32(gpsSol.llh.lat);
-    ltm_serialise_32(gpsSol.llh.lon);
-    ltm_serialise_8((uint8_t)(gpsSol.groundSpeed / 100));
+    ltm_serialise_32(telemetrySensorValue(TELEM_GPS_LATITUDE));
+    ltm_serialise_32(telemetrySensorValue(TELEM_GPS_LONGITUDE));
+    ltm_serialise_8((uint8_t)(telemetrySensorValue(TELEM_GPS_GROUNDSPEED) / 100));
 
 #if defined(USE_BARO) || defined(USE_RANGEFINDER)
-    ltm_alt = (sensors(SENSOR_RANGEFINDER) || sensors(SENSOR_BARO)) ? getEstimatedAltitudeCm() : gpsSol.llh.altCm;
+    ltm_alt = (sensors(SENSOR_RANGEFINDER) || sensors(SENSOR_BARO)) ? telemetrySensorValue(TELEM_ALTITUDE) : telemetrySensorValue(TELEM_GPS_ALTITUDE);
 #else
-    ltm_alt = gpsSol.llh.altCm;
+    ltm_alt = telemetrySensorValue(TELEM_GPS_ALTITUDE);
 #endif
     ltm_serialise_32(ltm_alt);
-    ltm_serialise_8((gpsSol.numSat << 2) | gps_fix_type);
+    ltm_serialise_8((telemetrySensorValue(TELEM_GPS_SATS) << 2) | gps_fix_type);
     ltm_finalise();
 #endif
 }
@@ -185,7 +186,7 @@ static void ltm_sframe(void)
     if (failsafeIsActive())
         lt_statemode |= 2;
     ltm_initialise_packet('S');
-    ltm_serialise_16(getBatteryVoltage() * 10);    //vbat converted to mV
+    ltm_serialise_16(telemetrySensorValue(TELEM_BATTERY_VOLTAGE) * 10);    //vbat converted to mV
     ltm_serialise_16(0);             //  current, not implemented
     ltm_serialise_8(constrain(scaleRange(getRssi(), 0, RSSI_MAX_VALUE, 0, 255), 0, 255));        // scaled RSSI (uchar)
     ltm_serialise_8(0);              // no airspeed
@@ -200,9 +201,9 @@ static void ltm_sframe(void)
 static void ltm_aframe(void)
 {
     ltm_initialise_packet('A');
-    ltm_serialise_16(DECIDEGREES_TO_DEGREES(attitude.values.pitch));
-    ltm_serialise_16(DECIDEGREES_TO_DEGREES(attitude.values.roll));
-    ltm_serialise_16(DECIDEGREES_TO_DEGREES(attitude.values.yaw));
+    ltm_serialise_16(DECIDEGREES_TO_DEGREES(telemetrySensorValue(TELEM_ATTITUDE_PITCH)));
+    ltm_serialise_16(DECIDEGREES_TO_DEGREES(telemetrySensorValue(TELEM_ATTITUDE_ROLL)));
+    ltm_serialise_16(DECIDEGREES_TO_DEGREES(telemetrySensorValue(TELEM_ATTITUDE_YAW)));
     ltm_finalise();
 }
 
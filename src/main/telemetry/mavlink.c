@@ -68,6 +68,7 @@
 #include "sensors/boardalignment.h"
 #include "sensors/battery.h"
 
+#include "telemetry/sensors.h"
 #include "telemetry/telemetry.h"
 #include "telemetry/mavlink.h"
 
@@ -139,10 +140,10 @@ static int16_t headingOrScaledMilliAmpereHoursDrawn(void)
 {
     if (isAmperageConfigured() && telemetryConfig()->mavlink_mah_as_heading_divisor > 0) {
         // In the Connex Prosight OSD, this goes between 0 and 999, so it will need to be scaled in that range.
-        return getMAhDrawn() / telemetryConfig()->mavlink_mah_as_heading_divisor;
+        return telemetrySensorValue(TELEM_BATTERY_CONSUMPTION) / telemetryConfig()->mavlink_mah_as_heading_divisor;
     }
     // heading Current heading in degrees, in compass units (0..360, 0=north)
-    return DECIDEGREES_TO_DEGREES(attitude.values.yaw);
+    return DECIDEGREES_TO_DEGREES(telemetrySensorValue(TELEM_ATTITUDE_YAW));
 }
 
 
@@ -226,9 +227,9 @@ void mavlinkSendSystemStatus(void)
     int8_t batteryRemaining = 100;
 
     if (getBatteryState() < BATTERY_NOT_PRESENT) {
-        batteryVoltage = isBatteryVoltageConfigured() ? getBatteryVoltage() * 10 : batteryVoltage;
-        batteryAmperage = isAmperageConfigured() ? getAmperage() : batteryAmperage;
-        batteryRemaining = isBatteryVoltageConfigured() ? calculateBatteryPercentageRemaining() : batteryRemaining;
+        batteryVoltage = isBatteryVoltageConfigured() ? telemetrySensorValue(TELEM_BATTERY_VOLTAGE) * 10 : batteryVoltage;
+        batteryAmperage = isAmperageConfigured() ? telemetrySensorValue(TELEM_BATTERY_CURRENT) : batteryAmperage;
+        batteryRemaining = isBatteryVoltageConfigured() ? telemetrySensorValue(TELEM_BATTERY_CHARGE_LEVEL) : batteryRemaining;
     }
 
     mavlink_msg_sys_status_pack(0, 200, &mavMsg,
@@ -309,7 +310,7 @@ void mavlinkSendPosition(void)
         gpsFixType = 1;
     }
     else {
-        if (gpsSol.numSat < 5) {
+        if (telemetrySensorValue(TELEM_GPS_SATS) < 5) {
             gpsFixType = 2;
         }
         else {
@@ -323,21 +324,21 @@ void mavlinkSendPosition(void)
         // fix_type 0-1: no fix, 2: 2D fix, 3: 3D fix. Some applications will not use the value of this field unless it is at least two, so always correctly fill in the fix.
         gpsFixType,
         // lat Latitude in 1E7 degrees
-        gpsSol.llh.lat,
+        telemetrySensorValue(TELEM_GPS_LATITUDE),
         // lon Longitude in 1E7 degrees
-        gpsSol.llh.lon,
+        telemetrySensorValue(TELEM_GPS_LONGITUDE),
         // alt Altitude in 1E3 meters (millimeters) above MSL
-        gpsSol.llh.altCm * 10,
+        telemetrySensorValue(TELEM_GPS_ALTITUDE) * 10,
         // eph GPS HDOP horizontal dilution of position in cm (m*100). If unknown, set to: 65535
         65535,
         // epv GPS VDOP horizontal dilution of position in cm (m*100). If unknown, set to: 65535
         65535,
         // vel GPS ground speed (m/s * 100). If unknown, set to: 65535
-        gpsSol.groundSpeed,
+        telemetrySensorValue(TELEM_GPS_GROUNDSPEED),
         // cog Course over ground (NOT heading, but direction of movement) in degrees * 100, 0.0..359.99 degrees. If unknown, set to: 65535
-        gpsSol.groundCourse * 10,
+        telemetrySensorValue(TELEM_GPS_GROUNDCOURSE) * 10,
         // satellites_visible Number of satellites visible. If unknown, set to 255
-        gpsSol.numSat);
+        telemetrySensorValue(TELEM_GPS_SATS));
     msgLength = mavlink_msg_to_send_buffer(mavBuffer, &mavMsg);
     mavlinkSerialWrite(mavBuffer, msgLength);
 
@@ -346,16 +347,16 @@ void mavlinkSendPosition(void)
         // time_usec Timestamp (microseconds since UNIX epoch or microseconds since system boot)
         micros(),
         // lat Latitude in 1E7 degrees
-        gpsSol.llh.lat,
+        telemetrySensorValue(TELEM_GPS_LATITUDE),
         // lon Longitude in 1E7 degrees
-        gpsSol.llh.lon,
+        telemetrySensorValue(TELEM_GPS_LONGITUDE),
         // alt Altitude in 1E3 meters (millimeters) above MSL
-        gpsSol.llh.altCm * 10,
+        telemetrySensorValue(TELEM_GPS_ALTITUDE) * 10,
         // relative_alt Altitude above ground in meters, expressed as * 1000 (millimeters)
 #if defined(USE_BARO) || defined(USE_RANGEFINDER)
-        (sensors(SENSOR_RANGEFINDER) || sensors(SENSOR_BARO)) ? getEstimatedAltitudeCm() * 10 : gpsSol.llh.altCm * 10,
+        (sensors(SENSOR_RANGEFINDER) || sensors(SENSOR_BARO)) ? telemetrySensorValue(TELEM_ALTITUDE) * 10 : telemetrySensorValue(TELEM_GPS_ALTITUDE) * 10,
 #else
-        gpsSol.llh.altCm * 10,
+        telemetrySensorValue(TELEM_GPS_ALTITUDE) * 10,
 #endif
         // Ground X Speed (Latitude), expressed as m/s * 100
         0,
@@ -388,11 +389,11 @@ void mavlinkSendAttitude(void)
         // time_boot_ms Timestamp (milliseconds since system boot)
         millis(),
         // roll Roll angle (rad)
-        DECIDEGREES_TO_RADIANS(attitude.values.roll),
+        DECIDEGREES_TO_RADIANS(telemetrySensorValue(TELEM_ATTITUDE_ROLL)),
         // pitch Pitch angle (rad)
-        DECIDEGREES_TO_RADIANS(-attitude.values.pitch),
+        DECIDEGREES_TO_RADIANS(-telemetrySensorValue(TELEM_ATTITUDE_PITCH)),
         // yaw Yaw angle (rad)
-        DECIDEGREES_TO_RADIANS(attitude.values.yaw),
+        DECIDEGREES_TO_RADIANS(telemetrySensorValue(TELEM_ATTITUDE_YAW)),
         // rollspeed Roll angular speed (rad/s)
         0,
         // pitchspeed Pitch angular speed (rad/s)
@@ -414,7 +415,7 @@ void mavlinkSendHUDAndHeartbeat(void)
 #if defined(USE_GPS)
     // use ground speed if source available
     if (sensors(SENSOR_GPS)) {
-        mavGroundSpeed = gpsSol.groundSpeed / 100.0f;
+        mavGroundSpeed = telemetrySensorValue(TELEM_GPS_GROUNDSPEED) / 100.0f;
     }
 #endif
 
@@ -422,18 +423,18 @@ void mavlinkSendHUDAndHeartbeat(void)
 #if defined(USE_BARO) || defined(USE_RANGEFINDER)
     if (sensors(SENSOR_RANGEFINDER) || sensors(SENSOR_BARO)) {
         // Baro or sonar generally is a better estimate of altitude than GPS MSL altitude
-        mavAltitude = getEstimatedAltitudeCm() / 100.0;
+        mavAltitude = telemetrySensorValue(TELEM_ALTITUDE) / 100.0;
     }
 #if defined(USE_GPS)
     else if (sensors(SENSOR_GPS)) {
         // No sonar or baro, just display altitude above MLS
-        mavAltitude = gpsSol.llh.altCm / 100.0;
+        mavAltitude = telemetrySensorValue(TELEM_GPS_ALTITUDE) / 100.0;
     }
 #endif
 #elif defined(USE_GPS)
     if (sensors(SENSOR_GPS)) {
         // No sonar or baro, just display altitude above MLS
-        mavAltitude = gpsSol.llh.altCm / 100.0;
+        mavAltitude = telemetrySensorValue(TELEM_GPS_ALTITUDE) / 100.0;
     }
 #endif
 
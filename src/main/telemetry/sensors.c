@@ -0,0 +1,304 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Telemetry sensor registry
+ *
+ * All telemetry protocols read their values from here. Each value is
+ * sampled at most once per telemetry tick, on first use, and cached in
+ * a fixed unit and scale. The protocols only convert the cached values
+ * into their own formats.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "platform.h"
+
+#ifdef USE_TELEMETRY
+
+#include "common/axis.h"
+#include "common/bitarray.h"
+#include "common/utils.h"
+
+#include "fc/runtime_config.h"
+
+#include "flight/governor.h"
+#include "flight/imu.h"
+#include "flight/position.h"
+
+#include "io/gps.h"
+
+#include "sensors/acceleration.h"
+#include "sensors/adcinternal.h"
+#include "sensors/battery.h"
+#include "sensors/esc_sensor.h"
+#include "sensors/voltage.h"
+
+#include "telemetry/sensors.h"
+
+
+typedef struct telemetrySensor_s {
+    int32_t (*sample)(void);
+    int8_t scale;           // value is in units of 10^scale
+} telemetrySensor_t;
+
+static int32_t sensorValue[TELEM_SENSOR_COUNT];
+static uint32_t sensorSampled[(TELEM_SENSOR_COUNT + 31) / 32];
+
+
+static int32_t sampleBatteryVoltage(void)
+{
+    return getBatteryVoltage();
+}
+
+static int32_t sampleBatteryCurrent(void)
+{
+    return getAmperage();
+}
+
+static int32_t sampleBatteryConsumption(void)
+{
+    return getMAhDrawn();
+}
+
+static int32_t sampleBatteryChargeLevel(void)
+{
+    return calculateBatteryPercentageRemaining();
+}
+
+static int32_t sampleBatteryCellCount(void)
+{
+    return getBatteryCellCount();
+}
+
+static int32_t sampleBatteryCellVoltage(void)
+{
+    return getBatteryAverageCellVoltage();
+}
+
+static int32_t sampleAltitude(void)
+{
+    return getEstimatedAltitudeCm();
+}
+
+static int32_t sampleVario(void)
+{
+    return getEstimatedVario();
+}
+
+static int32_t sampleAttitudePitch(void)
+{
+    return attitude.values.pitch;
+}
+
+static int32_t sampleAttitudeRoll(void)
+{
+    return attitude.values.roll;
+}
+
+static int32_t sampleAttitudeYaw(void)
+{
+    return attitude.values.yaw;
+}
+
+static int32_t sampleAccel(int axis)
+{
+#ifdef USE_ACC
+    return lrintf(1000 * acc.accADC[axis] * acc.dev.acc_1G_rec);
+#else
+    UNUSED(axis);
+    return 0;
+#endif
+}
+
+static int32_t sampleAccelX(void)
+{
+    return sampleAccel(X);
+}
+
+static int32_t sampleAccelY(void)
+{
+    return sampleAccel(Y);
+}
+
+static int32_t sampleAccelZ(void)
+{
+    return sampleAccel(Z);
+}
+
+#ifdef USE_GPS
+static int32_t sampleGpsSats(void)
+{
+    return gpsSol.numSat;
+}
+
+static int32_t sampleGpsHdop(void)
+{
+    return gpsSol.hdop;
+}
+
+static int32_t sampleGpsLatitude(void)
+{
+    return gpsSol.llh.lat;
+}
+
+static int32_t sampleGpsLongitude(void)
+{
+    return gpsSol.llh.lon;
+}
+
+static int32_t sampleGpsAltitude(void)
+{
+    return gpsSol.llh.altCm;
+}
+
+static int32_t sampleGpsGroundSpeed(void)
+{
+    return gpsSol.groundSpeed;
+}
+
+static int32_t sampleGpsGroundCourse(void)
+{
+    return gpsSol.groundCourse;
+}
+
+static int32_t sampleGpsHomeDistance(void)
+{
+    return GPS_distanceToHome;
+}
+
+static int32_t sampleGpsHomeDirection(void)
+{
+    return GPS_directionToHome;
+}
+#endif
+
+static int32_t sampleHeadspeed(void)
+{
+    return lrintf(getHeadSpeed());
+}
+
+static int32_t sampleGovernorState(void)
+{
+    return getGovernorState();
+}
+
+static int32_t sampleBecVoltage(void)
+{
+    voltageMeter_t meter;
+    voltageMeterRead(VOLTAGE_METER_ID_5V_1, &meter);
+    return meter.displayFiltered;
+}
+
+static int32_t sampleEscTemperature(void)
+{
+#ifdef USE_ESC_SENSOR
+    const escSensorData_t *escData = getEscSensorData(ESC_SENSOR_COMBINED);
+    if (escData && escData->dataAge < ESC_DATA_INVALID) {
+        return escData->temperature;
+    }
+#endif
+    return 0;
+}
+
+static int32_t sampleMcuTemperature(void)
+{
+#ifdef USE_ADC_INTERNAL
+    return getCoreTemperatureCelsius();
+#else
+    return 0;
+#endif
+}
+
+static const telemetrySensor_t telemetrySensors[TELEM_SENSOR_COUNT] = {
+    [TELEM_BATTERY_VOLTAGE]         = { sampleBatteryVoltage,       -2 },
+    [TELEM_BATTERY_CURRENT]         = { sampleBatteryCurrent,       -2 },
+    [TELEM_BATTERY_CONSUMPTION]     = { sampleBatteryConsumption,    0 },
+    [TELEM_BATTERY_CHARGE_LEVEL]    = { sampleBatteryChargeLevel,    0 },
+    [TELEM_BATTERY_CELL_COUNT]      = { sampleBatteryCellCount,      0 },
+    [TELEM_BATTERY_CELL_VOLTAGE]    = { sampleBatteryCellVoltage,   -2 },
+
+    [TELEM_ALTITUDE]                = { sampleAltitude,             -2 },
+    [TELEM_VARIO]                   = { sampleVario,                -2 },
+
+    [TELEM_ATTITUDE_PITCH]          = { sampleAttitudePitch,        -1 },
+    [TELEM_ATTITUDE_ROLL]           = { sampleAttitudeRoll,         -1 },
+    [TELEM_ATTITUDE_YAW]            = { sampleAttitudeYaw,          -1 },
+
+    [TELEM_ACCEL_X]                 = { sampleAccelX,               -3 },
+    [TELEM_ACCEL_Y]                 = { sampleAccelY,               -3 },
+    [TELEM_ACCEL_Z]                 = { sampleAccelZ,               -3 },
+
+#ifdef USE_GPS
+    [TELEM_GPS_SATS]                = { sampleGpsSats,               0 },
+    [TELEM_GPS_HDOP]                = { sampleGpsHdop,              -2 },
+    [TELEM_GPS_LATITUDE]            = { sampleGpsLatitude,          -7 },
+    [TELEM_GPS_LONGITUDE]           = { sampleGpsLongitude,         -7 },
+    [TELEM_GPS_ALTITUDE]            = { sampleGpsAltitude,          -2 },
+    [TELEM_GPS_GROUNDSPEED]         = { sampleGpsGroundSpeed,       -2 },
+    [TELEM_GPS_GROUNDCOURSE]        = { sampleGpsGroundCourse,      -1 },
+    [TELEM_GPS_HOME_DISTANCE]       = { sampleGpsHomeDistance,       0 },
+    [TELEM_GPS_HOME_DIRECTION]      = { sampleGpsHomeDirection,      0 },
+#endif
+
+    [TELEM_HEADSPEED]               = { sampleHeadspeed,             0 },
+    [TELEM_GOVERNOR_STATE]          = { sampleGovernorState,         0 },
+    [TELEM_BEC_VOLTAGE]             = { sampleBecVoltage,           -2 },
+    [TELEM_ESC_TEMPERATURE]         = { sampleEscTemperature,        0 },
+    [TELEM_MCU_TEMPERATURE]         = { sampleMcuTemperature,        0 },
+};
+
+
+/*
+ * Start a new telemetry tick. Called before the protocols run, and by
+ * the receivers that send telemetry outside of the telemetry task.
+ */
+void telemetrySensorsUpdate(void)
+{
+    memset(sensorSampled, 0, sizeof(sensorSampled));
+}
+
+int32_t telemetrySensorValue(telemetrySensor_e sensor)
+{
+    if (!bitArrayGet(sensorSampled, sensor)) {
+        const telemetrySensor_t *entry = &telemetrySensors[sensor];
+        sensorValue[sensor] = entry->sample ? entry->sample() : 0;
+        bitArraySet(sensorSampled, sensor);
+    }
+
+    return sensorValue[sensor];
+}
+
+// Value in units of 10^scale, truncated towards zero
+int32_t telemetrySensorValueScaled(telemetrySensor_e sensor, int8_t scale)
+{
+    int32_t value = telemetrySensorValue(sensor);
+
+    for (int exp = telemetrySensors[sensor].scale; exp < scale; exp++) {
+        value /= 10;
+    }
+    for (int exp = telemetrySensors[sensor].scale; exp > scale; exp--) {
+        value *= 10;
+    }
+
+    return value;
+}
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "platform.h"
+
+
+typedef enum {
+    TELEM_BATTERY_VOLTAGE = 0,          // 0.01V
+    TELEM_BATTERY_CURRENT,              // 0.01A
+    TELEM_BATTERY_CONSUMPTION,          // mAh
+    TELEM_BATTERY_CHARGE_LEVEL,         // %
+    TELEM_BATTERY_CELL_COUNT,
+    TELEM_BATTERY_CELL_VOLTAGE,         // 0.01V
+
+    TELEM_ALTITUDE,                     // cm
+    TELEM_VARIO,                        // cm/s
+
+    TELEM_ATTITUDE_PITCH,               // 0.1°
+    TELEM_ATTITUDE_ROLL,                // 0.1°
+    TELEM_ATTITUDE_YAW,                 // 0.1°
+
+    TELEM_ACCEL_X,                      // 0.001G
+    TELEM_ACCEL_Y,                      // 0.001G
+    TELEM_ACCEL_Z,                      // 0.001G
+
+    TELEM_GPS_SATS,
+    TELEM_GPS_HDOP,                     // 0.01
+    TELEM_GPS_LATITUDE,                 // 0.0000001°
+    TELEM_GPS_LONGITUDE,                // 0.0000001°
+    TELEM_GPS_ALTITUDE,                 // cm
+    TELEM_GPS_GROUNDSPEED,              // cm/s
+    TELEM_GPS_GROUNDCOURSE,             // 0.1°
+    TELEM_GPS_HOME_DISTANCE,            // m
+    TELEM_GPS_HOME_DIRECTION,           // °
+
+    TELEM_HEADSPEED,                    // rpm
+    TELEM_GOVERNOR_STATE,
+    TELEM_BEC_VOLTAGE,                  // 0.01V
+    TELEM_ESC_TEMPERATURE,              // °C
+    TELEM_MCU_TEMPERATURE,              // °C
+
+    TELEM_SENSOR_COUNT
+} telemetrySensor_e;
+
+
+void telemetrySensorsUpdate(void);
+
+int32_t telemetrySensorValue(telemetrySensor_e sensor);
+int32_t telemetrySensorValueScaled(telemetrySensor_e sensor, int8_t scale);
@@ -81,6 +81,7 @@
 #include "sensors/sensors.h"
 
 #include "telemetry/msp_shared.h"
+#include "telemetry/sensors.h"
 #include "telemetry/smartport.h"
 #include "telemetry/telemetry.h"
 
@@ -127,6 +128,7 @@ enum
     FSSP_DATAID_CELLS      = 0x0300 ,
     FSSP_DATAID_CELLS_LAST = 0x030F ,
     FSSP_DATAID_HEADING    = 0x0840 ,
+    FSSP_DATAID_GOV_STATE  = 0x5250 , // custom
 #if defined(USE_ACC)
     FSSP_DATAID_PITCH      = 0x5230 , // custom
     FSSP_DATAID_ROLL       = 0x5240 , // custom
@@ -154,7 +156,7 @@ enum
 };
 
 // if adding more sensors then increase this value (should be equal to the maximum number of ADD_SENSOR calls)
-#define MAX_DATAIDS 20
+#define MAX_DATAIDS 22
 
 static uint16_t frSkyDataIdTable[MAX_DATAIDS];
 
@@ -350,6 +352,12 @@ static void initSmartPortSensors(void)
         ADD_SENSOR(FSSP_DATAID_A4);
     }
 
+#ifdef ADC_POWER_5V
+    if (telemetryIsSensorEnabled(SENSOR_BEC_VOLTAGE)) {
+        ADD_SENSOR(FSSP_DATAID_A3);
+    }
+#endif
+
     if (isAmperageConfigured() && telemetryIsSensorEnabled(SENSOR_CURRENT)) {
 #ifdef USE_ESC_SENSOR_TELEMETRY
         if (!telemetryIsSensorEnabled(ESC_SENSOR_CURRENT))
@@ -367,6 +375,10 @@ static void initSmartPortSensors(void)
         ADD_SENSOR(FSSP_DATAID_HEADING);
     }
 
+    if (telemetryIsSensorEnabled(SENSOR_GOVERNOR)) {
+        ADD_SENSOR(FSSP_DATAID_GOV_STATE);
+    }
+
 #if defined(USE_ACC)
     if (sensors(SENSOR_ACC)) {
         if (telemetryIsSensorEnabled(SENSOR_PITCH)) {
@@ -611,10 +623,10 @@ void processSmartPortTelemetry(smartPortPayload_t *payload, volatile bool *clear
 
         switch (id) {
             case FSSP_DATAID_VFAS       :
-                vfasVoltage = getBatteryVoltage();
+                vfasVoltage = telemetrySensorValue(TELEM_BATTERY_VOLTAGE);
                 if (telemetryConfig()->report_cell_voltage) {
-                    cellCount = getBatteryCellCount();
-                    vfasVoltage = cellCount ? getBatteryVoltage() / cellCount : 0;
+                    cellCount = telemetrySensorValue(TELEM_BATTERY_CELL_COUNT);
+                    vfasVoltage = cellCount ? vfasVoltage / cellCount : 0;
                 }
                 smartPortSendPackage(id, vfasVoltage); // in 0.01V according to SmartPort spec
                 *clearToSend = false;
@@ -636,7 +648,7 @@ void processSmartPortTelemetry(smartPortPayload_t *payload, volatile bool *clear
                 break;
 #endif
             case FSSP_DATAID_CURRENT    :
-                smartPortSendPackage(id, getAmperage() / 10); // in 0.1A according to SmartPort spec
+                smartPortSendPackage(id, telemetrySensorValueScaled(TELEM_BATTERY_CURRENT, -1)); // in 0.1A according to SmartPort spec
                 *clearToSend = false;
                 break;
 #ifdef USE_ESC_SENSOR_TELEMETRY
@@ -656,7 +668,7 @@ void processSmartPortTelemetry(smartPortPayload_t *payload, volatile bool *clear
                 break;
             case FSSP_DATAID_RPM        :
                 if (isRpmSourceActive()) {
-                    smartPortSendPackage(id, getHeadSpeed());
+                    smartPortSendPackage(id, telemetrySensorValue(TELEM_HEADSPEED));
                     *clearToSend = false;
                 }
                 break;
@@ -674,9 +686,8 @@ void processSmartPortTelemetry(smartPortPayload_t *payload, volatile bool *clear
                 }
                 break;
             case FSSP_DATAID_TEMP        :
-                escData = getEscSensorData(ESC_SENSOR_COMBINED);
-                if (escData != NULL) {
-                    smartPortSendPackage(id, escData->temperature);
+                if (getEscSensorData(ESC_SENSOR_COMBINED) != NULL) {
+                    smartPortSendPackage(id, telemetrySensorValue(TELEM_ESC_TEMPERATURE));
                     *clearToSend = false;
                 }
                 break;
@@ -696,40 +707,40 @@ void processSmartPortTelemetry(smartPortPayload_t *payload, volatile bool *clear
                 break;
 #endif
             case FSSP_DATAID_ALTITUDE   :
-                smartPortSendPackage(id, getEstimatedAltitudeCm()); // in cm according to SmartPort spec
+                smartPortSendPackage(id, telemetrySensorValue(TELEM_ALTITUDE)); // in cm according to SmartPort spec
                 *clearToSend = false;
                 break;
             case FSSP_DATAID_FUEL       :
-                smartPortSendPackage(id, getMAhDrawn()); // given in mAh, should be in percent according to SmartPort spec
+                smartPortSendPackage(id, telemetrySensorValue(TELEM_BATTERY_CONSUMPTION)); // given in mAh, should be in percent according to SmartPort spec
                 *clearToSend = false;
                 break;
             case FSSP_DATAID_VARIO      :
-                smartPortSendPackage(id, getEstimatedVario()); // in cm/s according to SmartPort spec
+                smartPortSendPackage(id, telemetrySensorValue(TELEM_VARIO)); // in cm/s according to SmartPort spec
                 *clearToSend = false;
                 break;
             case FSSP_DATAID_HEADING    :
-                smartPortSendPackage(id, attitude.values.yaw * 10); // in degrees * 100 according to SmartPort spec
+                smartPortSendPackage(id, telemetrySensorValue(TELEM_ATTITUDE_YAW) * 10); // in degrees * 100 according to SmartPort spec
                 *clearToSend = false;
                 break;
 #if defined(USE_ACC)
             case FSSP_DATAID_PITCH      :
-                smartPortSendPackage(id, attitude.values.pitch); // given in 10*deg
+                smartPortSendPackage(id, telemetrySensorValue(TELEM_ATTITUDE_PITCH)); // given in 10*deg
                 *clearToSend = false;
                 break;
             case FSSP_DATAID_ROLL       :
-                smartPortSendPackage(id, attitude.values.roll); // given in 10*deg
+                smartPortSendPackage(id, telemetrySensorValue(TELEM_ATTITUDE_ROLL)); // given in 10*deg
                 *clearToSend = false;
                 break;
             case FSSP_DATAID_ACCX       :
-                smartPortSendPackage(id, lrintf(100 * acc.accADC[X] * acc.dev.acc_1G_rec)); // Multiply by 100 to show as x.xx g on Taranis
+                smartPortSendPackage(id, telemetrySensorValue(TELEM_ACCEL_X) / 10); // Divide by 10 to show as x.xx g on Taranis
                 *clearToSend = false;
                 break;
             case FSSP_DATAID_ACCY       :
-                smartPortSendPackage(id, lrintf(100 * acc.accADC[Y] * acc.dev.acc_1G_rec));
+                smartPortSendPackage(id, telemetrySensorValue(TELEM_ACCEL_Y) / 10);
                 *clearToSend = false;
                 break;
             case FSSP_DATAID_ACCZ       :
-                smartPortSendPackage(id, lrintf(100 * acc.accADC[Z] * acc.dev.acc_1G_rec));
+                smartPortSendPackage(id, telemetrySensorValue(TELEM_ACCEL_Z) / 10);
                 *clearToSend = false;
                 break;
 #endif
@@ -771,8 +782,8 @@ void processSmartPortTelemetry(smartPortPayload_t *payload, volatile bool *clear
 #ifdef USE_GPS
                 if (sensors(SENSOR_GPS)) {
                     // satellite accuracy HDOP: 0 = worst [HDOP > 5.5m], 9 = best [HDOP <= 1.0m]
-                    uint16_t hdop = constrain(scaleRange(gpsSol.hdop, 100, 550, 9, 0), 0, 9) * 100;
-                    smartPortSendPackage(id, (STATE(GPS_FIX) ? 1000 : 0) + (STATE(GPS_FIX_HOME) ? 2000 : 0) + hdop + gpsSol.numSat);
+                    uint16_t hdop = constrain(scaleRange(telemetrySensorValue(TELEM_GPS_HDOP), 100, 550, 9, 0), 0, 9) * 100;
+                    smartPortSendPackage(id, (STATE(GPS_FIX) ? 1000 : 0) + (STATE(GPS_FIX_HOME) ? 2000 : 0) + hdop + telemetrySensorValue(TELEM_GPS_SATS));
                     *clearToSend = false;
                 } else if (featureIsEnabled(FEATURE_GPS)) {
                     smartPortSendPackage(id, 0);
@@ -814,7 +825,7 @@ void processSmartPortTelemetry(smartPortPayload_t *payload, volatile bool *clear
                 break;
 #if defined(USE_ADC_INTERNAL)
             case FSSP_DATAID_T11        :
-                smartPortSendPackage(id, getCoreTemperatureCelsius());
+                smartPortSendPackage(id, telemetrySensorValue(TELEM_MCU_TEMPERATURE));
                 *clearToSend = false;
                 break;
 #endif
@@ -823,7 +834,7 @@ void processSmartPortTelemetry(smartPortPayload_t *payload, volatile bool *clear
                 if (STATE(GPS_FIX)) {
                     //convert to knots: 1cm/s = 0.0194384449 knots
                     //Speed should be sent in knots/1000 (GPS speed is in cm/s)
-                    uint32_t tmpui = gpsSol.groundSpeed * 1944 / 100;
+                    uint32_t tmpui = telemetrySensorValue(TELEM_GPS_GROUNDSPEED) * 1944 / 100;
                     smartPortSendPackage(id, tmpui);
                     *clearToSend = false;
                 }
@@ -835,14 +846,16 @@ void processSmartPortTelemetry(smartPortPayload_t *payload, volatile bool *clear
                     // the MSB of the sent uint32_t helps FrSky keep track
                     // the even/odd bit of our counter helps us keep track
                     if (tableInfo->index & 1) {
-                        tmpui = abs(gpsSol.llh.lon);  // now we have unsigned value and one bit to spare
+                        const int32_t lon = telemetrySensorValue(TELEM_GPS_LONGITUDE);
+                        tmpui = abs(lon);  // now we have unsigned value and one bit to spare
                         tmpui = (tmpui + tmpui / 2) / 25 | 0x80000000;  // 6/100 = 1.5/25, division by power of 2 is fast
-                        if (gpsSol.llh.lon < 0) tmpui |= 0x40000000;
+                        if (lon < 0) tmpui |= 0x40000000;
                     }
                     else {
-                        tmpui = abs(gpsSol.llh.lat);  // now we have unsigned value and one bit to spare
+                        const int32_t lat = telemetrySensorValue(TELEM_GPS_LATITUDE);
+                        tmpui = abs(lat);  // now we have unsigned value and one bit to spare
                         tmpui = (tmpui + tmpui / 2) / 25;  // 6/100 = 1.5/25, division by power of 2 is fast
-                        if (gpsSol.llh.lat < 0) tmpui |= 0x40000000;
+                        if (lat < 0) tmpui |= 0x40000000;
                     }
                     smartPortSendPackage(id, tmpui);
                     *clearToSend = false;
@@ -850,23 +863,31 @@ void processSmartPortTelemetry(smartPortPayload_t *payload, volatile bool *clear
                 break;
             case FSSP_DATAID_HOME_DIST  :
                 if (STATE(GPS_FIX)) {
-                    smartPortSendPackage(id, GPS_distanceToHome);
+                    smartPortSendPackage(id, telemetrySensorValue(TELEM_GPS_HOME_DISTANCE));
                      *clearToSend = false;
                 }
                 break;
             case FSSP_DATAID_GPS_ALT    :
                 if (STATE(GPS_FIX)) {
-                    smartPortSendPackage(id, gpsSol.llh.altCm); // in cm according to SmartPort spec
+                    smartPortSendPackage(id, telemetrySensorValue(TELEM_GPS_ALTITUDE)); // in cm according to SmartPort spec
                     *clearToSend = false;
                 }
                 break;
 #endif
             case FSSP_DATAID_A4         :
-                cellCount = getBatteryCellCount();
-                vfasVoltage = cellCount ? (getBatteryVoltage() / cellCount) : 0; // in 0.01V according to SmartPort spec
+                cellCount = telemetrySensorValue(TELEM_BATTERY_CELL_COUNT);
+                vfasVoltage = cellCount ? (telemetrySensorValue(TELEM_BATTERY_VOLTAGE) / cellCount) : 0; // in 0.01V according to SmartPort spec
                 smartPortSendPackage(id, vfasVoltage);
                 *clearToSend = false;
                 break;
+            case FSSP_DATAID_A3         :
+                smartPortSendPackage(id, telemetrySensorValue(TELEM_BEC_VOLTAGE)); // in 0.01V according to SmartPort spec
+                *clearToSend = false;
+                break;
+            case FSSP_DATAID_GOV_STATE  :
+                smartPortSendPackage(id, telemetrySensorValue(TELEM_GOVERNOR_STATE));
+                *clearToSend = false;
+                break;
             default:
                 break;
                 // if nothing is sent, hasRequest isn't cleared, we already incremented the counter, just loop back to the start
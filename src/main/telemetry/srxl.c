@@ -61,6 +61,7 @@
 #include "sensors/adcinternal.h"
 #include "sensors/esc_sensor.h"
 
+#include "telemetry/sensors.h"
 #include "telemetry/telemetry.h"
 #include "telemetry/srxl.h"
 
@@ -188,7 +189,7 @@ uint16_t getMotorAveragePeriod(void)
     if (!isRpmSourceActive()) {
         return SPEKTRUM_RPM_UNUSED;
     }
-    rpm = getHeadSpeed();
+    rpm = telemetrySensorValue(TELEM_HEADSPEED);
 
     if (rpm > SPEKTRUM_MIN_RPM && rpm < SPEKTRUM_MAX_RPM) {
         period_us = MICROSEC_PER_MINUTE / rpm; // revs/minute -> microSeconds
@@ -203,7 +204,7 @@ bool srxlFrameRpm(sbuf_t *dst, timeUs_t currentTimeUs)
 {
     int16_t coreTemp = SPEKTRUM_TEMP_UNUSED;
 #if defined(USE_ADC_INTERNAL)
-    coreTemp = getCoreTemperatureCelsius();
+    coreTemp = telemetrySensorValue(TELEM_MCU_TEMPERATURE);
     coreTemp = coreTemp * 9 / 5 + 32; // C -> F
 #endif
 
@@ -213,9 +214,9 @@ bool srxlFrameRpm(sbuf_t *dst, timeUs_t currentTimeUs)
     sbufWriteU8(dst, SRXL_FRAMETYPE_SID);
     sbufWriteU16BigEndian(dst, getMotorAveragePeriod());    // pulse leading edges
     if (telemetryConfig()->report_cell_voltage) {
-        sbufWriteU16BigEndian(dst, getBatteryAverageCellVoltage()); // Cell voltage is in units of 0.01V
+        sbufWriteU16BigEndian(dst, telemetrySensorValue(TELEM_BATTERY_CELL_VOLTAGE)); // Cell voltage is in units of 0.01V
     } else {
-        sbufWriteU16BigEndian(dst, getBatteryVoltage());   // vbat is in units of 0.01V
+        sbufWriteU16BigEndian(dst, telemetrySensorValue(TELEM_BATTERY_VOLTAGE));   // vbat is in units of 0.01V
     }
     sbufWriteU16BigEndian(dst, coreTemp);                   // temperature
     sbufFill(dst, STRU_TELE_RPM_EMPTY_FIELDS_VALUE, STRU_TELE_RPM_EMPTY_FIELDS_COUNT);
@@ -283,36 +284,36 @@ bool srxlFrameGpsLoc(sbuf_t *dst, timeUs_t currentTimeUs)
     uint16_t altitudeLoBcd, groundCourseBcd, hdop;
     uint8_t hdopBcd, gpsFlags;
 
-    if (!featureIsEnabled(FEATURE_GPS) || !STATE(GPS_FIX) || gpsSol.numSat < 6) {
+    if (!featureIsEnabled(FEATURE_GPS) || !STATE(GPS_FIX) || telemetrySensorValue(TELEM_GPS_SATS) < 6) {
         return false;
     }
 
     // lattitude
-    GPStoDDDMM_MMMM(gpsSol.llh.lat, &coordinate);
+    GPStoDDDMM_MMMM(telemetrySensorValue(TELEM_GPS_LATITUDE), &coordinate);
     latitudeBcd  = (dec2bcd(coordinate.dddmm) << 16) | dec2bcd(coordinate.mmmm);
 
     // longitude
-    GPStoDDDMM_MMMM(gpsSol.llh.lon, &coordinate);
+    GPStoDDDMM_MMMM(telemetrySensorValue(TELEM_GPS_LONGITUDE), &coordinate);
     longitudeBcd = (dec2bcd(coordinate.dddmm) << 16) | dec2bcd(coordinate.mmmm);
 
     // altitude (low order)
-    altitudeLo = ABS(gpsSol.llh.altCm) / 10;
+    altitudeLo = ABS(telemetrySensorValue(TELEM_GPS_ALTITUDE)) / 10;
     altitudeLoBcd = dec2bcd(altitudeLo % 100000);
 
     // Ground course
-    groundCourseBcd = dec2bcd(gpsSol.groundCourse);
+    groundCourseBcd = dec2bcd(telemetrySensorValue(TELEM_GPS_GROUNDCOURSE));
 
     // HDOP
-    hdop = gpsSol.hdop / 10;
+    hdop = telemetrySensorValue(TELEM_GPS_HDOP) / 10;
     hdop = (hdop > 99) ? 99 : hdop;
     hdopBcd = dec2bcd(hdop);
 
     // flags
     gpsFlags = GPS_FLAGS_GPS_DATA_RECEIVED_BIT | GPS_FLAGS_GPS_FIX_VALID_BIT | GPS_FLAGS_3D_FIX_BIT;
-    gpsFlags |= (gpsSol.llh.lat > 0) ? GPS_FLAGS_IS_NORTH_BIT : 0;
-    gpsFlags |= (gpsSol.llh.lon > 0) ? GPS_FLAGS_IS_EAST_BIT : 0;
-    gpsFlags |= (gpsSol.llh.altCm < 0) ? GPS_FLAGS_NEGATIVE_ALT_BIT : 0;
-    gpsFlags |= (gpsSol.llh.lon / GPS_DEGREES_DIVIDER > 99) ? GPS_FLAGS_LONGITUDE_GREATER_99_BIT : 0;
+    gpsFlags |= (telemetrySensorValue(TELEM_GPS_LATITUDE) > 0) ? GPS_FLAGS_IS_NORTH_BIT : 0;
+    gpsFlags |= (telemetrySensorValue(TELEM_GPS_LONGITUDE) > 0) ? GPS_FLAGS_IS_EAST_BIT : 0;
+    gpsFlags |= (telemetrySensorValue(TELEM_GPS_ALTITUDE) < 0) ? GPS_FLAGS_NEGATIVE_ALT_BIT : 0;
+    gpsFlags |= (telemetrySensorValue(TELEM_GPS_LONGITUDE) / GPS_DEGREES_DIVIDER > 99) ? GPS_FLAGS_LONGITUDE_GREATER_99_BIT : 0;
 
     // SRXL frame
     sbufWriteU8(dst, SRXL_FRAMETYPE_GPS_LOC);
@@ -351,16 +352,16 @@ bool srxlFrameGpsStat(sbuf_t *dst, timeUs_t currentTimeUs)
     uint8_t numSatBcd, altitudeHighBcd;
     bool timeProvided = false;
 
-    if (!featureIsEnabled(FEATURE_GPS) || !STATE(GPS_FIX) || gpsSol.numSat < 6) {
+    if (!featureIsEnabled(FEATURE_GPS) || !STATE(GPS_FIX) || telemetrySensorValue(TELEM_GPS_SATS) < 6) {
         return false;
     }
 
     // Number of sats and altitude (high bits)
-    numSatBcd = (gpsSol.numSat > 99) ? dec2bcd(99) : dec2bcd(gpsSol.numSat);
-    altitudeHighBcd = dec2bcd(gpsSol.llh.altCm / 100000);
+    numSatBcd = (telemetrySensorValue(TELEM_GPS_SATS) > 99) ? dec2bcd(99) : dec2bcd(telemetrySensorValue(TELEM_GPS_SATS));
+    altitudeHighBcd = dec2bcd(telemetrySensorValue(TELEM_GPS_ALTITUDE) / 100000);
 
     // Speed (knots)
-    speedTmp = gpsSol.groundSpeed * 1944 / 1000;
+    speedTmp = telemetrySensorValue(TELEM_GPS_GROUNDSPEED) * 1944 / 1000;
     speedKnotsBcd = (speedTmp > 9999) ? dec2bcd(9999) : dec2bcd(speedTmp);
 
 #ifdef USE_RTC_TIME
@@ -418,8 +419,8 @@ typedef struct
 
 bool srxlFrameFlightPackCurrent(sbuf_t *dst, timeUs_t currentTimeUs)
 {
-    uint16_t amps = getAmperage() / 10;
-    uint16_t mah  = getMAhDrawn();
+    uint16_t amps = telemetrySensorValue(TELEM_BATTERY_CURRENT) / 10;
+    uint16_t mah  = telemetrySensorValue(TELEM_BATTERY_CONSUMPTION);
     static uint16_t sentAmps;
     static uint16_t sentMah;
     static timeUs_t lastTimeSentFPmAh = 0;
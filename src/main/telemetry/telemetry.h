@@ -70,7 +70,10 @@ typedef enum {
                             | ESC_SENSOR_RPM \
                             | ESC_SENSOR_TEMPERATURE,
     SENSOR_TEMPERATURE     = 1 << 19,
-    SENSOR_ALL             = (1 << 20) - 1,
+    SENSOR_HEADSPEED       = 1 << 20,
+    SENSOR_GOVERNOR        = 1 << 21,
+    SENSOR_BEC_VOLTAGE     = 1 << 22,
+    SENSOR_ALL             = (1 << 23) - 1,
 } sensor_e;
 
 typedef struct telemetryConfig_s {
@@ -86,6 +89,7 @@ typedef struct telemetryConfig_s {
     uint8_t report_cell_voltage;
     uint8_t flysky_sensors[IBUS_SENSOR_COUNT];
     uint16_t mavlink_mah_as_heading_divisor;
+    uint8_t crsf_telemetry_ratio;           // link packets per telemetry frame, 0 = unpaced
     uint32_t disabledSensors; // bit flags
 } telemetryConfig_t;
 
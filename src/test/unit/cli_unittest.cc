@@ -204,6 +204,22 @@ const uint32_t baudRates[] = {0, 9600, 19200, 38400, 57600, 115200, 230400, 2500
 
 uint32_t micros(void) {return 0;}
 
+uint16_t findSettingIndex(const char *name, uint8_t length)
+{
+    for (uint16_t i = 0; i < valueTableEntryCount; i++) {
+        if (strncasecmp(name, valueTable[i].name, length) == 0 && valueTable[i].name[length] == '\0') {
+            return i;
+        }
+    }
+    return valueTableEntryCount;
+}
+
+void getSettingMinMax(const clivalue_t *, int *min, int *max)
+{
+    *min = 0;
+    *max = 0;
+}
+
 int32_t getAmperage(void) {
     return 100;
 }
@@ -322,6 +338,7 @@ uint32_t serialRxBytesWaiting(const serialPort_t *) {return 0;}
 uint8_t serialRead(serialPort_t *){return 0;}
 
 void bufWriterAppend(bufWriter_t *, uint8_t ch){ printf("%c", ch); }
+void bufWriterAppendData(bufWriter_t *, const void *data, int count){ printf("%.*s", count, (const char *)data); }
 void serialWriteBufShim(void *, const uint8_t *, int) {}
 bufWriter_t *bufWriterInit(uint8_t *, int, bufWrite_t, void *) {return NULL;}
 void schedulerSetCalulateTaskStatistics(bool) {}
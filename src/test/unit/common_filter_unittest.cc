@@ -114,3 +114,169 @@ TEST(FilterUnittest, TestSlewFilter)
     slewFilterApply(&filter, 200.0f);
     EXPECT_EQ(200, filter.state);
 }
+
+TEST(FilterUnittest, TestBiquadFilterPt1)
+{
+    pt1Filter_t pt1;
+    biquadFilter_t biquad;
+    pt1FilterInit(&pt1, pt1FilterGain(100.0f, 0.001f));
+    biquadFilterInitPT1(&biquad, pt1FilterGain(100.0f, 0.001f));
+
+    const float input[] = { 1800.0f, -1800.0f, -200.0f, 0.0f, 500.0f };
+    for (unsigned i = 0; i < sizeof(input) / sizeof(input[0]); i++) {
+        EXPECT_FLOAT_EQ(pt1FilterApply(&pt1, input[i]), biquadFilterApplyDF1(&biquad, input[i]));
+    }
+}
+
+TEST(FilterUnittest, TestFilterChain)
+{
+    filterChain_t chain;
+    biquadFilter_t notch, lowpass;
+
+    filterChainReset(&chain);
+    EXPECT_EQ(0, chain.count);
+    EXPECT_FLOAT_EQ(123.0f, filterChainApply(&chain, 123.0f));
+
+    biquadFilterInit(filterChainAddStage(&chain), 200, 250, 3.0f, FILTER_NOTCH);
+    biquadFilterInitPT1(filterChainAddStage(&chain), pt1FilterGain(100.0f, 0.00025f));
+    EXPECT_EQ(2, chain.count);
+
+    biquadFilterInit(&notch, 200, 250, 3.0f, FILTER_NOTCH);
+    biquadFilterInitPT1(&lowpass, pt1FilterGain(100.0f, 0.00025f));
+
+    for (int i = 0; i < 100; i++) {
+        const float input = (i % 7) * 100.0f - 300.0f;
+        const float expected = biquadFilterApplyDF1(&lowpass, biquadFilterApplyDF1(&notch, input));
+        EXPECT_FLOAT_EQ(expected, filterChainApply(&chain, input));
+    }
+
+    while (chain.count < FILTER_CHAIN_MAX_STAGES) {
+        EXPECT_NE(nullptr, filterChainAddStage(&chain));
+    }
+    EXPECT_EQ(nullptr, filterChainAddStage(&chain));
+}
+
+static float lowpassSineGain(lowpassFilterType_e type, float cutoffHz, float signalHz)
+{
+    filterChain_t chain;
+    float peak = 0;
+
+    filterChainReset(&chain);
+    filterChainAddLowpass(&chain, type, cutoffHz, 250);
+
+    for (int i = 0; i < 8000; i++) {
+        const float output = filterChainApply(&chain, sinf(2 * (float)M_PI * signalHz * i * 0.00025f));
+        if (i >= 4000) {
+            peak = fmaxf(peak, fabsf(output));
+        }
+    }
+
+    return peak;
+}
+
+TEST(FilterUnittest, TestHigherOrderLowpass)
+{
+    filterChain_t chain;
+
+    filterChainReset(&chain);
+    EXPECT_NE(nullptr, filterChainAddLowpass(&chain, FILTER_PT3, 100, 250));
+    EXPECT_EQ(3, chain.count);
+    EXPECT_NE(nullptr, filterChainAddLowpass(&chain, FILTER_BUTTERWORTH4, 100, 250));
+    EXPECT_EQ(5, chain.count);
+    while (chain.count + 3 <= FILTER_CHAIN_MAX_STAGES) {
+        EXPECT_NE(nullptr, filterChainAddLowpass(&chain, FILTER_PT3, 100, 250));
+    }
+    const uint8_t count = chain.count;
+    EXPECT_EQ(nullptr, filterChainAddLowpass(&chain, FILTER_PT3, 100, 250));
+    EXPECT_EQ(count, chain.count);
+
+    const lowpassFilterType_e types[] = {
+        FILTER_PT1, FILTER_BIQUAD, FILTER_PT2, FILTER_PT3,
+        FILTER_BUTTERWORTH4, FILTER_BESSEL2, FILTER_BESSEL4,
+    };
+
+    for (unsigned i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+        // unity gain in the passband, -3dB at the cutoff (PTn sections are not prewarped)
+        EXPECT_NEAR(1.0f, lowpassSineGain(types[i], 100, 5), 0.01f);
+        EXPECT_NEAR(0.7071f, lowpassSineGain(types[i], 100, 100), 0.08f);
+    }
+
+    // steeper rolloff with the 4th order Butterworth
+    EXPECT_LT(lowpassSineGain(FILTER_BUTTERWORTH4, 100, 400), lowpassSineGain(FILTER_PT2, 100, 400));
+}
+
+TEST(FilterUnittest, TestSvfNotch)
+{
+    svfFilter_t notch;
+    float peak = 0;
+
+    svfFilterInit(&notch, 150, 3.0f, 250);
+
+    for (int i = 0; i < 8000; i++) {
+        const float output = svfFilterApplyNotch(&notch, sinf(2 * (float)M_PI * 150 * i * 0.00025f));
+        if (i >= 4000) {
+            peak = fmaxf(peak, fabsf(output));
+        }
+    }
+    EXPECT_LT(peak, 0.05f);
+
+    // off the centre frequency the signal passes
+    svfFilterSetFrequency(&notch, 600);
+    peak = 0;
+    for (int i = 0; i < 8000; i++) {
+        const float output = svfFilterApplyNotch(&notch, sinf(2 * (float)M_PI * 150 * i * 0.00025f));
+        if (i >= 4000) {
+            peak = fmaxf(peak, fabsf(output));
+        }
+    }
+    EXPECT_GT(peak, 0.9f);
+}
+
+TEST(FilterUnittest, TestBiquadNotchUpdate)
+{
+    biquadFilter_t reference, notch;
+
+    biquadFilterInit(&notch, 100, 125, 3.0f, FILTER_NOTCH);
+    notch.y1 = 1.0f;
+
+    for (float freq = 20; freq < 3990; freq += 17.5f) {
+        biquadFilterInit(&reference, freq, 125, 3.0f, FILTER_NOTCH);
+        biquadFilterUpdateNotch(&notch, freq, 125, 3.0f);
+
+        EXPECT_NEAR(reference.b0, notch.b0, 1e-5f);
+        EXPECT_NEAR(reference.b1, notch.b1, 1e-5f);
+        EXPECT_NEAR(reference.b2, notch.b2, 1e-5f);
+        EXPECT_NEAR(reference.a1, notch.a1, 1e-5f);
+        EXPECT_NEAR(reference.a2, notch.a2, 1e-5f);
+    }
+
+    // state is kept
+    EXPECT_FLOAT_EQ(1.0f, notch.y1);
+}
+
+TEST(FilterUnittest, TestBiquadNotchDepth)
+{
+    biquadFilter_t notch;
+    float peak;
+
+    // zero depth passes the signal unchanged
+    biquadFilterInit(&notch, 200, 250, 2.0f, FILTER_NOTCH);
+    biquadFilterUpdateNotch(&notch, 200, 250, 2.0f);
+    biquadFilterSetNotchDepth(&notch, 0.0f);
+    for (int i = 0; i < 100; i++) {
+        const float input = (i % 5) * 10.0f;
+        EXPECT_NEAR(input, biquadFilterApplyDF1(&notch, input), 1e-3f);
+    }
+
+    // half depth halves the gain at the centre frequency
+    biquadFilterInit(&notch, 200, 250, 2.0f, FILTER_NOTCH);
+    biquadFilterSetNotchDepth(&notch, 0.5f);
+    peak = 0;
+    for (int i = 0; i < 8000; i++) {
+        const float output = biquadFilterApplyDF1(&notch, sinf(2 * (float)M_PI * 200 * i * 0.00025f));
+        if (i >= 4000) {
+            peak = fmaxf(peak, fabsf(output));
+        }
+    }
+    EXPECT_NEAR(0.5f, peak, 0.01f);
+}
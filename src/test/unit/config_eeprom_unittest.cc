@@ -0,0 +1,331 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/utils.h"
+
+    #include "config/config_eeprom.h"
+    #include "config/config_streamer.h"
+
+    #include "drivers/system.h"
+
+    #include "pg/pg.h"
+    #include "pg/pg_ids.h"
+
+    typedef struct testConfig_s {
+        uint8_t value[16];
+    } testConfig_t;
+
+    PG_DECLARE(testConfig_t, testConfig1);
+    PG_DECLARE(testConfig_t, testConfig2);
+    PG_DECLARE(testConfig_t, testConfig3);
+
+    PG_REGISTER(testConfig_t, testConfig1, PG_RESERVED_FOR_TESTING_1, 0);
+    PG_REGISTER(testConfig_t, testConfig2, PG_RESERVED_FOR_TESTING_2, 0);
+    PG_REGISTER(testConfig_t, testConfig3, PG_RESERVED_FOR_TESTING_3, 0);
+
+    uint8_t eepromData[EEPROM_SIZE];
+
+    static int programmedWords;
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define TEST_PAGE_SIZE  128
+
+static configWriteStatus_e runJournalWrite(bool allowErase = true)
+{
+    configWriteStatus_e status;
+
+    do {
+        status = continueConfigJournalWrite(allowErase);
+    } while (status == CONFIG_WRITE_BUSY);
+
+    return status;
+}
+
+// Write a fresh snapshot of the current PGs, with an empty journal
+static void writeSnapshot(void)
+{
+    memset(eepromData, 0xFF, sizeof(eepromData));
+    writeConfigToEEPROM();
+    ASSERT_TRUE(isEEPROMStructureValid());
+}
+
+static void resetAllPGs(void)
+{
+    PG_FOREACH(reg) {
+        pgReset(reg);
+    }
+}
+
+TEST(ConfigEepromUnittest, TestJournalAppend)
+{
+    resetAllPGs();
+    writeSnapshot();
+
+    const uint16_t snapshotSize = getEEPROMConfigSize();
+    uint8_t snapshot[EEPROM_SIZE];
+    memcpy(snapshot, eepromData, snapshotSize);
+
+    testConfig2Mutable()->value[3] = 42;
+
+    EXPECT_TRUE(startConfigJournalWrite());
+    EXPECT_EQ(CONFIG_WRITE_DONE, runJournalWrite());
+
+    // The snapshot is left alone, the change is appended
+    EXPECT_TRUE(isEEPROMStructureValid());
+    EXPECT_EQ(snapshotSize, getEEPROMConfigSize());
+    EXPECT_EQ(0, memcmp(snapshot, eepromData, snapshotSize));
+
+    resetAllPGs();
+    EXPECT_TRUE(loadEEPROM());
+    EXPECT_EQ(42, testConfig2()->value[3]);
+}
+
+TEST(ConfigEepromUnittest, TestJournalReplay)
+{
+    resetAllPGs();
+    writeSnapshot();
+
+    for (int i = 1; i <= 5; i++) {
+        testConfig1Mutable()->value[0] = i;
+        testConfig3Mutable()->value[15] = 100 + i;
+        EXPECT_TRUE(startConfigJournalWrite());
+        EXPECT_EQ(CONFIG_WRITE_DONE, runJournalWrite());
+    }
+
+    // The latest record of each PG wins
+    resetAllPGs();
+    EXPECT_TRUE(isEEPROMStructureValid());
+    EXPECT_TRUE(loadEEPROM());
+    EXPECT_EQ(5, testConfig1()->value[0]);
+    EXPECT_EQ(105, testConfig3()->value[15]);
+    EXPECT_EQ(0, testConfig2()->value[0]);
+}
+
+TEST(ConfigEepromUnittest, TestRewriteWhenJournalFull)
+{
+    resetAllPGs();
+    writeSnapshot();
+
+    configWriteStatus_e status = CONFIG_WRITE_DONE;
+    int passes = 0;
+
+    while (status == CONFIG_WRITE_DONE && passes < 100) {
+        testConfig1Mutable()->value[1] = ++passes;
+        EXPECT_TRUE(startConfigJournalWrite());
+        status = runJournalWrite();
+    }
+    EXPECT_EQ(CONFIG_WRITE_FULL, status);
+
+    // The blocking save falls back to a snapshot rewrite
+    const uint8_t expected = testConfig1()->value[1];
+    writeConfigToEEPROM();
+    EXPECT_TRUE(isEEPROMStructureValid());
+
+    resetAllPGs();
+    EXPECT_TRUE(loadEEPROM());
+    EXPECT_EQ(expected, testConfig1()->value[1]);
+
+    // The compacted journal takes new records again
+    testConfig1Mutable()->value[1] = 7;
+    EXPECT_TRUE(startConfigJournalWrite());
+    EXPECT_EQ(CONFIG_WRITE_DONE, runJournalWrite());
+}
+
+TEST(ConfigEepromUnittest, TestChangeDuringPass)
+{
+    resetAllPGs();
+    writeSnapshot();
+
+    // The first PG in the registry is written by the first run of the pass
+    const pgRegistry_t *first = __pg_registry_start;
+    first->address[0] = 1;
+
+    // Start the record, write its 7 words and move on past the PG
+    EXPECT_TRUE(startConfigJournalWrite());
+    for (int i = 0; i < 9; i++) {
+        EXPECT_NE(CONFIG_WRITE_FAILED, continueConfigJournalWrite(true));
+    }
+
+    // Saved again after the pass has moved on from that PG
+    first->address[0] = 2;
+    EXPECT_EQ(CONFIG_WRITE_DONE, runJournalWrite());
+
+    resetAllPGs();
+    EXPECT_TRUE(loadEEPROM());
+    EXPECT_EQ(1, first->address[0]);
+
+    // Another pass picks up the second change
+    first->address[0] = 2;
+    EXPECT_TRUE(startConfigJournalWrite());
+    EXPECT_EQ(CONFIG_WRITE_DONE, runJournalWrite());
+
+    resetAllPGs();
+    EXPECT_TRUE(loadEEPROM());
+    EXPECT_EQ(2, first->address[0]);
+}
+
+TEST(ConfigEepromUnittest, TestOneWordPerRun)
+{
+    resetAllPGs();
+    writeSnapshot();
+
+    testConfig1Mutable()->value[0] = 1;
+    testConfig2Mutable()->value[15] = 2;
+    testConfig3Mutable()->value[7] = 3;
+
+    EXPECT_TRUE(startConfigJournalWrite());
+
+    configWriteStatus_e status;
+    int words = 0;
+    do {
+        programmedWords = 0;
+        status = continueConfigJournalWrite(true);
+        EXPECT_LE(programmedWords, 1);
+        words += programmedWords;
+    } while (status == CONFIG_WRITE_BUSY);
+
+    EXPECT_EQ(CONFIG_WRITE_DONE, status);
+    EXPECT_EQ(3 * 7, words);
+}
+
+TEST(ConfigEepromUnittest, TestEraseDeferred)
+{
+    resetAllPGs();
+    writeSnapshot();
+
+    configWriteStatus_e status = CONFIG_WRITE_DONE;
+    int passes = 0;
+
+    // Append records until the next one enters a new page
+    while (status == CONFIG_WRITE_DONE && passes < 20) {
+        testConfig1Mutable()->value[1] = ++passes;
+        EXPECT_TRUE(startConfigJournalWrite());
+        status = runJournalWrite(false);
+    }
+    EXPECT_EQ(CONFIG_WRITE_DEFERRED, status);
+
+    // Nothing is written while erasing is not allowed
+    uint8_t stored[EEPROM_SIZE];
+    memcpy(stored, eepromData, sizeof(eepromData));
+    programmedWords = 0;
+    EXPECT_EQ(CONFIG_WRITE_DEFERRED, runJournalWrite(false));
+    EXPECT_EQ(0, programmedWords);
+    EXPECT_EQ(0, memcmp(stored, eepromData, sizeof(eepromData)));
+
+    // The pass resumes once erasing is allowed
+    EXPECT_EQ(CONFIG_WRITE_DONE, runJournalWrite(true));
+
+    resetAllPGs();
+    EXPECT_TRUE(isEEPROMStructureValid());
+    EXPECT_TRUE(loadEEPROM());
+    EXPECT_EQ(passes, testConfig1()->value[1]);
+}
+
+// STUBS
+
+extern "C" {
+
+void failureMode(failureMode_e mode)
+{
+    ADD_FAILURE() << "failureMode " << mode;
+}
+
+// RAM flash: programming can only clear bits, the snapshot write erases all
+void config_streamer_init(config_streamer_t *c)
+{
+    memset(c, 0, sizeof(*c));
+}
+
+void config_streamer_start(config_streamer_t *c, uintptr_t base, int size)
+{
+    c->address = base;
+    c->size = size;
+    c->unlocked = true;
+    c->err = 0;
+}
+
+static void writeWord(config_streamer_t *c)
+{
+    uint8_t *dst = (uint8_t *)c->address;
+
+    if (dst == eepromData) {
+        memset(eepromData, 0xFF, sizeof(eepromData));
+    }
+    if (dst + sizeof(c->buffer) > ARRAYEND(eepromData)) {
+        c->err = -3;
+        return;
+    }
+    for (unsigned i = 0; i < sizeof(c->buffer); i++) {
+        dst[i] &= c->buffer.b[i];
+    }
+
+    c->address += sizeof(c->buffer);
+    programmedWords++;
+}
+
+// Test pages, the snapshot write at the start of the store erases all
+bool config_streamer_erases(uintptr_t base, int size)
+{
+    const uintptr_t offset = base - (uintptr_t)eepromData;
+
+    return (offset % TEST_PAGE_SIZE == 0) || (offset / TEST_PAGE_SIZE != (offset + size - 1) / TEST_PAGE_SIZE);
+}
+
+int config_streamer_write(config_streamer_t *c, const uint8_t *p, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++) {
+        c->buffer.b[c->at++] = p[i];
+        if (c->at == sizeof(c->buffer)) {
+            writeWord(c);
+            c->at = 0;
+        }
+    }
+    return c->err;
+}
+
+int config_streamer_flush(config_streamer_t *c)
+{
+    if (c->at != 0) {
+        memset(c->buffer.b + c->at, 0, sizeof(c->buffer) - c->at);
+        writeWord(c);
+        c->at = 0;
+    }
+    return c->err;
+}
+
+int config_streamer_finish(config_streamer_t *c)
+{
+    c->unlocked = false;
+    return c->err;
+}
+
+int config_streamer_status(config_streamer_t *c)
+{
+    return c->err;
+}
+
+}
@@ -0,0 +1,260 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/utils.h"
+
+    #include "fc/dispatch.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+static uint32_t simulatedTime = 0;
+
+static int callCount;
+static uint32_t lastCallTime;
+
+static void countingHandler(dispatchEntry_t *self)
+{
+    UNUSED(self);
+    callCount++;
+    lastCallTime = simulatedTime;
+}
+
+static void rearmHandler(dispatchEntry_t *self)
+{
+    countingHandler(self);
+    dispatchAdd(self, 0);
+}
+
+static void slowHandler(dispatchEntry_t *self)
+{
+    countingHandler(self);
+    simulatedTime += DISPATCH_TIME_BUDGET_US + 1;
+}
+
+static void runUntil(uint32_t endTime, uint32_t stepUs)
+{
+    while (cmp32(endTime, simulatedTime) > 0) {
+        simulatedTime += stepUs;
+        dispatchProcess(simulatedTime);
+    }
+}
+
+static void resetTest(uint32_t startTime)
+{
+    simulatedTime = startTime;
+    callCount = 0;
+    lastCallTime = 0;
+    dispatchEnable();
+}
+
+TEST(DispatchUnittest, TestOneShotFiresAtDeadline)
+{
+    resetTest(1000);
+
+    dispatchEntry_t entry = { countingHandler, 0, NULL, false, 0, NULL };
+
+    dispatchAdd(&entry, 1234);
+    EXPECT_TRUE(dispatchIsPending(&entry));
+
+    runUntil(2233, 1);
+    EXPECT_EQ(0, callCount);
+
+    runUntil(2234, 1);
+    EXPECT_EQ(1, callCount);
+    EXPECT_EQ(2234u, lastCallTime);
+    EXPECT_FALSE(dispatchIsPending(&entry));
+
+    runUntil(10000, 1);
+    EXPECT_EQ(1, callCount);
+}
+
+TEST(DispatchUnittest, TestLongDelaysCascade)
+{
+    resetTest(5000);
+
+    dispatchEntry_t shortEntry = { countingHandler, 0, NULL, false, 0, NULL };
+    dispatchEntry_t midEntry = { countingHandler, 0, NULL, false, 0, NULL };
+    dispatchEntry_t longEntry = { countingHandler, 0, NULL, false, 0, NULL };
+    dispatchEntry_t farEntry = { countingHandler, 0, NULL, false, 0, NULL };
+
+    dispatchAdd(&farEntry, 100000000);
+    dispatchAdd(&longEntry, 5000000);
+    dispatchAdd(&midEntry, 500000);
+    dispatchAdd(&shortEntry, 5000);
+
+    runUntil(10000, 1000);
+    EXPECT_EQ(1, callCount);
+    EXPECT_EQ(10000u, lastCallTime);
+
+    runUntil(505000, 1000);
+    EXPECT_EQ(2, callCount);
+    EXPECT_EQ(505000u, lastCallTime);
+
+    runUntil(5005000, 1000);
+    EXPECT_EQ(3, callCount);
+    EXPECT_EQ(5005000u, lastCallTime);
+
+    runUntil(100004000, 1000);
+    EXPECT_EQ(3, callCount);
+
+    runUntil(100005000, 1000);
+    EXPECT_EQ(4, callCount);
+    EXPECT_EQ(100005000u, lastCallTime);
+}
+
+TEST(DispatchUnittest, TestTimerWraparound)
+{
+    resetTest(0xFFFFF000);
+
+    dispatchEntry_t entry = { countingHandler, 0, NULL, false, 0, NULL };
+
+    dispatchAdd(&entry, 20000);
+
+    runUntil(0xFFFFF000 + 19999, 1);
+    EXPECT_EQ(0, callCount);
+
+    runUntil(0xFFFFF000 + 20000, 1);
+    EXPECT_EQ(1, callCount);
+}
+
+TEST(DispatchUnittest, TestCancel)
+{
+    resetTest(0);
+
+    dispatchEntry_t first = { countingHandler, 0, NULL, false, 0, NULL };
+    dispatchEntry_t second = { countingHandler, 0, NULL, false, 0, NULL };
+
+    dispatchAdd(&first, 3000);
+    dispatchAdd(&second, 3000);
+    dispatchCancel(&first);
+    EXPECT_FALSE(dispatchIsPending(&first));
+    EXPECT_TRUE(dispatchIsPending(&second));
+
+    runUntil(10000, 1000);
+    EXPECT_EQ(1, callCount);
+
+    // Cancelling an idle entry is harmless
+    dispatchCancel(&first);
+    dispatchCancel(&second);
+}
+
+TEST(DispatchUnittest, TestAddWhilePending)
+{
+    resetTest(0);
+
+    dispatchEntry_t entry = { countingHandler, 0, NULL, false, 0, NULL };
+
+    dispatchAdd(&entry, 2000);
+    dispatchAdd(&entry, 50000);
+
+    runUntil(2000, 1000);
+    EXPECT_EQ(1, callCount);
+
+    runUntil(60000, 1000);
+    EXPECT_EQ(1, callCount);
+}
+
+TEST(DispatchUnittest, TestPeriodic)
+{
+    resetTest(0);
+
+    dispatchEntry_t entry = { countingHandler, 0, NULL, false, 0, NULL };
+
+    dispatchAddPeriodic(&entry, 10000, 10000);
+
+    runUntil(100000, 1000);
+    EXPECT_EQ(10, callCount);
+    EXPECT_TRUE(dispatchIsPending(&entry));
+
+    // Late processing does not cause a burst of catch-up calls
+    runUntil(200000, 50000);
+    EXPECT_EQ(12, callCount);
+
+    dispatchCancel(&entry);
+    runUntil(300000, 1000);
+    EXPECT_EQ(12, callCount);
+}
+
+TEST(DispatchUnittest, TestHandlerRearmsSelf)
+{
+    resetTest(0);
+
+    dispatchEntry_t entry = { rearmHandler, 0, NULL, false, 0, NULL };
+
+    dispatchAdd(&entry, 1000);
+
+    // Re-adding from the handler is deferred to the next pass
+    runUntil(1000, 1000);
+    EXPECT_EQ(1, callCount);
+    EXPECT_TRUE(dispatchIsPending(&entry));
+
+    runUntil(2000, 1000);
+    EXPECT_EQ(2, callCount);
+
+    dispatchCancel(&entry);
+}
+
+TEST(DispatchUnittest, TestTimeBudget)
+{
+    resetTest(0);
+
+    dispatchEntry_t first = { slowHandler, 0, NULL, false, 0, NULL };
+    dispatchEntry_t second = { slowHandler, 0, NULL, false, 0, NULL };
+    dispatchEntry_t third = { slowHandler, 0, NULL, false, 0, NULL };
+
+    dispatchAdd(&first, 1000);
+    dispatchAdd(&second, 1000);
+    dispatchAdd(&third, 1000);
+
+    // The first handler uses up the budget, the rest wait
+    simulatedTime = 1000;
+    dispatchProcess(simulatedTime);
+    EXPECT_EQ(1, callCount);
+    EXPECT_EQ(2, dispatchIsPending(&first) + dispatchIsPending(&second) + dispatchIsPending(&third));
+
+    // One more handler per call, each of them over budget
+    dispatchProcess(simulatedTime);
+    EXPECT_EQ(2, callCount);
+
+    dispatchProcess(simulatedTime);
+    EXPECT_EQ(3, callCount);
+    EXPECT_FALSE(dispatchIsPending(&first));
+    EXPECT_FALSE(dispatchIsPending(&second));
+    EXPECT_FALSE(dispatchIsPending(&third));
+
+    dispatchProcess(simulatedTime);
+    EXPECT_EQ(3, callCount);
+}
+
+// STUBS
+
+extern "C" {
+
+uint32_t micros(void)
+{
+    return simulatedTime;
+}
+
+}
@@ -35,11 +35,23 @@ extern "C" {
 PG_REGISTER_WITH_RESET_TEMPLATE(motorConfig_t, motorConfig, PG_MOTOR_CONFIG, 1);
 
 PG_RESET_TEMPLATE(motorConfig_t, motorConfig,
+    .dev = {.motorPwmRate = 400},
     .minthrottle = 1150,
     .maxthrottle = 1850,
     .mincommand = 1000,
-    .dev = {.motorPwmRate = 400}
 );
+
+typedef struct testConfig_s {
+    uint8_t value;
+} testConfig_t;
+
+PG_DECLARE(testConfig_t, testConfig1);
+PG_DECLARE(testConfig_t, testConfig2);
+PG_DECLARE(testConfig_t, testConfig3);
+
+PG_REGISTER(testConfig_t, testConfig2, PG_RESERVED_FOR_TESTING_2, 0);
+PG_REGISTER(testConfig_t, testConfig1, PG_RESERVED_FOR_TESTING_1, 2);
+PG_REGISTER(testConfig_t, testConfig3, PG_RESERVED_FOR_TESTING_3, 1);
 }
 
 
@@ -84,6 +96,24 @@ TEST(ParameterGroupsfTest, Test_pgFind)
     EXPECT_EQ(400, motorConfig3.dev.motorPwmRate);
 }
 
+TEST(ParameterGroupsfTest, Test_pgFindSorted)
+{
+    // every registered PG is found, whatever the link order
+    PG_FOREACH(reg) {
+        EXPECT_EQ(reg, pgFind(pgN(reg)));
+    }
+
+    EXPECT_EQ((uint8_t*)testConfig1Mutable(), pgFind(PG_RESERVED_FOR_TESTING_1)->address);
+    EXPECT_EQ((uint8_t*)testConfig2Mutable(), pgFind(PG_RESERVED_FOR_TESTING_2)->address);
+    EXPECT_EQ((uint8_t*)testConfig3Mutable(), pgFind(PG_RESERVED_FOR_TESTING_3)->address);
+    EXPECT_EQ(2, pgVersion(pgFind(PG_RESERVED_FOR_TESTING_1)));
+
+    // unregistered pgns are not found
+    EXPECT_EQ(NULL, pgFind(0));
+    EXPECT_EQ(NULL, pgFind(PG_MOTOR_CONFIG + 1));
+    EXPECT_EQ(NULL, pgFind(PG_RESERVED_FOR_TESTING_3 - 1));
+}
+
 // STUBS
 
 extern "C" {
@@ -182,6 +182,8 @@ uint8_t respondToIbusRequest(uint8_t const * const ibusPacket) {
     return stubTelemetryIgnoreRxChars;
 }
 
+void telemetrySensorsUpdate(void) {}
+
 void resetStubTelemetry(void)
 {
     memset(stubTelemetryPacket, 0, sizeof(stubTelemetryPacket));
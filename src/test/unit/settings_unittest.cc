@@ -0,0 +1,108 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "build/debug.h"
+
+    #include "cli/settings.h"
+
+    #include "sensors/current.h"
+    #include "sensors/voltage.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+TEST(SettingsUnittest, TestFindEverySetting)
+{
+    for (int i = 0; i < valueTableEntryCount; i++) {
+        const char *name = valueTable[i].name;
+        EXPECT_EQ(i, findSettingIndex(name, strlen(name))) << name;
+    }
+}
+
+TEST(SettingsUnittest, TestFindCaseInsensitive)
+{
+    for (int i = 0; i < valueTableEntryCount; i++) {
+        char name[64];
+        const int length = strlen(valueTable[i].name);
+
+        ASSERT_LT(length, (int)sizeof(name));
+        for (int j = 0; j <= length; j++) {
+            name[j] = toupper((unsigned char)valueTable[i].name[j]);
+        }
+
+        EXPECT_EQ(i, findSettingIndex(name, length)) << name;
+    }
+}
+
+TEST(SettingsUnittest, TestFindNotTerminated)
+{
+    // only the given length of the name is compared
+    const char *name = valueTable[0].name;
+    char buffer[64];
+
+    snprintf(buffer, sizeof(buffer), "%s = 1", name);
+    EXPECT_EQ(0, findSettingIndex(buffer, strlen(name)));
+}
+
+TEST(SettingsUnittest, TestRejectPrefix)
+{
+    for (int i = 0; i < valueTableEntryCount; i++) {
+        const char *name = valueTable[i].name;
+        const int length = strlen(name);
+
+        // a prefix is only found if it is a setting of its own
+        for (int j = 0; j < length; j++) {
+            const uint16_t index = findSettingIndex(name, j);
+            if (index < valueTableEntryCount) {
+                EXPECT_EQ(j, (int)strlen(valueTable[index].name)) << name;
+                EXPECT_EQ(0, strncasecmp(name, valueTable[index].name, j)) << name;
+            }
+        }
+    }
+}
+
+TEST(SettingsUnittest, TestRejectUnknown)
+{
+    EXPECT_EQ(valueTableEntryCount, findSettingIndex("", 0));
+    EXPECT_EQ(valueTableEntryCount, findSettingIndex("no_such_setting", 15));
+
+    // longer than a real name
+    const char *name = valueTable[0].name;
+    char buffer[64];
+
+    snprintf(buffer, sizeof(buffer), "%s_x", name);
+    EXPECT_EQ(valueTableEntryCount, findSettingIndex(buffer, strlen(buffer)));
+}
+
+// STUBS
+
+extern "C" {
+
+const char * const debugModeNames[DEBUG_COUNT] = { NULL };
+const char * const currentMeterSourceNames[CURRENT_METER_COUNT] = { NULL };
+const char * const voltageMeterSourceNames[VOLTAGE_METER_COUNT] = { NULL };
+
+}
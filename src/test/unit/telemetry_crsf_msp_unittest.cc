@@ -60,6 +60,7 @@ extern "C" {
 
     #include "telemetry/telemetry.h"
     #include "telemetry/msp_shared.h"
+    #include "telemetry/sensors.h"
     #include "telemetry/smartport.h"
     #include "sensors/acceleration.h"
 
@@ -251,6 +252,9 @@ TEST(CrossFireMSPTest, SendMspReply) {
 
 extern "C" {
 
+    uint8_t debugMode;
+    int16_t debug[DEBUG16_VALUE_COUNT];
+
     gpsSolutionData_t gpsSol;
     attitudeEulerAngles_t attitude = { { 0, 0, 0 } };
 
@@ -281,6 +285,11 @@ extern "C" {
     	return 0;
     }
 
+    float getHeadSpeed(void) {return 0;}
+
+    int32_t telemetrySensorValue(telemetrySensor_e) {return 0;}
+    int32_t telemetrySensorValueScaled(telemetrySensor_e, int8_t) {return 0;}
+
     bool featureIsEnabled(uint32_t) {return false;}
 
     bool airmodeIsEnabled(void) {return true;}
@@ -56,9 +56,11 @@ extern "C" {
     #include "sensors/battery.h"
     #include "sensors/sensors.h"
     #include "sensors/acceleration.h"
+    #include "sensors/voltage.h"
 
     #include "telemetry/crsf.h"
     #include "telemetry/telemetry.h"
+    #include "telemetry/sensors.h"
     #include "telemetry/msp_shared.h"
 
     rssiSource_e rssiSource;
@@ -67,6 +69,20 @@ extern "C" {
     uint16_t testBatteryVoltage = 0;
     int32_t testAmperage = 0;
     int32_t testmAhDrawn = 0;
+    float testHeadSpeed = 0;
+    uint16_t testBecVoltage = 0;
+    uint32_t testDisabledSensors = 0;
+
+    extern uint8_t crsfScheduleCount;
+    extern timeDelta_t crsfScheduleInterval[];
+    void crsfScheduleBudget(uint16_t frameRate);
+
+    static serialPort_t testSerialPort;
+    static serialPortConfig_t testSerialPortConfig;
+    static rxRuntimeState_t testRxRuntimeState;
+
+    static int frameTypeCount[256];
+    static int frameTypeBytes[256];
 
     serialPort_t *telemetrySharedPort;
     PG_REGISTER(batteryConfig_t, batteryConfig, PG_BATTERY_CONFIG, 0);
@@ -103,6 +119,8 @@ TEST(TelemetryCrsfTest, TestGPS)
 {
     uint8_t frame[CRSF_FRAME_SIZE_MAX];
 
+    telemetrySensorsUpdate();
+
     int frameLen = getCrsfFrame(frame, CRSF_FRAMETYPE_GPS);
     EXPECT_EQ(CRSF_FRAME_GPS_PAYLOAD_SIZE + FRAME_HEADER_FOOTER_LEN, frameLen);
     EXPECT_EQ(CRSF_SYNC_BYTE, frame[0]); // address
@@ -129,6 +147,7 @@ TEST(TelemetryCrsfTest, TestGPS)
     gpsSol.groundSpeed = 1630;                // speed in cm/s, 16.3 m/s = 58.68 km/h, so CRSF (km/h *10) value is 587
     gpsSol.numSat = 9;
     gpsSol.groundCourse = 1479;     // degrees * 10
+    telemetrySensorsUpdate();
     frameLen = getCrsfFrame(frame, CRSF_FRAMETYPE_GPS);
     lattitude = frame[3] << 24 | frame[4] << 16 | frame[5] << 8 | frame[6];
     EXPECT_EQ(560000000, lattitude);
@@ -150,6 +169,7 @@ TEST(TelemetryCrsfTest, TestBattery)
     uint8_t frame[CRSF_FRAME_SIZE_MAX];
 
     testBatteryVoltage = 0; // 0.1V units
+    telemetrySensorsUpdate();
     int frameLen = getCrsfFrame(frame, CRSF_FRAMETYPE_BATTERY_SENSOR);
     EXPECT_EQ(CRSF_FRAME_BATTERY_SENSOR_PAYLOAD_SIZE + FRAME_HEADER_FOOTER_LEN, frameLen);
     EXPECT_EQ(CRSF_SYNC_BYTE, frame[0]); // address
@@ -168,6 +188,7 @@ TEST(TelemetryCrsfTest, TestBattery)
     testBatteryVoltage = 330; // 3.3V = 3300 mv
     testAmperage = 2960; // = 29.60A = 29600mA - amperage is in 0.01A steps
     testmAhDrawn = 1234;
+    telemetrySensorsUpdate();
     frameLen = getCrsfFrame(frame, CRSF_FRAMETYPE_BATTERY_SENSOR);
     voltage = frame[3] << 8 | frame[4]; // mV * 100
     EXPECT_EQ(33, voltage);
@@ -187,6 +208,7 @@ TEST(TelemetryCrsfTest, TestAttitude)
     attitude.values.pitch = 0;
     attitude.values.roll = 0;
     attitude.values.yaw = 0;
+    telemetrySensorsUpdate();
     int frameLen = getCrsfFrame(frame, CRSF_FRAMETYPE_ATTITUDE);
     EXPECT_EQ(CRSF_FRAME_ATTITUDE_PAYLOAD_SIZE + FRAME_HEADER_FOOTER_LEN, frameLen);
     EXPECT_EQ(CRSF_SYNC_BYTE, frame[0]); // address
@@ -203,6 +225,7 @@ TEST(TelemetryCrsfTest, TestAttitude)
     attitude.values.pitch = 678; // decidegrees == 1.183333232852155 rad
     attitude.values.roll = 1495; // 2.609267231731523 rad
     attitude.values.yaw = -1799; //3.139847324337799 rad
+    telemetrySensorsUpdate();
     frameLen = getCrsfFrame(frame, CRSF_FRAMETYPE_ATTITUDE);
     pitch = frame[3] << 8 | frame[4]; // rad / 10000
     EXPECT_EQ(11833, pitch);
@@ -213,6 +236,79 @@ TEST(TelemetryCrsfTest, TestAttitude)
     EXPECT_EQ(crfsCrc(frame, frameLen), frame[9]);
 }
 
+TEST(TelemetryCrsfTest, TestHeadspeed)
+{
+    uint8_t frame[CRSF_FRAME_SIZE_MAX];
+
+    testHeadSpeed = 0;
+    telemetrySensorsUpdate();
+    int frameLen = getCrsfFrame(frame, CRSF_FRAMETYPE_RPM);
+    EXPECT_EQ(CRSF_FRAME_RPM_PAYLOAD_SIZE + FRAME_HEADER_FOOTER_LEN, frameLen);
+    EXPECT_EQ(CRSF_SYNC_BYTE, frame[0]); // address
+    EXPECT_EQ(6, frame[1]); // length
+    EXPECT_EQ(0x0c, frame[2]); // type
+    EXPECT_EQ(0, frame[3]); // source id
+    int32_t headspeed = frame[4] << 16 | frame[5] << 8 | frame[6];
+    EXPECT_EQ(0, headspeed);
+    EXPECT_EQ(crfsCrc(frame, frameLen), frame[7]);
+
+    testHeadSpeed = 2150.4f;
+    telemetrySensorsUpdate();
+    frameLen = getCrsfFrame(frame, CRSF_FRAMETYPE_RPM);
+    headspeed = frame[4] << 16 | frame[5] << 8 | frame[6];
+    EXPECT_EQ(2150, headspeed);
+    EXPECT_EQ(crfsCrc(frame, frameLen), frame[7]);
+}
+
+TEST(TelemetryCrsfTest, TestTemperature)
+{
+    uint8_t frame[CRSF_FRAME_SIZE_MAX];
+
+    telemetrySensorsUpdate();
+    int frameLen = getCrsfFrame(frame, CRSF_FRAMETYPE_TEMP);
+    EXPECT_EQ(CRSF_FRAME_TEMP_PAYLOAD_SIZE + FRAME_HEADER_FOOTER_LEN, frameLen);
+    EXPECT_EQ(CRSF_SYNC_BYTE, frame[0]); // address
+    EXPECT_EQ(7, frame[1]); // length
+    EXPECT_EQ(0x0d, frame[2]); // type
+    EXPECT_EQ(0, frame[3]); // source id
+    EXPECT_EQ(0, frame[4] << 8 | frame[5]); // ESC temperature
+    EXPECT_EQ(0, frame[6] << 8 | frame[7]); // MCU temperature
+    EXPECT_EQ(crfsCrc(frame, frameLen), frame[8]);
+
+    // disabled ESC temperature is left out
+    testDisabledSensors = ESC_SENSOR_TEMPERATURE;
+    frameLen = getCrsfFrame(frame, CRSF_FRAMETYPE_TEMP);
+    EXPECT_EQ(CRSF_FRAME_TEMP_PAYLOAD_SIZE - 2 + FRAME_HEADER_FOOTER_LEN, frameLen);
+    EXPECT_EQ(5, frame[1]); // length
+    EXPECT_EQ(0x0d, frame[2]); // type
+    EXPECT_EQ(0, frame[3]); // source id
+    EXPECT_EQ(0, frame[4] << 8 | frame[5]); // MCU temperature
+    EXPECT_EQ(crfsCrc(frame, frameLen), frame[6]);
+    testDisabledSensors = 0;
+}
+
+TEST(TelemetryCrsfTest, TestBecVoltage)
+{
+    uint8_t frame[CRSF_FRAME_SIZE_MAX];
+
+    testBecVoltage = 0;
+    telemetrySensorsUpdate();
+    int frameLen = getCrsfFrame(frame, CRSF_FRAMETYPE_VOLTAGES);
+    EXPECT_EQ(CRSF_FRAME_VOLTAGES_PAYLOAD_SIZE + FRAME_HEADER_FOOTER_LEN, frameLen);
+    EXPECT_EQ(CRSF_SYNC_BYTE, frame[0]); // address
+    EXPECT_EQ(5, frame[1]); // length
+    EXPECT_EQ(0x0e, frame[2]); // type
+    EXPECT_EQ(0, frame[3]); // source id
+    EXPECT_EQ(0, frame[4] << 8 | frame[5]);
+    EXPECT_EQ(crfsCrc(frame, frameLen), frame[6]);
+
+    testBecVoltage = 815; // 8.15V
+    telemetrySensorsUpdate();
+    frameLen = getCrsfFrame(frame, CRSF_FRAMETYPE_VOLTAGES);
+    EXPECT_EQ(8150, frame[4] << 8 | frame[5]); // mV
+    EXPECT_EQ(crfsCrc(frame, frameLen), frame[6]);
+}
+
 TEST(TelemetryCrsfTest, TestFlightMode)
 {
     uint8_t frame[CRSF_FRAME_SIZE_MAX];
@@ -225,6 +321,7 @@ TEST(TelemetryCrsfTest, TestFlightMode)
     DISABLE_ARMING_FLAG(ARMED);
 
     // nothing set, so ACRO mode
+    telemetrySensorsUpdate();
     int frameLen = getCrsfFrame(frame, CRSF_FRAMETYPE_FLIGHT_MODE);
     EXPECT_EQ(6 + FRAME_HEADER_FOOTER_LEN, frameLen);
     EXPECT_EQ(CRSF_SYNC_BYTE, frame[0]); // address
@@ -240,6 +337,8 @@ TEST(TelemetryCrsfTest, TestFlightMode)
 
     ENABLE_ARMING_FLAG(ARMED);
 
+    telemetrySensorsUpdate();
+
     frameLen = getCrsfFrame(frame, CRSF_FRAMETYPE_FLIGHT_MODE);
     EXPECT_EQ(5 + FRAME_HEADER_FOOTER_LEN, frameLen);
     EXPECT_EQ(CRSF_SYNC_BYTE, frame[0]); // address
@@ -254,6 +353,7 @@ TEST(TelemetryCrsfTest, TestFlightMode)
 
     enableFlightMode(ANGLE_MODE);
     EXPECT_EQ(ANGLE_MODE, FLIGHT_MODE(ANGLE_MODE));
+    telemetrySensorsUpdate();
     frameLen = getCrsfFrame(frame, CRSF_FRAMETYPE_FLIGHT_MODE);
     EXPECT_EQ(5 + FRAME_HEADER_FOOTER_LEN, frameLen);
     EXPECT_EQ(CRSF_SYNC_BYTE, frame[0]); // address
@@ -269,6 +369,7 @@ TEST(TelemetryCrsfTest, TestFlightMode)
     disableFlightMode(ANGLE_MODE);
     enableFlightMode(HORIZON_MODE);
     EXPECT_EQ(HORIZON_MODE, FLIGHT_MODE(HORIZON_MODE));
+    telemetrySensorsUpdate();
     frameLen = getCrsfFrame(frame, CRSF_FRAMETYPE_FLIGHT_MODE);
     EXPECT_EQ(4 + FRAME_HEADER_FOOTER_LEN, frameLen);
     EXPECT_EQ(CRSF_SYNC_BYTE, frame[0]); // address
@@ -282,6 +383,7 @@ TEST(TelemetryCrsfTest, TestFlightMode)
 
     disableFlightMode(HORIZON_MODE);
     airMode = true;
+    telemetrySensorsUpdate();
     frameLen = getCrsfFrame(frame, CRSF_FRAMETYPE_FLIGHT_MODE);
     EXPECT_EQ(4 + FRAME_HEADER_FOOTER_LEN, frameLen);
     EXPECT_EQ(CRSF_SYNC_BYTE, frame[0]); // address
@@ -294,10 +396,111 @@ TEST(TelemetryCrsfTest, TestFlightMode)
     EXPECT_EQ(crfsCrc(frame, frameLen), frame[7]);
 }
 
+static void initScheduleTest(uint8_t ratio)
+{
+    memset(frameTypeCount, 0, sizeof(frameTypeCount));
+    memset(frameTypeBytes, 0, sizeof(frameTypeBytes));
+
+    telemetryConfigMutable()->crsf_telemetry_ratio = ratio;
+    crsfRxInit(rxConfig(), &testRxRuntimeState);
+    initCrsfTelemetry();
+}
+
+// Run the telemetry task every periodUs, with an ad-hoc reply pending or not
+static void runScheduleTest(timeUs_t durationUs, timeUs_t periodUs, bool adHoc)
+{
+    for (timeUs_t t = 0; t < durationUs; t += periodUs) {
+        if (adHoc) {
+            crsfScheduleDeviceInfoResponse();
+        }
+        handleCrsfTelemetry(t);
+    }
+}
+
+static int periodicFrameCount(void)
+{
+    return frameTypeCount[CRSF_FRAMETYPE_ATTITUDE] + frameTypeCount[CRSF_FRAMETYPE_BATTERY_SENSOR] +
+        frameTypeCount[CRSF_FRAMETYPE_RPM] + frameTypeCount[CRSF_FRAMETYPE_TEMP] +
+        frameTypeCount[CRSF_FRAMETYPE_VOLTAGES] + frameTypeCount[CRSF_FRAMETYPE_FLIGHT_MODE] +
+        frameTypeCount[CRSF_FRAMETYPE_GPS];
+}
+
+static float scheduleRate(void)
+{
+    float rate = 0;
+    for (int i = 0; i < crsfScheduleCount; i++) {
+        rate += 1e6f / crsfScheduleInterval[i];
+    }
+    return rate;
+}
+
+TEST(TelemetryCrsfTest, TestScheduleBudgetScaling)
+{
+    initScheduleTest(0);
+    ASSERT_GT(crsfScheduleCount, 0);
+
+    // All frames are slowed down by the same factor to fit the budget
+    crsfScheduleBudget(20);
+    EXPECT_NEAR(20, scheduleRate(), 0.5);
+
+    // A larger budget leaves the target rates alone
+    crsfScheduleBudget(200);
+    const float targetRate = scheduleRate();
+    EXPECT_GT(targetRate, 40);
+    EXPECT_LT(targetRate, 200);
+
+    // Unpaced, the aggregate rate of the former fixed round is kept
+    crsfScheduleBudget(0);
+    EXPECT_NEAR(40, scheduleRate(), 0.5);
+}
+
+TEST(TelemetryCrsfTest, TestScheduleUnpacedRate)
+{
+    initScheduleTest(0);
+
+    runScheduleTest(10000000, 1000, false);
+
+    EXPECT_LE(periodicFrameCount(), 40 * 10 + crsfScheduleCount);
+    EXPECT_GE(periodicFrameCount(), 40 * 10 - crsfScheduleCount);
+
+    // The lowest rate frames are still sent
+    EXPECT_GT(frameTypeCount[CRSF_FRAMETYPE_GPS], 0);
+    EXPECT_GT(frameTypeCount[CRSF_FRAMETYPE_TEMP], 0);
+}
+
+TEST(TelemetryCrsfTest, TestScheduleSharedWithAdHoc)
+{
+    initScheduleTest(0);
+
+    // The task runs slower than the periodic frames are due, with an ad-hoc
+    // reply always pending, so both queues compete at every run
+    runScheduleTest(10000000, 50000, true);
+
+    // Deficit round-robin shares the bytes evenly
+    const int adHocBytes = frameTypeBytes[CRSF_FRAMETYPE_DEVICE_INFO];
+    int periodicBytes = 0;
+    for (int type = 0; type < 256; type++) {
+        if (type != CRSF_FRAMETYPE_DEVICE_INFO) {
+            periodicBytes += frameTypeBytes[type];
+        }
+    }
+    EXPECT_GT(adHocBytes, 0);
+    EXPECT_NEAR(1.0, (float)periodicBytes / adHocBytes, 0.2);
+
+    // Waiting frames keep their deadline, so all frames are slowed down alike
+    // and the low priority ones are not starved
+    const float batteryCount = frameTypeCount[CRSF_FRAMETYPE_BATTERY_SENSOR];
+    ASSERT_GT(batteryCount, 0);
+    EXPECT_NEAR(2.0 / 20, frameTypeCount[CRSF_FRAMETYPE_GPS] / batteryCount, 0.04);
+    EXPECT_NEAR(2.0 / 20, frameTypeCount[CRSF_FRAMETYPE_TEMP] / batteryCount, 0.04);
+    EXPECT_NEAR(5.0 / 20, frameTypeCount[CRSF_FRAMETYPE_FLIGHT_MODE] / batteryCount, 0.08);
+}
+
 // STUBS
 
 extern "C" {
 
+uint8_t debugMode;
 int16_t debug[DEBUG16_VALUE_COUNT];
 
 const uint32_t baudRates[] = {0, 9600, 19200, 38400, 57600, 115200, 230400, 250000, 400000}; // see baudRate_e
@@ -321,17 +524,21 @@ uint32_t serialRxBytesWaiting(const serialPort_t *) {return 0;}
 uint32_t serialTxBytesFree(const serialPort_t *) {return 0;}
 uint8_t serialRead(serialPort_t *) {return 0;}
 void serialWrite(serialPort_t *, uint8_t) {}
-void serialWriteBuf(serialPort_t *, const uint8_t *, int) {}
+void serialWriteBuf(serialPort_t *, const uint8_t *data, int count)
+{
+    frameTypeCount[data[2]]++;
+    frameTypeBytes[data[2]] += count;
+}
 void serialSetMode(serialPort_t *, portMode_e) {}
-serialPort_t *openSerialPort(serialPortIdentifier_e, serialPortFunction_e, serialReceiveCallbackPtr, void *, uint32_t, portMode_e, portOptions_e) {return NULL;}
+serialPort_t *openSerialPort(serialPortIdentifier_e, serialPortFunction_e, serialReceiveCallbackPtr, void *, uint32_t, portMode_e, portOptions_e) {return &testSerialPort;}
 void closeSerialPort(serialPort_t *) {}
 bool isSerialTransmitBufferEmpty(const serialPort_t *) { return true; }
 
-const serialPortConfig_t *findSerialPortConfig(serialPortFunction_e) {return NULL;}
+const serialPortConfig_t *findSerialPortConfig(serialPortFunction_e) {return &testSerialPortConfig;}
 
 bool telemetryDetermineEnabledState(portSharing_e) {return true;}
 bool telemetryCheckRxPortShared(const serialPortConfig_t *, SerialRXType) {return true;}
-bool telemetryIsSensorEnabled(sensor_e) {return true;}
+bool telemetryIsSensorEnabled(sensor_e sensor) {return sensor & ~testDisabledSensors;}
 
 portSharing_e determinePortSharing(const serialPortConfig_t *, serialPortFunction_e) {return PORTSHARING_NOT_SHARED;}
 
@@ -364,6 +571,29 @@ uint8_t calculateBatteryPercentageRemaining(void) {
 int32_t getEstimatedAltitudeCm(void) {
 	return gpsSol.llh.altCm;    // function returns cm not m.
 }
+
+float getHeadSpeed(void) {
+    return testHeadSpeed;
+}
+
+uint8_t getGovernorState(void) {
+    return 0;
+}
+
+int16_t getEstimatedVario(void) {
+    return 0;
+}
+
+uint8_t getBatteryCellCount(void) {
+    return 0;
+}
+
+void voltageMeterRead(voltageMeterId_e, voltageMeter_t *voltageMeter) {
+    voltageMeter->displayFiltered = testBecVoltage;
+}
+
+acc_t acc;
+int16_t GPS_directionToHome;
     
 int32_t getMAhDrawn(void){
   return testmAhDrawn;
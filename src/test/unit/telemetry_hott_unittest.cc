@@ -38,15 +38,19 @@ extern "C" {
 
     #include "fc/runtime_config.h"
 
+    #include "flight/imu.h"
     #include "flight/pid.h"
 
     #include "io/gps.h"
     #include "io/serial.h"
 
+    #include "sensors/acceleration.h"
     #include "sensors/barometer.h"
     #include "sensors/battery.h"
     #include "sensors/sensors.h"
+    #include "sensors/voltage.h"
 
+    #include "telemetry/sensors.h"
     #include "telemetry/telemetry.h"
     #include "telemetry/hott.h"
 
@@ -298,4 +302,31 @@ int32_t getMAhDrawn(void) {
     return testMAhDrawn;
 }
 
+uint8_t calculateBatteryPercentageRemaining(void) {
+    return 0;
+}
+
+uint8_t getBatteryCellCount(void) {
+    return 0;
+}
+
+uint16_t getBatteryAverageCellVoltage(void) {
+    return 0;
+}
+
+void voltageMeterRead(voltageMeterId_e, voltageMeter_t *voltageMeter) {
+    voltageMeter->displayFiltered = 0;
+}
+
+float getHeadSpeed(void) {
+    return 0;
+}
+
+uint8_t getGovernorState(void) {
+    return 0;
+}
+
+attitudeEulerAngles_t attitude;
+acc_t acc;
+
 }
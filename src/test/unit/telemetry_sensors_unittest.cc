@@ -0,0 +1,158 @@
+/*
+ * This file is part of Rotorflight.
+ *
+ * Rotorflight is free software. You can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Rotorflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/utils.h"
+
+    #include "flight/governor.h"
+    #include "flight/imu.h"
+    #include "flight/position.h"
+
+    #include "io/gps.h"
+
+    #include "sensors/acceleration.h"
+    #include "sensors/battery.h"
+    #include "sensors/voltage.h"
+
+    #include "telemetry/sensors.h"
+
+    static uint16_t testBatteryVoltage;
+    static int32_t testAmperage;
+    static float testHeadSpeed;
+
+    static int batteryVoltageSamples;
+    static int headSpeedSamples;
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+static void resetSamples(void)
+{
+    batteryVoltageSamples = 0;
+    headSpeedSamples = 0;
+}
+
+TEST(TelemetrySensorsUnittest, TestCachedWithinTick)
+{
+    resetSamples();
+    testBatteryVoltage = 1234;
+
+    telemetrySensorsUpdate();
+    EXPECT_EQ(1234, telemetrySensorValue(TELEM_BATTERY_VOLTAGE));
+    EXPECT_EQ(1, batteryVoltageSamples);
+
+    // The first value of the tick is kept
+    testBatteryVoltage = 2000;
+    EXPECT_EQ(1234, telemetrySensorValue(TELEM_BATTERY_VOLTAGE));
+    EXPECT_EQ(1234, telemetrySensorValueScaled(TELEM_BATTERY_VOLTAGE, -2));
+    EXPECT_EQ(1, batteryVoltageSamples);
+
+    // Sensors that are not read are not sampled
+    EXPECT_EQ(0, headSpeedSamples);
+}
+
+TEST(TelemetrySensorsUnittest, TestUpdateInvalidates)
+{
+    resetSamples();
+    testBatteryVoltage = 1234;
+    testHeadSpeed = 1500.4f;
+
+    telemetrySensorsUpdate();
+    EXPECT_EQ(1234, telemetrySensorValue(TELEM_BATTERY_VOLTAGE));
+    EXPECT_EQ(1500, telemetrySensorValue(TELEM_HEADSPEED));
+
+    testBatteryVoltage = 2000;
+    testHeadSpeed = 1800.6f;
+
+    telemetrySensorsUpdate();
+    EXPECT_EQ(2000, telemetrySensorValue(TELEM_BATTERY_VOLTAGE));
+    EXPECT_EQ(1801, telemetrySensorValue(TELEM_HEADSPEED));
+    EXPECT_EQ(2, batteryVoltageSamples);
+    EXPECT_EQ(2, headSpeedSamples);
+}
+
+TEST(TelemetrySensorsUnittest, TestValueScaled)
+{
+    testBatteryVoltage = 1678;  // 16.78V
+    testAmperage = -1678;       // -16.78A
+
+    telemetrySensorsUpdate();
+
+    // Scaling up is exact
+    EXPECT_EQ(16780, telemetrySensorValueScaled(TELEM_BATTERY_VOLTAGE, -3));
+    EXPECT_EQ(-16780, telemetrySensorValueScaled(TELEM_BATTERY_CURRENT, -3));
+
+    // Scaling down truncates towards zero
+    EXPECT_EQ(167, telemetrySensorValueScaled(TELEM_BATTERY_VOLTAGE, -1));
+    EXPECT_EQ(16, telemetrySensorValueScaled(TELEM_BATTERY_VOLTAGE, 0));
+    EXPECT_EQ(-167, telemetrySensorValueScaled(TELEM_BATTERY_CURRENT, -1));
+    EXPECT_EQ(-16, telemetrySensorValueScaled(TELEM_BATTERY_CURRENT, 0));
+
+    // Same scale is unchanged
+    EXPECT_EQ(1678, telemetrySensorValueScaled(TELEM_BATTERY_VOLTAGE, -2));
+}
+
+// STUBS
+
+extern "C" {
+
+attitudeEulerAngles_t attitude;
+acc_t acc;
+
+gpsSolutionData_t gpsSol;
+uint16_t GPS_distanceToHome;
+int16_t GPS_directionToHome;
+
+uint16_t getBatteryVoltage(void)
+{
+    batteryVoltageSamples++;
+    return testBatteryVoltage;
+}
+
+int32_t getAmperage(void)
+{
+    return testAmperage;
+}
+
+int32_t getMAhDrawn(void) { return 0; }
+uint8_t calculateBatteryPercentageRemaining(void) { return 0; }
+uint8_t getBatteryCellCount(void) { return 0; }
+uint16_t getBatteryAverageCellVoltage(void) { return 0; }
+
+int32_t getEstimatedAltitudeCm(void) { return 0; }
+int16_t getEstimatedVario(void) { return 0; }
+
+float getHeadSpeed(void)
+{
+    headSpeedSamples++;
+    return testHeadSpeed;
+}
+
+uint8_t getGovernorState(void) { return 0; }
+
+void voltageMeterRead(voltageMeterId_e, voltageMeter_t *voltageMeter)
+{
+    voltageMeter->displayFiltered = 0;
+}
+
+}